@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_reduction.dir/bench_reduction.hip.o"
+  "CMakeFiles/bench_reduction.dir/bench_reduction.hip.o.d"
+  "bench_reduction"
+  "bench_reduction.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_reduction.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/hip_kernels/cpu_functions.cpp" "CMakeFiles/gpu_funcs.dir/cpu_functions.cpp.o" "gcc" "CMakeFiles/gpu_funcs.dir/cpu_functions.cpp.o.d"
+  "/root/repo/hip_kernels/src/cpu_runtime.cpp" "CMakeFiles/gpu_funcs.dir/src/cpu_runtime.cpp.o" "gcc" "CMakeFiles/gpu_funcs.dir/src/cpu_runtime.cpp.o.d"
+  "/root/repo/hip_kernels/src/debugger.hip" "CMakeFiles/gpu_funcs.dir/src/debugger.hip.o" "gcc" "CMakeFiles/gpu_funcs.dir/src/debugger.hip.o.d"
+  "/root/repo/hip_kernels/src/exec_context.hip" "CMakeFiles/gpu_funcs.dir/src/exec_context.hip.o" "gcc" "CMakeFiles/gpu_funcs.dir/src/exec_context.hip.o.d"
+  "/root/repo/hip_kernels/src/functions.hip" "CMakeFiles/gpu_funcs.dir/src/functions.hip.o" "gcc" "CMakeFiles/gpu_funcs.dir/src/functions.hip.o.d"
+  "/root/repo/hip_kernels/src/gpu_memory.hip" "CMakeFiles/gpu_funcs.dir/src/gpu_memory.hip.o" "gcc" "CMakeFiles/gpu_funcs.dir/src/gpu_memory.hip.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/gpu_funcs.dir/cpu_functions.cpp.o"
+  "CMakeFiles/gpu_funcs.dir/cpu_functions.cpp.o.d"
+  "CMakeFiles/gpu_funcs.dir/src/cpu_runtime.cpp.o"
+  "CMakeFiles/gpu_funcs.dir/src/cpu_runtime.cpp.o.d"
+  "CMakeFiles/gpu_funcs.dir/src/debugger.hip.o"
+  "CMakeFiles/gpu_funcs.dir/src/debugger.hip.o.d"
+  "CMakeFiles/gpu_funcs.dir/src/exec_context.hip.o"
+  "CMakeFiles/gpu_funcs.dir/src/exec_context.hip.o.d"
+  "CMakeFiles/gpu_funcs.dir/src/functions.hip.o"
+  "CMakeFiles/gpu_funcs.dir/src/functions.hip.o.d"
+  "CMakeFiles/gpu_funcs.dir/src/gpu_memory.hip.o"
+  "CMakeFiles/gpu_funcs.dir/src/gpu_memory.hip.o.d"
+  "libgpu_funcs.a"
+  "libgpu_funcs.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gpu_funcs.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
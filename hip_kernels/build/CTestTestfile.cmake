@@ -0,0 +1,12 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/hip_kernels
+# Build directory: /root/repo/hip_kernels/build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[test_device_pool]=] "/root/repo/hip_kernels/build/test_device_pool")
+set_tests_properties([=[test_device_pool]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/hip_kernels/CMakeLists.txt;56;add_test;/root/repo/hip_kernels/CMakeLists.txt;0;")
+add_test([=[test_gpu]=] "/root/repo/hip_kernels/build/test_gpu")
+set_tests_properties([=[test_gpu]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/hip_kernels/CMakeLists.txt;57;add_test;/root/repo/hip_kernels/CMakeLists.txt;0;")
+add_test([=[test_gpu_host_fallback]=] "/root/repo/hip_kernels/build/test_gpu")
+set_tests_properties([=[test_gpu_host_fallback]=] PROPERTIES  ENVIRONMENT "GPU_FUNCS_FORCE_CPU=1" _BACKTRACE_TRIPLES "/root/repo/hip_kernels/CMakeLists.txt;59;add_test;/root/repo/hip_kernels/CMakeLists.txt;0;")
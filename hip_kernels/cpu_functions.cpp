@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include <cstdint>
+#include <algorithm>
+#include "functions.hpp"
+#include "kernel_ops.hpp"
+#include "gpu_functions.h"
+
+// CPU/OpenMP backend of the kernel wrappers of gpu_functions.h, built instead of gpu_functions.hip
+// with GPU_FUNCS_CPU. A HIP build compiles it into namespace gpu_host too, and its wrappers forward
+// there when gpuOnHost(). Each wrapper runs to completion before returning, so the stream arguments
+// only matter for their ordering, which is then trivially respected. The arithmetic is the one of
+// kernel_ops.hpp, so the results are the words the HIP kernels produce.
+
+using std::uint64_t;
+
+#ifndef GPU_FUNCS_CPU
+namespace gpu_host {
+#endif
+
+void gpuAdd(uint64_t *GPUArrayA, uint64_t *GPUArrayB, uint64_t *GPUArrayC,
+    int N, int L, uint64_t* moduli, hipStream_t stream)
+    {
+    #pragma omp parallel for
+    for (int l = 0; l < L; l++) {
+        uint64_t modulus = moduli[l];
+        size_t offset = (size_t)l * N;
+        #pragma omp simd
+        for (int i = 0; i < N; i++)
+            GPUArrayC[offset + i] = add_mod_elem(GPUArrayA[offset + i], GPUArrayB[offset + i], modulus);
+    }
+    }
+
+void gpuMult(uint64_t *GPUArrayA, uint64_t *GPUArrayB, uint64_t *GPUArrayC,
+    int N, int L, uint64_t* moduli, hipStream_t stream)
+    {
+    #pragma omp parallel for
+    for (int l = 0; l < L; l++) {
+        Modulus_params modulus = make_modulus(moduli[l]);
+        size_t offset = (size_t)l * N;
+        #pragma omp simd
+        for (int i = 0; i < N; i++)
+            GPUArrayC[offset + i] = mult_mod_elem(GPUArrayA[offset + i], GPUArrayB[offset + i], modulus);
+    }
+    }
+
+void gpuMult(uint64_t *GPUArrayA, uint64_t *GPUArrayB, uint64_t *GPUArrayC,
+    int N, int L, const Modulus_params* moduli, hipStream_t stream)
+    {
+    #pragma omp parallel for
+    for (int l = 0; l < L; l++) {
+        Modulus_params modulus = moduli[l];
+        size_t offset = (size_t)l * N;
+        #pragma omp simd
+        for (int i = 0; i < N; i++)
+            GPUArrayC[offset + i] = mult_mod_elem(GPUArrayA[offset + i], GPUArrayB[offset + i], modulus);
+    }
+    }
+
+void gpuEmptyKernel(hipStream_t stream) {
+}
+
+const char* gpuBackend() {
+    return "cpu";
+}
+
+// (i)NTT ///////////////////////////////////////////////////////////////////////////////////////////////////
+// The butterflies of the 2D kernels in the plain iterative order: stage by stage, the group i of a
+// stage with m groups uses psi[m + i] (CT) or inv_psi[h + i] (GS). Each butterfly sees the same
+// operands as on the GPU, so the outputs are identical.
+
+static void ntt_limb(uint64_t* a, const uint64_t* psi, uint64_t q, uint64_t mu, int qbit, int N) {
+    for (int m = 1, t = N >> 1; m < N; m <<= 1, t >>= 1) {
+        for (int i = 0; i < m; i++) {
+            uint64_t twiddle = psi[m + i];
+            uint64_t* x = a + (size_t)2 * i * t;
+            #pragma omp simd
+            for (int j = 0; j < t; j++)
+                barrett_CT_butterfly(x[j], x[j + t], twiddle, q, mu, qbit);
+        }
+    }
+}
+
+static void intt_limb(uint64_t* a, const uint64_t* inv_psi, uint64_t q, uint64_t mu, int qbit, int N) {
+    uint64_t q2 = (q + 1) >> 1; // for modular halving
+    for (int h = N >> 1, t = 1; h >= 1; h >>= 1, t <<= 1) {
+        for (int i = 0; i < h; i++) {
+            uint64_t twiddle = inv_psi[h + i];
+            uint64_t* x = a + (size_t)2 * i * t;
+            #pragma omp simd
+            for (int j = 0; j < t; j++)
+                barrett_GS_butterfly(x[j], x[j + t], twiddle, q, q2, mu, qbit);
+        }
+    }
+}
+
+static void ntt_batch(bool inverse, uint64_t* const* polys, int numPolys, const NTT_params& params) {
+    if (params.logN < 10 || params.logN > 17 || params.N != (1 << params.logN)) {
+        fprintf(stderr, "gpuNTT: unsupported ring dimension %d\n", params.N);
+        return;
+    }
+    // every limb of every polynomial is independent, as the blockIdx.y of the kernels
+    #pragma omp parallel for collapse(2)
+    for (int p = 0; p < numPolys; p++) {
+        for (int l = 0; l < params.L; l++) {
+            uint64_t* a = polys[p] + (size_t)l * params.N;
+            size_t table = (size_t)l * params.N;
+            if (inverse)
+                intt_limb(a, params.inv_psi_arrays + table, params.moduli[l], params.mus[l], params.qbits[l], params.N);
+            else
+                ntt_limb(a, params.psi_arrays + table, params.moduli[l], params.mus[l], params.qbits[l], params.N);
+        }
+    }
+}
+
+void gpuNTT(uint64_t* const* polys, int numPolys, const NTT_params& params, hipStream_t stream) {
+    ntt_batch(false, polys, numPolys, params);
+}
+
+void gpuINTT(uint64_t* const* polys, int numPolys, const NTT_params& params, hipStream_t stream) {
+    ntt_batch(true, polys, numPolys, params);
+}
+
+void gpuTensorProduct(const uint64_t* const* in, uint64_t* const* out, int numPairs, int N, int L,
+    const uint64_t* moduli, const uint64_t* mus, const int* qbits, hipStream_t stream) {
+    #pragma omp parallel for collapse(2)
+    for (int p = 0; p < numPairs; p++) {
+        for (int l = 0; l < L; l++) {
+            const uint64_t* const* x = in + 4 * p;
+            uint64_t* const* d = out + 3 * p;
+            size_t offset = (size_t)l * N;
+            for (int ri = 0; ri < N; ri++)
+                tensor_product_coeff(x[0], x[1], x[2], x[3], d[0], d[1], d[2], offset + ri, moduli[l], mus[l], qbits[l]);
+        }
+    }
+}
+
+// Hybrid key switching ///////////////////////////////////////////////////////////////////////////////////
+
+void gpuSwitchBasis(const uint64_t* in, uint64_t* out, int N, const SwitchBasis_params& params,
+    hipStream_t stream) {
+    #pragma omp parallel for collapse(2)
+    for (int j = 0; j < params.sizeOut; j++)
+        for (int ri = 0; ri < N; ri++)
+            out[(size_t)j * N + ri] = switch_basis_coeff(in, N, ri, j, params);
+}
+
+void gpuKeySwitchInnerProduct(const uint64_t* digits, int numDigits, const uint64_t* keyA,
+    const uint64_t* keyB, uint64_t* out0, uint64_t* out1, int N, int sizeQl, int sizeQlP, int sizeQ,
+    int sizeQP, const uint64_t* moduli, const uint64_t* mus, hipStream_t stream) {
+    #pragma omp parallel for collapse(2)
+    for (int i = 0; i < sizeQlP; i++)
+        for (int ri = 0; ri < N; ri++)
+            key_switch_inner_product_coeff(digits, numDigits, keyA, keyB, out0, out1, N, ri, i, sizeQl, sizeQlP,
+                sizeQ, sizeQP, moduli, mus);
+}
+
+void gpuModDownAdd(uint64_t* acc, const uint64_t* c, const uint64_t* s, int N, int L,
+    const uint64_t* moduli, const uint64_t* PInvModq, const uint64_t* PInvModqPrecon, hipStream_t stream) {
+    #pragma omp parallel for
+    for (int i = 0; i < L; i++) {
+        size_t offset = (size_t)i * N;
+        for (int ri = 0; ri < N; ri++)
+            acc[offset + ri] = mod_down_add_elem(acc[offset + ri], c[offset + ri], s[offset + ri], moduli[i],
+                PInvModq[i], PInvModqPrecon[i]);
+    }
+}
+
+void gpuMultScalar(uint64_t* a, int N, int L, const uint64_t* moduli, const uint64_t* scalars,
+    const uint64_t* precons, hipStream_t stream) {
+    #pragma omp parallel for
+    for (int i = 0; i < L; i++) {
+        size_t offset = (size_t)i * N;
+        for (int ri = 0; ri < N; ri++)
+            a[offset + ri] = mulmod_shoup(a[offset + ri], scalars[i], precons[i], moduli[i]);
+    }
+}
+
+#ifndef GPU_FUNCS_CPU
+}
+#endif
@@ -1,22 +1,126 @@
+#ifndef __GPU_FUNCTIONS__
+#define __GPU_FUNCTIONS__
+
 #include <stdio.h>
-#include "hip/hip_runtime.h"
+#include "include/gpu_runtime.hpp"
 #include "include/functions.hpp"
+#include "include/kernel_ops.hpp"
+#include "include/device_pool.hpp"
+#include "include/exec_context.hpp"
 
 uint64_t* moveArrayToGPU(uint64_t* array, int n);
 uint64_t* moveArrayToHost(uint64_t* GPUArray, int n);
 
+// asynchronous copies, src/dst on the host side should be pinned for real overlap
+void copyToGPUAsync(uint64_t* GPUArray, const uint64_t* array, size_t n, hipStream_t stream);
+void copyToHostAsync(uint64_t* array, const uint64_t* GPUArray, size_t n, hipStream_t stream);
+void copyOnGPUAsync(uint64_t* dst, const uint64_t* src, size_t n, hipStream_t stream);
+
+// process-wide pool backing the RawCipherText transfers
+DevicePool<DeviceBackend>& gpuMemoryPool();
+
+// all kernel wrappers only enqueue work on the given stream (default: null stream)
 void gpuAdd(uint64_t *GPUArrayA, uint64_t *GPUArrayB, uint64_t *GPUArrayC,
-    int N, int L, uint64_t* moduli);
+    int N, int L, uint64_t* moduli, hipStream_t stream = 0);
 
+// the Barrett constants of each limb are derived from moduli once per call
 void gpuMult(uint64_t *CPUArrayA, uint64_t *CPUArrayB, uint64_t *CPUArrayC,
-   int N, int L, uint64_t* moduli);
+   int N, int L, uint64_t* moduli, hipStream_t stream = 0);
+
+// as above with the constants precomputed (make_modulus, reduction.hpp) in a device array of L
+void gpuMult(uint64_t *GPUArrayA, uint64_t *GPUArrayB, uint64_t *GPUArrayC,
+    int N, int L, const Modulus_params* moduli, hipStream_t stream = 0);
 
 void gpuNtt(uint64_t *data, const uint64_t *twiddles, size_t n, size_t p);
 
+// synchronizes the whole device, prefer GpuFuture::Wait / ExecContext::Synchronize
 void hipSync();
 
-void gpuEmptyKernel();
+// backend the library runs on: "hip", or "cpu" for the OpenMP build (GPU_FUNCS_CPU) and for a HIP
+// build that runs on the host (gpuOnHost)
+const char* gpuBackend();
+
+void gpuEmptyKernel(hipStream_t stream = 0);
+
+// max polynomials per launch of the batched NTT, larger batches are split
+#define NTT_MAX_BATCH 16
+
+/**
+* parameter structure for doing the NTT on the GPU in RNS format
+* moduli, mus, qbits and the psi tables (N entries per limb) are device arrays
+*/
+struct NTT_params {
+    int N;
+    int L;
+    int qbit;
+    int logN;
+    uint64_t* moduli;
+    uint64_t* mus;
+    int* qbits; // Barrett width of each limb, the bit length of its modulus
+    uint64_t* psi_arrays;
+    uint64_t* inv_psi_arrays;
+    uint64_t* psi_precon_arrays; // Shoup precomputations of the tables above, may be null
+    uint64_t* inv_psi_precon_arrays;
+};
+
+// (i)NTT of every limb of numPolys polynomials of L limbs each, 2^10 <= N <= 2^17
+void gpuNTT(uint64_t* const* polys, int numPolys, const NTT_params& params, hipStream_t stream = 0);
 
-void gpuNTT(uint64_t *rns_arrays, uint64_t *psi_arrays, uint64_t logN, int N, int L, uint64_t* moduli, uint64_t* mus, int qbit);
+void gpuINTT(uint64_t* const* polys, int numPolys, const NTT_params& params, hipStream_t stream = 0);
+
+// max ciphertext pairs per launch of the tensor product, larger batches are split
+#define TENSOR_MAX_BATCH 8
+
+// (d0, d1, d2) = (a0*b0, a0*b1 + a1*b0, a1*b1) for numPairs pairs of ciphertexts of L limbs in
+// evaluation format, in one pass over the inputs. in holds {a0, a1, b0, b1} and out {d0, d1, d2}
+// for each pair, outputs may alias inputs. moduli/mus/qbits are the device arrays of NTT_params.
+void gpuTensorProduct(const uint64_t* const* in, uint64_t* const* out, int numPairs, int N, int L,
+    const uint64_t* moduli, const uint64_t* mus, const int* qbits, hipStream_t stream = 0);
+
+// device tables of the basis switch are described with SwitchBasis_params (kernel_ops.hpp)
+// out (sizeOut limbs) = ApproxSwitchCRTBasis(in (sizeIn limbs)), both in coefficient format
+void gpuSwitchBasis(const uint64_t* in, uint64_t* out, int N, const SwitchBasis_params& params,
+    hipStream_t stream = 0);
+
+// out0/out1 = sum of the numDigits digits (sizeQlP limbs each) times the b/a halves of an eval key
+// (numDigits x sizeQP limbs), moduli/mus are the sizeQlP limbs of QlP in the switchBasis format
+void gpuKeySwitchInnerProduct(const uint64_t* digits, int numDigits, const uint64_t* keyA,
+    const uint64_t* keyB, uint64_t* out0, uint64_t* out1, int N, int sizeQl, int sizeQlP, int sizeQ,
+    int sizeQP, const uint64_t* moduli, const uint64_t* mus, hipStream_t stream = 0);
+
+// acc += (c - s) * PInvModq over L limbs, the end of ApproxModDown
+void gpuModDownAdd(uint64_t* acc, const uint64_t* c, const uint64_t* s, int N, int L,
+    const uint64_t* moduli, const uint64_t* PInvModq, const uint64_t* PInvModqPrecon, hipStream_t stream = 0);
+
+// limb i of a *= scalars[i]
+void gpuMultScalar(uint64_t* a, int N, int L, const uint64_t* moduli, const uint64_t* scalars,
+    const uint64_t* precons, hipStream_t stream = 0);
+
+#ifndef GPU_FUNCS_CPU
+// the wrappers of cpu_functions.cpp, which the HIP wrappers forward to when gpuOnHost()
+namespace gpu_host {
+void gpuAdd(uint64_t *GPUArrayA, uint64_t *GPUArrayB, uint64_t *GPUArrayC,
+    int N, int L, uint64_t* moduli, hipStream_t stream);
+void gpuMult(uint64_t *GPUArrayA, uint64_t *GPUArrayB, uint64_t *GPUArrayC,
+    int N, int L, uint64_t* moduli, hipStream_t stream);
+void gpuMult(uint64_t *GPUArrayA, uint64_t *GPUArrayB, uint64_t *GPUArrayC,
+    int N, int L, const Modulus_params* moduli, hipStream_t stream);
+const char* gpuBackend();
+void gpuEmptyKernel(hipStream_t stream);
+void gpuNTT(uint64_t* const* polys, int numPolys, const NTT_params& params, hipStream_t stream);
+void gpuINTT(uint64_t* const* polys, int numPolys, const NTT_params& params, hipStream_t stream);
+void gpuTensorProduct(const uint64_t* const* in, uint64_t* const* out, int numPairs, int N, int L,
+    const uint64_t* moduli, const uint64_t* mus, const int* qbits, hipStream_t stream);
+void gpuSwitchBasis(const uint64_t* in, uint64_t* out, int N, const SwitchBasis_params& params,
+    hipStream_t stream);
+void gpuKeySwitchInnerProduct(const uint64_t* digits, int numDigits, const uint64_t* keyA,
+    const uint64_t* keyB, uint64_t* out0, uint64_t* out1, int N, int sizeQl, int sizeQlP, int sizeQ,
+    int sizeQP, const uint64_t* moduli, const uint64_t* mus, hipStream_t stream);
+void gpuModDownAdd(uint64_t* acc, const uint64_t* c, const uint64_t* s, int N, int L,
+    const uint64_t* moduli, const uint64_t* PInvModq, const uint64_t* PInvModqPrecon, hipStream_t stream);
+void gpuMultScalar(uint64_t* a, int N, int L, const uint64_t* moduli, const uint64_t* scalars,
+    const uint64_t* precons, hipStream_t stream);
+}
+#endif
 
-void gpuINTT(uint64_t *rns_arrays, uint64_t *inv_psi_arrays, uint64_t logN, int N, int L, uint64_t* moduli, uint64_t* mus, int qbit);
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -14,7 +14,9 @@
 #define DEBUGGER_H
 
 #include <iostream>
-#include "hip/hip_runtime.h"
+#include <stdexcept>
+#include <string>
+#include "gpu_runtime.hpp"
 
 // Enum used to select formatting option
 enum color{
@@ -54,7 +56,8 @@ class formatted_message
 		friend std::ostream& operator<<(std::ostream& os, const formatted_message& fm);
 };
 
-// Cuda errcheck helper function
+// Cuda errcheck helper function, throws std::runtime_error on failure so that callers can
+// report it or fall back instead of the process exiting
 #define gpuErrchk(ans)                        \
 	{                                         \
 		gpuAssert((ans), __FILE__, __LINE__); \
@@ -64,10 +67,10 @@ inline void gpuAssert(hipError_t code, const char *file, int line, bool abort =
 {
 	if (code != hipSuccess)
 	{
-		fprintf(stderr, "GPUassert: %s %s %d\n", hipGetErrorString(code), file, line);
+		std::string msg = std::string("GPUassert: ") + hipGetErrorString(code) + " " + file + " " + std::to_string(line);
 		if (abort)
-			exit(code);
-
+			throw std::runtime_error(msg);
+		fprintf(stderr, "%s\n", msg.c_str());
 	}
 }
 
@@ -0,0 +1,212 @@
+#ifndef __DEVICE_POOL__
+#define __DEVICE_POOL__
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using std::uint64_t;
+
+/**
+* Pooled allocator for limb arrays.
+*
+* Device blocks and pinned staging buffers are kept in size-class free lists keyed by the
+* number of 64-bit words (N*L for a sub-ciphertext, L for the moduli), so moving ciphertexts
+* of the same shape back and forth never goes through the driver allocator after warm-up.
+*
+* The Backend policy supplies the raw memory operations:
+*   uint64_t* AllocateDevice(size_t n);    void FreeDevice(uint64_t* p);
+*   uint64_t* AllocatePinned(size_t n);    void FreePinned(uint64_t* p);
+*   void CopyToDevice(uint64_t* dst, const uint64_t* src, size_t n);   // may be asynchronous
+*   void CopyToHost(uint64_t* dst, const uint64_t* src, size_t n);     // may be asynchronous
+*   void Synchronize();
+*
+* Released blocks are handed out again without synchronization. This is safe as long as all
+* work touching a block is ordered on the same stream as the work that reuses it (the blocks
+* are stream-ordered, like hipMallocAsync memory on the default stream).
+*/
+template <typename Backend>
+class DevicePool
+{
+    public:
+        struct Stats {
+            size_t deviceAllocs = 0;   // blocks obtained from Backend::AllocateDevice
+            size_t deviceReuses = 0;   // blocks served from the free lists
+            size_t pinnedAllocs = 0;
+            size_t pinnedReuses = 0;
+            size_t bytesCached = 0;    // bytes currently parked in the free lists
+        };
+
+        DevicePool() = default;
+        DevicePool(const DevicePool&) = delete;
+        DevicePool& operator=(const DevicePool&) = delete;
+        ~DevicePool() { Trim(); }
+
+        // device blocks
+        uint64_t* Acquire(size_t n) {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                auto it = freeDevice.find(n);
+                if (it != freeDevice.end() && !it->second.empty()) {
+                    uint64_t* p = it->second.back();
+                    it->second.pop_back();
+                    stats.deviceReuses++;
+                    stats.bytesCached -= n * sizeof(uint64_t);
+                    return p;
+                }
+                stats.deviceAllocs++;
+            }
+            return Backend::AllocateDevice(n);
+        }
+
+        void Release(uint64_t* p, size_t n) {
+            if (p == nullptr)
+                return;
+            std::lock_guard<std::mutex> lock(mtx);
+            freeDevice[n].push_back(p);
+            stats.bytesCached += n * sizeof(uint64_t);
+        }
+
+        // pinned host staging buffers
+        uint64_t* AcquireStaging(size_t n) {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                auto it = freePinned.find(n);
+                if (it != freePinned.end() && !it->second.empty()) {
+                    uint64_t* p = it->second.back();
+                    it->second.pop_back();
+                    stats.pinnedReuses++;
+                    stats.bytesCached -= n * sizeof(uint64_t);
+                    return p;
+                }
+                stats.pinnedAllocs++;
+            }
+            return Backend::AllocatePinned(n);
+        }
+
+        void ReleaseStaging(uint64_t* p, size_t n) {
+            if (p == nullptr)
+                return;
+            std::lock_guard<std::mutex> lock(mtx);
+            freePinned[n].push_back(p);
+            stats.bytesCached += n * sizeof(uint64_t);
+        }
+
+        /**
+        * Uploads n words from pageable host memory into a pooled device block.
+        * The copy goes through a pinned staging buffer and is only enqueued; call Synchronize()
+        * before the staging buffers may be recycled by ReleasePending().
+        */
+        uint64_t* Upload(const uint64_t* host, size_t n) {
+            uint64_t* staging = AcquireStaging(n);
+            std::memcpy(staging, host, n * sizeof(uint64_t));
+            uint64_t* dev = Acquire(n);
+            Backend::CopyToDevice(dev, staging, n);
+            std::lock_guard<std::mutex> lock(mtx);
+            pending.push_back({staging, n});
+            return dev;
+        }
+
+        /**
+        * Downloads n words from a device block into host memory. Synchronizes, since the data
+        * has to leave the staging buffer before this returns.
+        */
+        void Download(uint64_t* host, const uint64_t* dev, size_t n) {
+            uint64_t* staging = AcquireStaging(n);
+            Backend::CopyToHost(staging, dev, n);
+            Backend::Synchronize();
+            std::memcpy(host, staging, n * sizeof(uint64_t));
+            ReleaseStaging(staging, n);
+        }
+
+        /**
+        * Waits for all enqueued copies and returns the staging buffers used by Upload to the pool.
+        */
+        void Synchronize() {
+            Backend::Synchronize();
+            std::vector<std::pair<uint64_t*, size_t>> done;
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                done.swap(pending);
+            }
+            for (auto& s : done)
+                ReleaseStaging(s.first, s.second);
+        }
+
+        /**
+        * Returns every cached block to the backend.
+        */
+        void Trim() {
+            Synchronize();
+            std::lock_guard<std::mutex> lock(mtx);
+            for (auto& kv : freeDevice)
+                for (auto p : kv.second)
+                    Backend::FreeDevice(p);
+            for (auto& kv : freePinned)
+                for (auto p : kv.second)
+                    Backend::FreePinned(p);
+            freeDevice.clear();
+            freePinned.clear();
+            stats.bytesCached = 0;
+        }
+
+        Stats GetStats() {
+            std::lock_guard<std::mutex> lock(mtx);
+            return stats;
+        }
+
+    private:
+        std::mutex mtx;
+        std::unordered_map<size_t, std::vector<uint64_t*>> freeDevice;
+        std::unordered_map<size_t, std::vector<uint64_t*>> freePinned;
+        std::vector<std::pair<uint64_t*, size_t>> pending;
+        Stats stats;
+};
+
+/**
+* CPU stand-in for the device: "device" and pinned memory are ordinary aligned host
+* allocations and copies are synchronous. Used to unit test the pool on machines without a GPU.
+*/
+struct HostBackend
+{
+    static uint64_t* AllocateDevice(size_t n) {
+        return static_cast<uint64_t*>(std::aligned_alloc(64, ((n * sizeof(uint64_t) + 63) / 64) * 64));
+    }
+    static void FreeDevice(uint64_t* p) { std::free(p); }
+    static uint64_t* AllocatePinned(size_t n) { return AllocateDevice(n); }
+    static void FreePinned(uint64_t* p) { std::free(p); }
+    static void CopyToDevice(uint64_t* dst, const uint64_t* src, size_t n) {
+        std::memcpy(dst, src, n * sizeof(uint64_t));
+    }
+    static void CopyToHost(uint64_t* dst, const uint64_t* src, size_t n) {
+        std::memcpy(dst, src, n * sizeof(uint64_t));
+    }
+    static void Synchronize() {}
+};
+
+/**
+* HIP backend, implemented in gpu_functions.hip. Copies are enqueued on the default stream.
+*/
+struct HipBackend
+{
+    static uint64_t* AllocateDevice(size_t n);
+    static void FreeDevice(uint64_t* p);
+    static uint64_t* AllocatePinned(size_t n);
+    static void FreePinned(uint64_t* p);
+    static void CopyToDevice(uint64_t* dst, const uint64_t* src, size_t n);
+    static void CopyToHost(uint64_t* dst, const uint64_t* src, size_t n);
+    static void Synchronize();
+};
+
+// backend of gpuMemoryPool(): the GPU, or host memory in the CPU build of the library. HipBackend goes
+// through gpurt, so a HIP build that runs on the host (gpuOnHost) gets host memory as well
+#ifdef GPU_FUNCS_CPU
+typedef HostBackend DeviceBackend;
+#else
+typedef HipBackend DeviceBackend;
+#endif
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef __EXEC_CONTEXT__
+#define __EXEC_CONTEXT__
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "gpu_runtime.hpp"
+
+/**
+* Future-like handle on work enqueued on a stream. A default constructed future is already
+* complete. Copies share the underlying event.
+*/
+class GpuFuture
+{
+    public:
+        GpuFuture() = default;
+        explicit GpuFuture(hipEvent_t ev);
+
+        // true once all work recorded before the event has finished
+        bool Ready() const;
+        // blocks the calling host thread until Ready()
+        void Wait() const;
+        // nullptr for a complete future
+        hipEvent_t Event() const { return event ? *event : nullptr; }
+
+    private:
+        std::shared_ptr<hipEvent_t> event;
+};
+
+/**
+* A set of streams and events used to overlap independent operations.
+*
+* Compute work is spread round-robin over the compute streams, host-to-device and
+* device-to-host copies get a stream each so they can run alongside compute. Ordering between
+* streams is explicit: an operation waits on the GpuFutures of its inputs (DependsOn) and
+* publishes a new GpuFuture for its outputs (Record). Nothing here synchronizes the whole device.
+*/
+class ExecContext
+{
+    public:
+        explicit ExecContext(int numComputeStreams = 4);
+        ~ExecContext();
+        ExecContext(const ExecContext&) = delete;
+        ExecContext& operator=(const ExecContext&) = delete;
+
+        // next compute stream in round-robin order
+        hipStream_t AcquireStream();
+        hipStream_t UploadStream() const { return upload; }
+        hipStream_t DownloadStream() const { return download; }
+        int NumComputeStreams() const { return (int)compute.size(); }
+
+        // makes subsequent work on stream wait for f, without blocking the host
+        void DependsOn(hipStream_t stream, const GpuFuture& f);
+        // records an event capturing all work enqueued on stream so far
+        GpuFuture Record(hipStream_t stream);
+        // runs fn on the host once f is complete (checked on AcquireStream and Synchronize)
+        void Defer(const GpuFuture& f, std::function<void()> fn);
+
+        // waits for every stream of this context and runs all deferred callbacks
+        void Synchronize();
+
+        // context shared by the wrappers that are not given one explicitly
+        static ExecContext& Default();
+
+    private:
+        void Poll();
+
+        std::vector<hipStream_t> compute;
+        hipStream_t upload;
+        hipStream_t download;
+        size_t next = 0;
+        std::mutex mtx;
+        std::vector<std::pair<GpuFuture, std::function<void()>>> deferred;
+};
+
+#endif
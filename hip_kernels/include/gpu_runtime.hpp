@@ -0,0 +1,100 @@
+#ifndef __GPU_RUNTIME__
+#define __GPU_RUNTIME__
+
+/**
+* Runtime API of the backend the library is built for.
+*
+* The library calls the subset of the HIP runtime it uses through namespace gpurt. The CPU build
+* (GPU_FUNCS_CPU) implements it on host memory: "device" allocations are aligned host
+* allocations, every operation completes before it returns, so streams are plain handles and
+* events are always complete. Stream ordering is trivially respected and code written against
+* streams and events runs unchanged. The HIP build forwards gpurt to the HIP runtime, or to the
+* same host implementation (namespace gpu_host) when it runs on the host, see gpuOnHost().
+*/
+#ifndef GPU_FUNCS_CPU
+
+#include "hip/hip_runtime.h"
+
+#else
+
+#include <cstddef>
+
+typedef int hipError_t;
+enum {
+    hipSuccess = 0,
+    hipErrorInvalidValue = 1,
+    hipErrorNotReady = 600
+};
+
+typedef struct ihipStream_t* hipStream_t;
+typedef struct ihipEvent_t* hipEvent_t;
+
+enum hipMemcpyKind {
+    hipMemcpyHostToHost = 0,
+    hipMemcpyHostToDevice = 1,
+    hipMemcpyDeviceToHost = 2,
+    hipMemcpyDeviceToDevice = 3,
+    hipMemcpyDefault = 4
+};
+
+#define hipStreamDefault        0
+#define hipStreamNonBlocking    1
+#define hipEventDefault         0
+#define hipEventDisableTiming   2
+#define hipHostMallocDefault    0
+
+#endif
+
+// the runtime subset of the library, declared in gpurt and, in the HIP build, in gpu_host
+#define GPU_RUNTIME_API \
+    hipError_t hipMalloc(void** ptr, size_t size); \
+    hipError_t hipFree(void* ptr); \
+    hipError_t hipHostMalloc(void** ptr, size_t size, unsigned int flags); \
+    hipError_t hipHostFree(void* ptr); \
+    template <class T> \
+    hipError_t hipMalloc(T** ptr, size_t size) { return hipMalloc((void**)ptr, size); } \
+    template <class T> \
+    hipError_t hipHostMalloc(T** ptr, size_t size, unsigned int flags = hipHostMallocDefault) { \
+        return hipHostMalloc((void**)ptr, size, flags); \
+    } \
+    hipError_t hipMemcpy(void* dst, const void* src, size_t size, hipMemcpyKind kind); \
+    hipError_t hipMemcpyAsync(void* dst, const void* src, size_t size, hipMemcpyKind kind, hipStream_t stream = 0); \
+    hipError_t hipMemset(void* dst, int value, size_t size); \
+    hipError_t hipMemsetAsync(void* dst, int value, size_t size, hipStream_t stream = 0); \
+    hipError_t hipStreamCreate(hipStream_t* stream); \
+    hipError_t hipStreamCreateWithFlags(hipStream_t* stream, unsigned int flags); \
+    hipError_t hipStreamDestroy(hipStream_t stream); \
+    hipError_t hipStreamSynchronize(hipStream_t stream); \
+    hipError_t hipStreamWaitEvent(hipStream_t stream, hipEvent_t event, unsigned int flags); \
+    hipError_t hipEventCreate(hipEvent_t* event); \
+    hipError_t hipEventCreateWithFlags(hipEvent_t* event, unsigned int flags); \
+    hipError_t hipEventDestroy(hipEvent_t event); \
+    hipError_t hipEventRecord(hipEvent_t event, hipStream_t stream = 0); \
+    hipError_t hipEventQuery(hipEvent_t event); \
+    hipError_t hipEventSynchronize(hipEvent_t event); \
+    hipError_t hipEventElapsedTime(float* ms, hipEvent_t start, hipEvent_t stop); \
+    hipError_t hipDeviceSynchronize(); \
+    hipError_t hipGetDeviceCount(int* count); \
+    hipError_t hipGetLastError(); \
+    const char* hipGetErrorString(hipError_t error);
+
+namespace gpurt {
+GPU_RUNTIME_API
+}
+
+#ifdef GPU_FUNCS_CPU
+// the host implementation is the runtime, under the usual names
+using namespace gpurt;
+#else
+namespace gpu_host {
+GPU_RUNTIME_API
+}
+#endif
+
+#undef GPU_RUNTIME_API
+
+// true when the library runs on the host: always in the CPU build, and in a HIP build that finds no
+// device or runs with GPU_FUNCS_FORCE_CPU=1 in the environment. Probed once per process.
+bool gpuOnHost();
+
+#endif
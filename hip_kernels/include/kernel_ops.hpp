@@ -0,0 +1,113 @@
+#ifndef __KERNEL_OPS__
+#define __KERNEL_OPS__
+
+#include <cstddef>
+#include <cstdint>
+#include "reduction.hpp"
+
+/**
+* Arithmetic shared by the two backends of the library.
+*
+* Every function here computes one coefficient or one butterfly. The HIP kernels
+* (gpu_functions.hip) map them onto threads and the CPU backend (cpu_functions.cpp) onto OpenMP
+* loops, so both produce the same words for the same inputs; only the distribution of the work
+* differs.
+*/
+
+/**
+* tables of a fast (approximate) RNS basis switch from sizeIn to sizeOut limbs,
+* the ones DCRTPoly::ApproxSwitchCRTBasis takes: hatInv and its Shoup precomputation per input
+* limb, hatModOut as a row-major sizeIn x sizeOut matrix, two words of floor(2^128/p) per output limb
+*/
+struct SwitchBasis_params {
+    int sizeIn;
+    int sizeOut;
+    uint64_t* inModuli;
+    uint64_t* hatInv;
+    uint64_t* hatInvPrecon;
+    uint64_t* hatModOut;
+    uint64_t* outModuli;
+    uint64_t* outMu;
+};
+
+// Element-wise ops ///////////////////////////////////////////////////////////////////////////////////////
+// reduced inputs, see reduction.hpp
+KERNEL_FUNC uint64_t add_mod_elem(uint64_t a, uint64_t b, uint64_t q)
+{
+    return add_mod(a, b, q);
+}
+
+KERNEL_FUNC uint64_t mult_mod_elem(uint64_t a, uint64_t b, const Modulus_params& m)
+{
+    return barrett_mult(a, b, m);
+}
+
+// Butterfly operations //////////////////////////////////////////////////////////////////////////////////////
+KERNEL_FUNC void barrett_CT_butterfly(uint64_t& a, uint64_t& b, uint64_t& twiddle, uint64_t &q, uint64_t& mu, int& qbit){
+    b = barrett_mult(b, twiddle, q, mu, qbit);
+    uint64_t temp = add_mod(a, b, q);
+    b = sub_mod(a, b, q);
+    a = temp;
+};
+
+KERNEL_FUNC void barrett_GS_butterfly(uint64_t& a, uint64_t& b, uint64_t& twiddle, uint64_t &q, uint64_t& q2, uint64_t& mu, int& qbit){
+    uint64_t temp = add_mod(a, b, q);
+    uint64_t diff = barrett_mult(sub_mod(a, b, q), twiddle, q, mu, qbit);
+    a = half_mod(temp, q2);   // store addition result
+    b = half_mod(diff, q2);   // store subtraction result
+}
+
+// Hybrid key switching ///////////////////////////////////////////////////////////////////////////////////
+// The reductions are bit-exact ports of the ones OpenFHE uses for the same steps, so the
+// results match DCRTPoly::ApproxSwitchCRTBasis / ApproxModDown word for word.
+
+// coefficient ri of output limb j: sum_i [in[i] * hatInv[i]]_{q_i} * hatModOut[i][j] mod p_j.
+// The 128-bit sum holds up to 256 products of 64-bit words.
+KERNEL_FUNC uint64_t switch_basis_coeff(const uint64_t* in, int N, int ri, int j, const SwitchBasis_params& t)
+{
+    uint128_t sum = 0;
+    for (int i = 0; i < t.sizeIn; i++) {
+        uint64_t x = mulmod_shoup(in[(size_t)i * N + ri], t.hatInv[i], t.hatInvPrecon[i], t.inModuli[i]);
+        sum += (uint128_t)x * t.hatModOut[i * t.sizeOut + j];
+    }
+    return barrett_128(sum, t.outModuli[j], t.outMu[2 * j], t.outMu[2 * j + 1]);
+}
+
+// coefficient ri of limb i of out0 = sum_d digit_d * b_d and out1 = sum_d digit_d * a_d. Limb i of
+// the digits is limb i of the key for i < sizeQl and limb sizeQ + (i - sizeQl) (the P part) otherwise.
+KERNEL_FUNC void key_switch_inner_product_coeff(const uint64_t* digits, int numDigits, const uint64_t* keyA,
+    const uint64_t* keyB, uint64_t* out0, uint64_t* out1, int N, int ri, int i, int sizeQl, int sizeQlP,
+    int sizeQ, int sizeQP, const uint64_t* moduli, const uint64_t* mus)
+{
+    int k = i < sizeQl ? i : sizeQ + (i - sizeQl);
+    uint128_t s0 = 0, s1 = 0;
+    for (int d = 0; d < numDigits; d++) {
+        uint64_t c = digits[((size_t)d * sizeQlP + i) * N + ri];
+        size_t kidx = ((size_t)d * sizeQP + k) * N + ri;
+        s0 += (uint128_t)c * keyB[kidx];
+        s1 += (uint128_t)c * keyA[kidx];
+    }
+    out0[(size_t)i * N + ri] = barrett_128(s0, moduli[i], mus[2 * i], mus[2 * i + 1]);
+    out1[(size_t)i * N + ri] = barrett_128(s1, moduli[i], mus[2 * i], mus[2 * i + 1]);
+}
+
+// acc + (c - s) * PInvModq, the last step of ApproxModDown folded into the key switching sum
+KERNEL_FUNC uint64_t mod_down_add_elem(uint64_t acc, uint64_t c, uint64_t s, uint64_t q, uint64_t PInvModq,
+    uint64_t PInvModqPrecon)
+{
+    return add_mod(acc, mulmod_shoup(sub_mod(c, s, q), PInvModq, PInvModqPrecon, q), q);
+}
+
+// Ciphertext tensor product /////////////////////////////////////////////////////////////////////////////
+// (d0, d1, d2) = (a0*b0, a0*b1 + a1*b0, a1*b1) for one coefficient. All four inputs are read before
+// anything is written, so the outputs may alias the inputs.
+KERNEL_FUNC void tensor_product_coeff(const uint64_t* a0, const uint64_t* a1, const uint64_t* b0,
+    const uint64_t* b1, uint64_t* d0, uint64_t* d1, uint64_t* d2, size_t idx, uint64_t q, uint64_t mu, int qbit)
+{
+    uint64_t x0 = a0[idx], x1 = a1[idx], y0 = b0[idx], y1 = b1[idx];
+    d0[idx] = barrett_mult(x0, y0, q, mu, qbit);
+    d1[idx] = add_mod(barrett_mult(x0, y1, q, mu, qbit), barrett_mult(x1, y0, q, mu, qbit), q);
+    d2[idx] = barrett_mult(x1, y1, q, mu, qbit);
+}
+
+#endif
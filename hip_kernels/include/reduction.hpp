@@ -0,0 +1,152 @@
+#ifndef __REDUCTION__
+#define __REDUCTION__
+
+#include <cstdint>
+#include "gpu_runtime.hpp"
+
+/**
+* Modular reductions shared by the element-wise kernels and the butterflies.
+*
+* No reduction here divides: Barrett, Montgomery and Shoup each take constants precomputed once
+* per modulus, either in a Modulus_params (make_modulus) or, for Shoup, next to the constant
+* operand. All of them assume q < 2^62 and reduced operands (< q); the RNS primes OpenFHE
+* generates have at most 60 bits.
+*/
+
+#ifdef GPU_FUNCS_CPU
+#define KERNEL_FUNC inline
+#else
+#define KERNEL_FUNC __host__ __device__ __forceinline__
+#endif
+
+#define uint128_t          unsigned __int128
+
+using std::uint64_t;
+
+/**
+* precomputed constants of one RNS limb
+*/
+struct Modulus_params {
+    uint64_t q;
+    uint64_t mu; // floor(2^(2 qbit + 1) / q), the Barrett constant of the NTT (NTT_params::mus)
+    int qbit; // bit length of q
+    uint64_t qinv; // -q^-1 mod 2^64, for Montgomery reduction
+    uint64_t r2; // 2^128 mod q, to enter the Montgomery domain
+};
+
+// the only place that divides, once per modulus
+KERNEL_FUNC Modulus_params make_modulus(uint64_t q)
+{
+    Modulus_params m;
+    m.q = q;
+    m.qbit = 0;
+    while ((q >> m.qbit) != 0)
+        m.qbit++;
+    m.mu = (uint64_t)(((uint128_t)1 << (2 * m.qbit + 1)) / q);
+    // Newton iteration for q^-1 mod 2^64, each step doubles the correct low bits (q*q = 1 mod 8)
+    uint64_t inv = q;
+    for (int i = 0; i < 5; i++)
+        inv *= 2 - q * inv;
+    m.qinv = 0 - inv;
+    m.r2 = (uint64_t)((~(uint128_t)0 % q + 1) % q);
+    return m;
+}
+
+// Addition ///////////////////////////////////////////////////////////////////////////////////////////////
+KERNEL_FUNC uint64_t add_mod(uint64_t a, uint64_t b, uint64_t q)
+{
+    uint64_t s = a + b;
+    return s - q * (s >= q);
+}
+
+KERNEL_FUNC uint64_t sub_mod(uint64_t a, uint64_t b, uint64_t q)
+{
+    return a - b + q * (a < b);
+}
+
+// a / 2 mod q for odd q, q2 = (q + 1) / 2
+KERNEL_FUNC uint64_t half_mod(uint64_t a, uint64_t q2)
+{
+    return (a >> 1) + q2 * (a & 1);
+}
+
+// Barrett ////////////////////////////////////////////////////////////////////////////////////////////////
+KERNEL_FUNC void neals_barrett(uint128_t& c, uint64_t& q, uint64_t& mu, int& qbit)  // Ozerk
+{
+    // c < q^2: the shifted input, the quotient and the remainder all fit in a word,
+    // so the only wide operation is one 64x64 product
+    uint64_t rx = (uint64_t)(c >> (qbit - 2));
+    uint64_t quot = (uint64_t)(((uint128_t)rx * mu) >> (qbit + 3));
+    uint64_t r = (uint64_t)c - quot * q;
+    c = r - q * (r >= q);
+}
+
+KERNEL_FUNC uint64_t barrett_mult(uint64_t a, uint64_t b, uint64_t q, uint64_t mu, int qbit)
+{
+    uint128_t c = (uint128_t)a * b;
+    neals_barrett(c, q, mu, qbit);
+    return (uint64_t)c;
+}
+
+KERNEL_FUNC uint64_t barrett_mult(uint64_t a, uint64_t b, const Modulus_params& m)
+{
+    return barrett_mult(a, b, m.q, m.mu, m.qbit);
+}
+
+// x mod q with mu = floor(2^128 / q) as two words (BarrettUint128ModUint64), for sums of products
+KERNEL_FUNC uint64_t barrett_128(uint128_t x, uint64_t q, uint64_t mu_lo, uint64_t mu_hi)
+{
+    uint64_t x_lo = (uint64_t)x;
+    uint64_t x_hi = (uint64_t)(x >> 64);
+    // only the low word of floor(x * mu / 2^128) is needed
+    uint128_t mid1 = (uint128_t)x_lo * mu_hi;
+    uint128_t mid2 = (uint128_t)x_hi * mu_lo;
+    uint128_t carry = (((uint128_t)x_lo * mu_lo) >> 64) + (uint64_t)mid1 + (uint64_t)mid2;
+    uint64_t quot = x_hi * mu_hi + (uint64_t)(mid1 >> 64) + (uint64_t)(mid2 >> 64) + (uint64_t)(carry >> 64);
+    uint64_t r = x_lo - quot * q;
+    while (r >= q)
+        r -= q;
+    return r;
+}
+
+// Montgomery, R = 2^64 ///////////////////////////////////////////////////////////////////////////////////
+// t * R^-1 mod q for t < q * R
+KERNEL_FUNC uint64_t montgomery_reduce(uint128_t t, const Modulus_params& m)
+{
+    uint64_t k = (uint64_t)t * m.qinv;
+    uint64_t r = (uint64_t)((t + (uint128_t)k * m.q) >> 64);
+    return r - m.q * (r >= m.q);
+}
+
+// a * b * R^-1 mod q: the product of two operands in the Montgomery domain stays in it
+KERNEL_FUNC uint64_t montgomery_mult(uint64_t a, uint64_t b, const Modulus_params& m)
+{
+    return montgomery_reduce((uint128_t)a * b, m);
+}
+
+KERNEL_FUNC uint64_t to_montgomery(uint64_t a, const Modulus_params& m)
+{
+    return montgomery_mult(a, m.r2, m);
+}
+
+KERNEL_FUNC uint64_t from_montgomery(uint64_t a, const Modulus_params& m)
+{
+    return montgomery_reduce(a, m);
+}
+
+// Shoup //////////////////////////////////////////////////////////////////////////////////////////////////
+// floor(b * 2^64 / q), computed once per constant operand b (twiddles, scalars)
+KERNEL_FUNC uint64_t shoup_precon(uint64_t b, uint64_t q)
+{
+    return (uint64_t)(((uint128_t)b << 64) / q);
+}
+
+// a * b mod q for a constant b with bprecon = shoup_precon(b, q) (NativeInteger::ModMulFastConst)
+KERNEL_FUNC uint64_t mulmod_shoup(uint64_t a, uint64_t b, uint64_t bprecon, uint64_t q)
+{
+    uint64_t hi = (uint64_t)(((uint128_t)a * bprecon) >> 64);
+    uint64_t r = a * b - hi * q;
+    return r - q * (r >= q);
+}
+
+#endif
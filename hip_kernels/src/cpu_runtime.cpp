@@ -0,0 +1,147 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include "gpu_runtime.hpp"
+
+// host implementation of the runtime subset in gpu_runtime.hpp: the runtime of the CPU build
+// (GPU_FUNCS_CPU), and the one a HIP build falls back to when gpuOnHost()
+
+#ifdef GPU_FUNCS_CPU
+namespace gpurt {
+#else
+namespace gpu_host {
+#endif
+
+// what the stream and event handles point to; opaque types of the HIP runtime in the HIP build
+struct HostStream {};
+
+struct HostEvent {
+    std::chrono::steady_clock::time_point time;
+};
+
+hipError_t hipMalloc(void** ptr, size_t size) {
+    // cache line aligned, like the device allocations the kernels were written for
+    size_t rounded = size == 0 ? 64 : ((size + 63) / 64) * 64;
+    *ptr = std::aligned_alloc(64, rounded);
+    return *ptr ? hipSuccess : hipErrorInvalidValue;
+}
+
+hipError_t hipFree(void* ptr) {
+    std::free(ptr);
+    return hipSuccess;
+}
+
+hipError_t hipHostMalloc(void** ptr, size_t size, unsigned int flags) {
+    return hipMalloc(ptr, size);
+}
+
+hipError_t hipHostFree(void* ptr) {
+    return hipFree(ptr);
+}
+
+hipError_t hipMemcpy(void* dst, const void* src, size_t size, hipMemcpyKind kind) {
+    std::memmove(dst, src, size);
+    return hipSuccess;
+}
+
+hipError_t hipMemcpyAsync(void* dst, const void* src, size_t size, hipMemcpyKind kind, hipStream_t stream) {
+    // not forwarded to hipMemcpy: in the HIP build the argument types would find the HIP one as well
+    std::memmove(dst, src, size);
+    return hipSuccess;
+}
+
+hipError_t hipMemset(void* dst, int value, size_t size) {
+    std::memset(dst, value, size);
+    return hipSuccess;
+}
+
+hipError_t hipMemsetAsync(void* dst, int value, size_t size, hipStream_t stream) {
+    return hipMemset(dst, value, size);
+}
+
+hipError_t hipStreamCreate(hipStream_t* stream) {
+    *stream = reinterpret_cast<hipStream_t>(new HostStream());
+    return hipSuccess;
+}
+
+hipError_t hipStreamCreateWithFlags(hipStream_t* stream, unsigned int flags) {
+    *stream = reinterpret_cast<hipStream_t>(new HostStream());
+    return hipSuccess;
+}
+
+hipError_t hipStreamDestroy(hipStream_t stream) {
+    delete reinterpret_cast<HostStream*>(stream);
+    return hipSuccess;
+}
+
+hipError_t hipStreamSynchronize(hipStream_t stream) {
+    return hipSuccess;
+}
+
+hipError_t hipStreamWaitEvent(hipStream_t stream, hipEvent_t event, unsigned int flags) {
+    return hipSuccess;
+}
+
+hipError_t hipEventCreate(hipEvent_t* event) {
+    *event = reinterpret_cast<hipEvent_t>(new HostEvent());
+    return hipSuccess;
+}
+
+hipError_t hipEventCreateWithFlags(hipEvent_t* event, unsigned int flags) {
+    *event = reinterpret_cast<hipEvent_t>(new HostEvent());
+    return hipSuccess;
+}
+
+hipError_t hipEventDestroy(hipEvent_t event) {
+    delete reinterpret_cast<HostEvent*>(event);
+    return hipSuccess;
+}
+
+hipError_t hipEventRecord(hipEvent_t event, hipStream_t stream) {
+    reinterpret_cast<HostEvent*>(event)->time = std::chrono::steady_clock::now();
+    return hipSuccess;
+}
+
+hipError_t hipEventQuery(hipEvent_t event) {
+    return hipSuccess;
+}
+
+hipError_t hipEventSynchronize(hipEvent_t event) {
+    return hipSuccess;
+}
+
+hipError_t hipEventElapsedTime(float* ms, hipEvent_t start, hipEvent_t stop) {
+    *ms = std::chrono::duration<float, std::milli>(reinterpret_cast<HostEvent*>(stop)->time -
+                                                   reinterpret_cast<HostEvent*>(start)->time).count();
+    return hipSuccess;
+}
+
+hipError_t hipDeviceSynchronize() {
+    return hipSuccess;
+}
+
+hipError_t hipGetDeviceCount(int* count) {
+    // the host stands in for one device
+    *count = 1;
+    return hipSuccess;
+}
+
+hipError_t hipGetLastError() {
+    return hipSuccess;
+}
+
+const char* hipGetErrorString(hipError_t error) {
+    switch (error) {
+        case hipSuccess: return "no error";
+        case hipErrorNotReady: return "not ready";
+        default: return "invalid value";
+    }
+}
+
+}
+
+#ifdef GPU_FUNCS_CPU
+bool gpuOnHost() {
+    return true;
+}
+#endif
@@ -0,0 +1,56 @@
+#include <cassert>
+#include <iostream>
+#include "include/device_pool.hpp"
+
+// Exercises the pooled allocator with the CPU stand-in backend, no GPU required
+int main() {
+
+    int N=1024;
+    int L=3;
+    size_t numElems=N*L;
+
+    uint64_t* hostArray=new uint64_t[numElems];
+    uint64_t* backArray=new uint64_t[numElems];
+    for (size_t i=0;i<numElems;i++) {
+        hostArray[i]=i*7+1;
+    }
+
+    DevicePool<HostBackend> pool;
+
+    // round trip through staging buffers
+    uint64_t* dev=pool.Upload(hostArray, numElems);
+    pool.Synchronize();
+    pool.Download(backArray, dev, numElems);
+    for (size_t i=0;i<numElems;i++) {
+        assert(backArray[i]==hostArray[i]);
+    }
+
+    // a released block of the same size class is handed out again
+    pool.Release(dev, numElems);
+    uint64_t* dev2=pool.Acquire(numElems);
+    assert(dev2==dev);
+
+    // a different size class does not alias it
+    uint64_t* moduli=pool.Acquire(L);
+    assert(moduli!=dev2);
+
+    auto stats=pool.GetStats();
+    assert(stats.deviceAllocs==2);
+    assert(stats.deviceReuses==1);
+    // one staging buffer for the upload, reused by the download
+    assert(stats.pinnedAllocs==1);
+    assert(stats.pinnedReuses==1);
+
+    pool.Release(dev2, numElems);
+    pool.Release(moduli, L);
+    assert(pool.GetStats().bytesCached==(numElems+L+numElems)*sizeof(uint64_t));
+
+    pool.Trim();
+    assert(pool.GetStats().bytesCached==0);
+
+    delete[] hostArray;
+    delete[] backArray;
+
+    std::cout << "device pool tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,375 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+ * GPU counterparts of the NTT and CKKSrns benchmarks of lib-benchmark, on the backend gpu_funcs was built for.
+ * The time of each benchmark is the kernel time, measured with events on the device; the host-side launch
+ * overhead and the host-to-device / device-to-host transfers of the same data are reported as the counters
+ * launch_us, h2d_us and d2h_us. The kernels are swept over the ring dimension, the number of limbs and the
+ * batch size. --benchmark_format=json gives output that can be diffed with the one of lib-benchmark.
+ */
+
+#define _USE_MATH_DEFINES
+#include "scheme/ckksrns/cryptocontext-ckksrns.h"
+#include "gen-cryptocontext.h"
+#include "rawkeyswitch.h"
+
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <random>
+
+using namespace lbcrypto;
+
+/*
+ * Timing utilities
+ */
+
+// events at the boundaries of the phases of one iteration: upload, compute, download
+class PhaseTimer {
+public:
+    enum Phase { START, UPLOADED, COMPUTED, DOWNLOADED, NUM_PHASES };
+
+    PhaseTimer() {
+        for (auto& ev : events)
+            hipEventCreate(&ev);
+    }
+
+    ~PhaseTimer() {
+        for (auto& ev : events)
+            hipEventDestroy(ev);
+    }
+
+    void Mark(Phase phase, hipStream_t stream) {
+        hipEventRecord(events[phase], stream);
+    }
+
+    // host time spent enqueueing the compute phase
+    void BeginLaunch() {
+        launchStart = std::chrono::steady_clock::now();
+    }
+
+    void EndLaunch() {
+        launch += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - launchStart).count();
+    }
+
+    // waits for the iteration, reports its kernel time and accumulates the transfers
+    void EndIteration(benchmark::State& state) {
+        hipEventSynchronize(events[DOWNLOADED]);
+        h2d += Elapsed(START, UPLOADED);
+        d2h += Elapsed(COMPUTED, DOWNLOADED);
+        state.SetIterationTime(Elapsed(UPLOADED, COMPUTED) * 1e-6);
+    }
+
+    void Report(benchmark::State& state) {
+        state.counters["launch_us"] = benchmark::Counter(launch, benchmark::Counter::kAvgIterations);
+        state.counters["h2d_us"]    = benchmark::Counter(h2d, benchmark::Counter::kAvgIterations);
+        state.counters["d2h_us"]    = benchmark::Counter(d2h, benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    // microseconds between two marks
+    double Elapsed(Phase from, Phase to) {
+        float ms = 0;
+        hipEventElapsedTime(&ms, events[from], events[to]);
+        return ms * 1e3;
+    }
+
+    hipEvent_t events[NUM_PHASES];
+    std::chrono::steady_clock::time_point launchStart;
+    double launch = 0;
+    double h2d    = 0;
+    double d2h    = 0;
+};
+
+/*
+ * Raw polynomial kernels
+ */
+
+// count polynomials of L limbs of N random coefficients, in pinned host memory and on the device
+class PolyBatch {
+public:
+    PolyBatch(const NTT_params& params, const std::vector<uint64_t>& moduli, int count)
+        : size((size_t)params.N * params.L) {
+        std::mt19937_64 prng(count);
+        for (int p = 0; p < count; p++) {
+            host.push_back(gpuMemoryPool().AcquireStaging(size));
+            device.push_back(gpuMemoryPool().Acquire(size));
+            for (size_t i = 0; i < size; i++)
+                host[p][i] = prng() % moduli[i / params.N];
+        }
+    }
+
+    ~PolyBatch() {
+        for (size_t p = 0; p < host.size(); p++) {
+            gpuMemoryPool().ReleaseStaging(host[p], size);
+            gpuMemoryPool().Release(device[p], size);
+        }
+    }
+
+    void Upload(hipStream_t stream) {
+        for (size_t p = 0; p < host.size(); p++)
+            copyToGPUAsync(device[p], host[p], size, stream);
+    }
+
+    void Download(hipStream_t stream) {
+        for (size_t p = 0; p < host.size(); p++)
+            copyToHostAsync(host[p], device[p], size, stream);
+    }
+
+    size_t Bytes() const {
+        return host.size() * size * sizeof(uint64_t);
+    }
+
+    size_t size;
+    std::vector<uint64_t*> host;
+    std::vector<uint64_t*> device;
+};
+
+// NTT tables of L limbs of 50 bits for ring dimension 2^logN, served by GPUTwiddleCache
+NTT_params GetBenchNTTParams(int logN, int L, std::vector<uint64_t>& moduli) {
+    auto params = std::make_shared<DCRTPoly::Params>(2 << logN, L, 50);
+    for (const auto& p : params->GetParams())
+        moduli.push_back(p->GetModulus().ConvertToInt());
+    return GPUTwiddleCache::Instance().GetNTTParams(params);
+}
+
+static void PolyArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"logN", "L", "batch"});
+    for (int logN : {12, 14, 16})
+        for (int L : {1, 8, 24})
+            for (int batch : {1, 4, 16})
+                b->Args({logN, L, batch});
+}
+
+void NTTBenchmark(benchmark::State& state, bool inverse) {
+    std::vector<uint64_t> moduli;
+    NTT_params params = GetBenchNTTParams(state.range(0), state.range(1), moduli);
+    PolyBatch batch(params, moduli, state.range(2));
+    hipStream_t stream = ExecContext::Default().AcquireStream();
+    PhaseTimer timer;
+
+    for (auto _ : state) {
+        timer.Mark(PhaseTimer::START, stream);
+        batch.Upload(stream);
+        timer.Mark(PhaseTimer::UPLOADED, stream);
+        timer.BeginLaunch();
+        if (inverse)
+            gpuINTT(batch.device.data(), batch.device.size(), params, stream);
+        else
+            gpuNTT(batch.device.data(), batch.device.size(), params, stream);
+        timer.EndLaunch();
+        timer.Mark(PhaseTimer::COMPUTED, stream);
+        batch.Download(stream);
+        timer.Mark(PhaseTimer::DOWNLOADED, stream);
+        timer.EndIteration(state);
+    }
+    timer.Report(state);
+    state.SetBytesProcessed(state.iterations() * batch.Bytes());
+}
+
+void GPU_NTTTransform(benchmark::State& state) {
+    NTTBenchmark(state, false);
+}
+
+BENCHMARK(GPU_NTTTransform)->Apply(PolyArgs)->UseManualTime()->Unit(benchmark::kMicrosecond);
+
+void GPU_INTTTransform(benchmark::State& state) {
+    NTTBenchmark(state, true);
+}
+
+BENCHMARK(GPU_INTTTransform)->Apply(PolyArgs)->UseManualTime()->Unit(benchmark::kMicrosecond);
+
+// batch ciphertext pairs (4 polynomials) into batch products (3 polynomials)
+void GPU_TensorProduct(benchmark::State& state) {
+    std::vector<uint64_t> moduli;
+    NTT_params params = GetBenchNTTParams(state.range(0), state.range(1), moduli);
+    int pairs = state.range(2);
+    PolyBatch in(params, moduli, 4 * pairs);
+    PolyBatch out(params, moduli, 3 * pairs);
+    std::vector<const uint64_t*> inPtrs(in.device.begin(), in.device.end());
+    hipStream_t stream = ExecContext::Default().AcquireStream();
+    PhaseTimer timer;
+
+    for (auto _ : state) {
+        timer.Mark(PhaseTimer::START, stream);
+        in.Upload(stream);
+        timer.Mark(PhaseTimer::UPLOADED, stream);
+        timer.BeginLaunch();
+        gpuTensorProduct(inPtrs.data(), out.device.data(), pairs, params.N, params.L, params.moduli, params.mus,
+                         params.qbits, stream);
+        timer.EndLaunch();
+        timer.Mark(PhaseTimer::COMPUTED, stream);
+        out.Download(stream);
+        timer.Mark(PhaseTimer::DOWNLOADED, stream);
+        timer.EndIteration(state);
+    }
+    timer.Report(state);
+    state.SetBytesProcessed(state.iterations() * (in.Bytes() + out.Bytes()));
+}
+
+BENCHMARK(GPU_TensorProduct)->Apply(PolyArgs)->UseManualTime()->Unit(benchmark::kMicrosecond);
+
+/*
+ * CKKS operations on raw ciphertexts, with the context of the CKKSrns benchmarks of lib-benchmark
+ */
+
+CryptoContext<DCRTPoly> GenerateCKKSContext() {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetScalingModSize(48);
+    parameters.SetBatchSize(8);
+    parameters.SetScalingTechnique(FIXEDMANUAL);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    return cc;
+}
+
+Ciphertext<DCRTPoly> EncryptCKKS(CryptoContext<DCRTPoly> cc, const PublicKey<DCRTPoly>& publicKey) {
+    usint slots = cc->GetEncodingParams()->GetBatchSize();
+    std::vector<std::complex<double>> vectorOfInts(slots);
+    for (usint i = 0; i < slots; i++) {
+        vectorOfInts[i] = 1.001 * i;
+    }
+    return cc->Encrypt(publicKey, cc->MakeCKKSPackedPlaintext(vectorOfInts));
+}
+
+/*
+ * Runs op on batch pairs of raw ciphertexts: the operands are uploaded, op enqueues its work, which is
+ * complete when all the ciphertexts are ready, and the ciphertexts are downloaded.
+ */
+template <class Op>
+void CKKSBenchmark(benchmark::State& state, CryptoContext<DCRTPoly> cc, const Ciphertext<DCRTPoly>& c1,
+                   const Ciphertext<DCRTPoly>& c2, int batch, Op op) {
+    ExecContext& ctx = ExecContext::Default();
+    hipStream_t stream = ctx.AcquireStream();
+    PhaseTimer timer;
+
+    for (auto _ : state) {
+        // raw ciphertexts are views of their inputs, so work on clones
+        std::vector<Ciphertext<DCRTPoly>> clones;
+        std::vector<RawCipherText> raw;
+        for (int i = 0; i < batch; i++) {
+            clones.push_back(c1->Clone());
+            clones.push_back(c2->Clone());
+        }
+        for (auto& ct : clones)
+            raw.push_back(GetRawCipherText(cc, ct));
+
+        timer.Mark(PhaseTimer::START, ctx.UploadStream());
+        for (auto& ct : raw)
+            MoveToGPU(&ct, ctx);
+        timer.Mark(PhaseTimer::UPLOADED, ctx.UploadStream());
+        std::vector<RawCipherText*> ct1s, ct2s;
+        for (int i = 0; i < batch; i++) {
+            ct1s.push_back(&raw[2 * i]);
+            ct2s.push_back(&raw[2 * i + 1]);
+        }
+        timer.BeginLaunch();
+        op(ct1s, ct2s, ctx);
+        timer.EndLaunch();
+        for (auto& ct : raw)
+            ctx.DependsOn(stream, ct.ready);
+        timer.Mark(PhaseTimer::COMPUTED, stream);
+        for (auto& ct : raw)
+            MoveToHost(&ct, ctx);
+        timer.Mark(PhaseTimer::DOWNLOADED, ctx.DownloadStream());
+        timer.EndIteration(state);
+    }
+    timer.Report(state);
+}
+
+void GPU_CKKSrns_Add(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc = GenerateCKKSContext();
+    KeyPair<DCRTPoly> keyPair  = cc->KeyGen();
+    auto ciphertext1           = EncryptCKKS(cc, keyPair.publicKey);
+    auto ciphertext2           = EncryptCKKS(cc, keyPair.publicKey);
+
+    CKKSBenchmark(state, cc, ciphertext1, ciphertext2, state.range(0),
+                  [](std::vector<RawCipherText*>& ct1s, std::vector<RawCipherText*>& ct2s, ExecContext& ctx) {
+                      for (size_t i = 0; i < ct1s.size(); i++)
+                          EvalAddGPU(ct1s[i], ct2s[i], ctx);
+                  });
+}
+
+BENCHMARK(GPU_CKKSrns_Add)->ArgName("batch")->Arg(1)->Arg(4)->Arg(16)->UseManualTime()->Unit(benchmark::kMicrosecond);
+
+void GPU_CKKSrns_MultNoRelin(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc = GenerateCKKSContext();
+    KeyPair<DCRTPoly> keyPair  = cc->KeyGen();
+    auto ciphertext1           = EncryptCKKS(cc, keyPair.publicKey);
+    auto ciphertext2           = EncryptCKKS(cc, keyPair.publicKey);
+
+    CKKSBenchmark(state, cc, ciphertext1, ciphertext2, state.range(0),
+                  [](std::vector<RawCipherText*>& ct1s, std::vector<RawCipherText*>& ct2s, ExecContext& ctx) {
+                      EvalMultGPUNoRelinBatch(ct1s, ct2s, ct1s, ctx);
+                  });
+}
+
+BENCHMARK(GPU_CKKSrns_MultNoRelin)
+    ->ArgName("batch")
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+void GPU_CKKSrns_MultRelin(benchmark::State& state) {
+    CryptoContext<DCRTPoly> cc = GenerateCKKSContext();
+    KeyPair<DCRTPoly> keyPair  = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+    auto ciphertext1 = EncryptCKKS(cc, keyPair.publicKey);
+    auto ciphertext2 = EncryptCKKS(cc, keyPair.publicKey);
+
+    RawKeySwitch<GPUKeySwitchBackend> ks(cc);
+    RawEvalKey key = ks.UploadEvalKey(cc->GetEvalMultKeyVector(keyPair.secretKey->GetKeyTag())[0]);
+
+    CKKSBenchmark(state, cc, ciphertext1, ciphertext2, state.range(0),
+                  [&](std::vector<RawCipherText*>& ct1s, std::vector<RawCipherText*>& ct2s, ExecContext& ctx) {
+                      for (size_t i = 0; i < ct1s.size(); i++)
+                          EvalMultGPU(ct1s[i], ct2s[i], ks, key, ctx);
+                  });
+    ks.FreeEvalKey(key);
+}
+
+BENCHMARK(GPU_CKKSrns_MultRelin)
+    ->ArgName("batch")
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
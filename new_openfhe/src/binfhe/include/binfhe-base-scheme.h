@@ -101,6 +101,21 @@ public:
     LWECiphertext EvalBinGate(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate, const RingGSWBTKey& EK,
                               ConstLWECiphertext& ct1, ConstLWECiphertext& ct2) const;
 
+    /**
+   * Evaluates the same binary gate on independent pairs of ciphertexts. The blind rotations of
+   * all pairs are run together so that each bootstrapping key is read once per batch
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param gate the gate; can be AND, OR, NAND, NOR, XOR, or XOR
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ct1 first ciphertexts
+   * @param ct2 second ciphertexts, of the same size as ct1
+   * @return the resulting ciphertexts, in the order of the inputs
+   */
+    std::vector<LWECiphertext> EvalBinGateBatch(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
+                                                const RingGSWBTKey& EK, const std::vector<LWECiphertext>& ct1,
+                                                const std::vector<LWECiphertext>& ct2) const;
+
     /**
    * Evaluates a binary gate on a vector of ciphertexts (calls bootstrapping as a subroutine).
    * The evaluation of the gates in this function is specific to 3 input and 4 input
@@ -134,6 +149,17 @@ public:
     LWECiphertext Bootstrap(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
                             ConstLWECiphertext& ct) const;
 
+    /**
+   * Bootstraps independent fresh ciphertexts as one batch
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ct input ciphertexts
+   * @return the resulting ciphertexts, in the order of the inputs
+   */
+    std::vector<LWECiphertext> BootstrapBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                              const RingGSWBTKey& EK, const std::vector<LWECiphertext>& ct) const;
+
     /**
    * Evaluate an arbitrary function
    *
@@ -148,6 +174,20 @@ public:
                            ConstLWECiphertext& ct, const std::vector<NativeInteger>& LUT,
                            const NativeInteger& beta) const;
 
+    /**
+   * Evaluate an arbitrary function on independent ciphertexts as one batch
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ct input ciphertexts; all of them should have the same modulus
+   * @param LUT the look-up table of the to-be-evaluated function
+   * @param beta the error bound
+   * @return the resulting ciphertexts, in the order of the inputs
+   */
+    std::vector<LWECiphertext> EvalFuncBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                             const RingGSWBTKey& EK, const std::vector<LWECiphertext>& ct,
+                                             const std::vector<NativeInteger>& LUT, const NativeInteger& beta) const;
+
     /**
    * Evaluate a round down function
    *
@@ -189,6 +229,56 @@ public:
                                           const NativeInteger& beta) const;
 
 private:
+    /**
+   * Extracts an LWE ciphertext from the accumulator and switches it back to the input key and modulus
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param acc the RingLWE accumulator; its elements are consumed
+   * @param b0 constant added to the "b" component of the extracted ciphertext
+   * @param mod the output modulus
+   * @return a shared pointer to the resulting ciphertext
+   */
+    LWECiphertext ExtractACC(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
+                             RLWECiphertext& acc, const NativeInteger& b0, const NativeInteger& mod) const;
+
+    /**
+   * Batched counterpart of ExtractACC; the key switchings share the reads of the switching key
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param acc the RingLWE accumulators; their elements are consumed
+   * @param b0 constants added to the "b" components of the extracted ciphertexts
+   * @param mod the output moduli
+   * @return the resulting ciphertexts, in the order of the accumulators
+   */
+    std::vector<LWECiphertext> ExtractACCBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                               const RingGSWBTKey& EK, std::vector<RLWECiphertext>& acc,
+                                               const std::vector<NativeInteger>& b0,
+                                               const std::vector<NativeInteger>& mod) const;
+
+    /**
+   * Extracts an LWE ciphertext from the accumulator and switches it to the key switching modulus
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param acc the RingLWE accumulator; its elements are consumed
+   * @param b0 constant added to the "b" component of the extracted ciphertext
+   * @return a shared pointer to the resulting ciphertext
+   */
+    LWECiphertext ExtractLWE(const std::shared_ptr<BinFHECryptoParams>& params, RLWECiphertext& acc,
+                             const NativeInteger& b0) const;
+
+    /**
+   * Builds the initial accumulator encoding the test vector of a gate
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param gate the gate; can be AND, OR, NAND, NOR, XOR, or XOR
+   * @param ct input ciphertext
+   * @return the initial RingLWE accumulator
+   */
+    RLWECiphertext InitGateAcc(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
+                               ConstLWECiphertext& ct) const;
+
     /**
    * Core bootstrapping operation
    *
@@ -201,8 +291,34 @@ private:
     RLWECiphertext BootstrapGateCore(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
                                      ConstRingGSWACCKey& ek, ConstLWECiphertext& ct) const;
 
+    /**
+   * Core bootstrapping operation for independent ciphertexts, run as one batch
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param gate the gate; can be AND, OR, NAND, NOR, XOR, or XOR
+   * @param ek a shared pointer to the bootstrapping keys
+   * @param ct input ciphertexts
+   * @return the output RingLWE accumulators
+   */
+    std::vector<RLWECiphertext> BootstrapGateCoreBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                       BINGATE gate, ConstRingGSWACCKey& ek,
+                                                       const std::vector<LWECiphertext>& ct) const;
+
     // Arbitrary function evaluation purposes
 
+    /**
+   * Builds the initial accumulator encoding the test vector of a function
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param ct input ciphertext
+   * @param f function to evaluate in the functional bootstrapping
+   * @param fmod modulus over which the function is defined
+   * @return the initial RingLWE accumulator
+   */
+    template <typename Func>
+    RLWECiphertext InitFuncAcc(const std::shared_ptr<BinFHECryptoParams>& params, ConstLWECiphertext& ct,
+                               const Func f, const NativeInteger& fmod) const;
+
     /**
    * Core bootstrapping operation
    *
@@ -231,6 +347,21 @@ private:
     LWECiphertext BootstrapFunc(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
                                 ConstLWECiphertext& ct, const Func f, const NativeInteger& fmod) const;
 
+    /**
+   * Bootstraps independent ciphertexts with the same function as one batch
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ct input ciphertexts
+   * @param f function to evaluate in the functional bootstrapping
+   * @param fmod modulus over which the function is defined
+   * @return the resulting ciphertexts, in the order of the inputs
+   */
+    template <typename Func>
+    std::vector<LWECiphertext> BootstrapFuncBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                  const RingGSWBTKey& EK, const std::vector<LWECiphertext>& ct,
+                                                  const Func f, const NativeInteger& fmod) const;
+
 protected:
     std::shared_ptr<LWEEncryptionScheme> LWEscheme{std::make_shared<LWEEncryptionScheme>()};
     std::shared_ptr<RingGSWAccumulator> ACCscheme{nullptr};
@@ -51,5 +51,6 @@ CEREAL_REGISTER_TYPE(lbcrypto::RingGSWEvalKeyImpl);
 CEREAL_REGISTER_TYPE(lbcrypto::RingGSWACCKeyImpl);
 CEREAL_REGISTER_TYPE(lbcrypto::BinFHECryptoParams);
 CEREAL_REGISTER_TYPE(lbcrypto::BinFHEContext);
+CEREAL_CLASS_VERSION(lbcrypto::LWESwitchingKeyImpl, lbcrypto::LWESwitchingKeyImpl::SerializedVersion());
 
 #endif
@@ -313,6 +313,18 @@ public:
    */
     LWECiphertext EvalBinGate(BINGATE gate, const std::vector<LWECiphertext>& ctvector) const;
 
+    /**
+   * Evaluates the same binary gate on independent pairs of ciphertexts. The pairs are bootstrapped
+   * together so that each bootstrapping key is streamed from memory once per batch instead of once per gate
+   *
+   * @param gate the gate; can be AND, OR, NAND, NOR, XOR, or XNOR
+   * @param ct1 first ciphertexts
+   * @param ct2 second ciphertexts, of the same size as ct1
+   * @return the resulting ciphertexts, in the order of the inputs
+   */
+    std::vector<LWECiphertext> EvalBinGateBatch(BINGATE gate, const std::vector<LWECiphertext>& ct1,
+                                                const std::vector<LWECiphertext>& ct2) const;
+
     /**
    * Bootstraps a ciphertext (without peforming any operation)
    *
@@ -321,6 +333,14 @@ public:
    */
     LWECiphertext Bootstrap(ConstLWECiphertext& ct) const;
 
+    /**
+   * Bootstraps independent ciphertexts as one batch
+   *
+   * @param ct ciphertexts to be bootstrapped
+   * @return the resulting ciphertexts, in the order of the inputs
+   */
+    std::vector<LWECiphertext> BootstrapBatch(const std::vector<LWECiphertext>& ct) const;
+
     /**
    * Evaluate an arbitrary function
    *
@@ -330,6 +350,16 @@ public:
    */
     LWECiphertext EvalFunc(ConstLWECiphertext& ct, const std::vector<NativeInteger>& LUT) const;
 
+    /**
+   * Evaluate an arbitrary function on independent ciphertexts as one batch
+   *
+   * @param ct ciphertexts to be bootstrapped; all of them should have the same modulus
+   * @param LUT the look-up table of the to-be-evaluated function
+   * @return the resulting ciphertexts, in the order of the inputs
+   */
+    std::vector<LWECiphertext> EvalFuncBatch(const std::vector<LWECiphertext>& ct,
+                                             const std::vector<NativeInteger>& LUT) const;
+
     /**
    * Generate the LUT for the to-be-evaluated function
    *
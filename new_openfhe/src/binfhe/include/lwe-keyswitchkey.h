@@ -45,50 +45,145 @@
 namespace lbcrypto {
 /**
  * @brief Class that stores the LWE scheme switching key
+ *
+ * The key is kept in two flat vectors. Row ((i * digitCount + j) * baseKS + v) holds the encryption of
+ * v * baseKS^j * skN[i]: its n-element "a" part starts at the row index times n in the "a" vector, and its "b"
+ * part is at the row index in the "b" vector. Key switching then reads every key row from one contiguous block.
  */
 class LWESwitchingKeyImpl : public Serializable {
 public:
     LWESwitchingKeyImpl() = default;
 
     explicit LWESwitchingKeyImpl(const std::vector<std::vector<std::vector<NativeVector>>>& keyA,
-                                 const std::vector<std::vector<std::vector<NativeInteger>>>& keyB)
-        : m_keyA(keyA), m_keyB(keyB) {}
+                                 const std::vector<std::vector<std::vector<NativeInteger>>>& keyB) {
+        SetElementsA(keyA);
+        SetElementsB(keyB);
+    }
 
-    LWESwitchingKeyImpl(const LWESwitchingKeyImpl& rhs) : m_keyA(rhs.m_keyA), m_keyB(rhs.m_keyB) {}
+    /**
+   * @param keyA the flat "a" parts, N * digitCount * baseKS rows of n elements
+   * @param keyB the flat "b" parts, N * digitCount * baseKS elements
+   * @param N the dimension of the input ciphertexts
+   * @param baseKS the base of the digit decomposition
+   * @param digitCount the number of digits
+   */
+    LWESwitchingKeyImpl(NativeVector&& keyA, NativeVector&& keyB, uint32_t N, uint32_t baseKS, uint32_t digitCount)
+        : m_keyA(std::move(keyA)), m_keyB(std::move(keyB)), m_N(N), m_baseKS(baseKS), m_digitCount(digitCount) {}
+
+    LWESwitchingKeyImpl(const LWESwitchingKeyImpl& rhs) = default;
+
+    LWESwitchingKeyImpl(LWESwitchingKeyImpl&& rhs) noexcept = default;
+
+    LWESwitchingKeyImpl& operator=(const LWESwitchingKeyImpl& rhs) = default;
+
+    LWESwitchingKeyImpl& operator=(LWESwitchingKeyImpl&& rhs) noexcept = default;
+
+    /**
+   * @return the "a" parts unpacked as [N][baseKS][digitCount] vectors; this is a copy of the key
+   */
+    std::vector<std::vector<std::vector<NativeVector>>> GetElementsA() const {
+        uint32_t n{Getn()};
+        std::vector<std::vector<std::vector<NativeVector>>> keyA(
+            m_N, std::vector<std::vector<NativeVector>>(m_baseKS, std::vector<NativeVector>(m_digitCount)));
+        for (uint32_t i = 0; i < m_N; ++i) {
+            for (uint32_t v = 0; v < m_baseKS; ++v) {
+                for (uint32_t j = 0; j < m_digitCount; ++j) {
+                    NativeVector a(n, m_keyA.GetModulus());
+                    size_t row{GetRow(i, j, v) * n};
+                    for (uint32_t k = 0; k < n; ++k)
+                        a[k] = m_keyA[row + k];
+                    keyA[i][v][j] = std::move(a);
+                }
+            }
+        }
+        return keyA;
+    }
 
-    LWESwitchingKeyImpl(LWESwitchingKeyImpl&& rhs) noexcept
-        : m_keyA(std::move(rhs.m_keyA)), m_keyB(std::move(rhs.m_keyB)) {}
+    /**
+   * @return the "b" parts unpacked as [N][baseKS][digitCount] values; this is a copy of the key
+   */
+    std::vector<std::vector<std::vector<NativeInteger>>> GetElementsB() const {
+        std::vector<std::vector<std::vector<NativeInteger>>> keyB(
+            m_N, std::vector<std::vector<NativeInteger>>(m_baseKS, std::vector<NativeInteger>(m_digitCount)));
+        for (uint32_t i = 0; i < m_N; ++i) {
+            for (uint32_t v = 0; v < m_baseKS; ++v) {
+                for (uint32_t j = 0; j < m_digitCount; ++j)
+                    keyB[i][v][j] = m_keyB[GetRow(i, j, v)];
+            }
+        }
+        return keyB;
+    }
 
-    LWESwitchingKeyImpl& operator=(const LWESwitchingKeyImpl& rhs) {
-        m_keyA = rhs.m_keyA;
-        m_keyB = rhs.m_keyB;
-        return *this;
+    void SetElementsA(const std::vector<std::vector<std::vector<NativeVector>>>& keyA) {
+        SetDimensions(keyA);
+        if (keyA.empty() || keyA[0].empty() || keyA[0][0].empty()) {
+            m_keyA = NativeVector();
+            return;
+        }
+        size_t n{keyA[0][0][0].GetLength()};
+        m_keyA = NativeVector(static_cast<size_t>(m_N) * m_baseKS * m_digitCount * n, keyA[0][0][0].GetModulus());
+        for (uint32_t i = 0; i < m_N; ++i) {
+            for (uint32_t v = 0; v < m_baseKS; ++v) {
+                for (uint32_t j = 0; j < m_digitCount; ++j) {
+                    size_t row{GetRow(i, j, v) * n};
+                    for (size_t k = 0; k < n; ++k)
+                        m_keyA[row + k] = keyA[i][v][j][k];
+                }
+            }
+        }
     }
 
-    LWESwitchingKeyImpl& operator=(LWESwitchingKeyImpl&& rhs) noexcept {
-        m_keyA = std::move(rhs.m_keyA);
-        m_keyB = std::move(rhs.m_keyB);
-        return *this;
+    void SetElementsB(const std::vector<std::vector<std::vector<NativeInteger>>>& keyB) {
+        SetDimensions(keyB);
+        m_keyB = NativeVector(static_cast<size_t>(m_N) * m_baseKS * m_digitCount, m_keyA.GetModulus());
+        for (uint32_t i = 0; i < m_N; ++i) {
+            for (uint32_t v = 0; v < m_baseKS; ++v) {
+                for (uint32_t j = 0; j < m_digitCount; ++j)
+                    m_keyB[GetRow(i, j, v)] = keyB[i][v][j];
+            }
+        }
     }
 
-    const std::vector<std::vector<std::vector<NativeVector>>>& GetElementsA() const {
+    /**
+   * @return the flat "a" parts; see the class description for the layout
+   */
+    const NativeVector& GetFlatElementsA() const {
         return m_keyA;
     }
 
-    const std::vector<std::vector<std::vector<NativeInteger>>>& GetElementsB() const {
+    /**
+   * @return the flat "b" parts; see the class description for the layout
+   */
+    const NativeVector& GetFlatElementsB() const {
         return m_keyB;
     }
 
-    void SetElementsA(const std::vector<std::vector<std::vector<NativeVector>>>& keyA) {
-        m_keyA = keyA;
+    /**
+   * @return the index of the key row for coefficient i, digit j and digit value v
+   */
+    size_t GetRow(uint32_t i, uint32_t j, uint32_t v) const {
+        return (static_cast<size_t>(i) * m_digitCount + j) * m_baseKS + v;
     }
 
-    void SetElementsB(const std::vector<std::vector<std::vector<NativeInteger>>>& keyB) {
-        m_keyB = keyB;
+    uint32_t GetN() const {
+        return m_N;
+    }
+
+    uint32_t Getn() const {
+        return m_keyB.GetLength() == 0 ? 0 : static_cast<uint32_t>(m_keyA.GetLength() / m_keyB.GetLength());
+    }
+
+    uint32_t GetBaseKS() const {
+        return m_baseKS;
+    }
+
+    uint32_t GetDigitCount() const {
+        return m_digitCount;
     }
 
     bool operator==(const LWESwitchingKeyImpl& other) const {
-        return (m_keyA == other.m_keyA && m_keyB == other.m_keyB);
+        return (m_N == other.m_N && m_baseKS == other.m_baseKS && m_digitCount == other.m_digitCount &&
+                m_keyA == other.m_keyA && m_keyB == other.m_keyB);
     }
 
     bool operator!=(const LWESwitchingKeyImpl& other) const {
@@ -99,6 +194,7 @@ public:
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::make_nvp("a", m_keyA));
         ar(::cereal::make_nvp("b", m_keyB));
+        ar(::cereal::make_nvp("d", std::vector<uint32_t>{m_N, m_baseKS, m_digitCount}));
     }
 
     template <class Archive>
@@ -108,20 +204,50 @@ public:
                                                  " is from a later version of the library");
         }
 
+        // version 1 stored the key as nested vectors
+        if (version < 2) {
+            std::vector<std::vector<std::vector<NativeVector>>> keyA;
+            std::vector<std::vector<std::vector<NativeInteger>>> keyB;
+            ar(::cereal::make_nvp("a", keyA));
+            ar(::cereal::make_nvp("b", keyB));
+            SetElementsA(keyA);
+            SetElementsB(keyB);
+            return;
+        }
+
         ar(::cereal::make_nvp("a", m_keyA));
         ar(::cereal::make_nvp("b", m_keyB));
+        std::vector<uint32_t> dims;
+        ar(::cereal::make_nvp("d", dims));
+        if (dims.size() != 3 ||
+            static_cast<size_t>(dims[0]) * dims[1] * dims[2] != static_cast<size_t>(m_keyB.GetLength()) ||
+            (m_keyB.GetLength() != 0 && m_keyA.GetLength() % m_keyB.GetLength() != 0))
+            OPENFHE_THROW(deserialize_error, "the switching key dimensions do not match its elements");
+        m_N          = dims[0];
+        m_baseKS     = dims[1];
+        m_digitCount = dims[2];
     }
 
     std::string SerializedObjectName() const override {
         return "LWEPrivateKey";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
-    std::vector<std::vector<std::vector<NativeVector>>> m_keyA;
-    std::vector<std::vector<std::vector<NativeInteger>>> m_keyB;
+    template <typename T>
+    void SetDimensions(const std::vector<std::vector<std::vector<T>>>& key) {
+        m_N          = static_cast<uint32_t>(key.size());
+        m_baseKS     = key.empty() ? 0 : static_cast<uint32_t>(key[0].size());
+        m_digitCount = (key.empty() || key[0].empty()) ? 0 : static_cast<uint32_t>(key[0][0].size());
+    }
+
+    NativeVector m_keyA;
+    NativeVector m_keyB;
+    uint32_t m_N{0};
+    uint32_t m_baseKS{0};
+    uint32_t m_digitCount{0};
 };
 
 }  // namespace lbcrypto
@@ -41,6 +41,7 @@
 #include "lwe-cryptoparameters.h"
 
 #include <memory>
+#include <vector>
 
 namespace lbcrypto {
 
@@ -50,6 +51,17 @@ namespace lbcrypto {
 class LWEEncryptionScheme {
     NativeInteger RoundqQ(const NativeInteger& v, const NativeInteger& q, const NativeInteger& Q) const;
 
+    // Finds the key row of every digit of the "a" coefficients of ctQN
+    void KeySwitchRows(const LWESwitchingKeyImpl& K, ConstLWECiphertext& ctQN, std::vector<size_t>& rows) const;
+
+    // Key switches the ciphertexts first, first + step, ... together, so that their rows of a digit are read
+    // while the neighbouring rows are still cached
+    void KeySwitchSlice(const LWESwitchingKeyImpl& K, const std::vector<std::shared_ptr<const LWECiphertextImpl>>& ctQN,
+                        size_t first, size_t step, std::vector<LWECiphertext>& result) const;
+
+    // Throws if the switching key was generated for other LWE parameters
+    void CheckSwitchingKey(const std::shared_ptr<LWECryptoParams>& params, ConstLWESwitchingKey& K) const;
+
 public:
     LWEEncryptionScheme() = default;
 
@@ -215,6 +227,18 @@ public:
     LWECiphertext KeySwitch(const std::shared_ptr<LWECryptoParams>& params, ConstLWESwitchingKey& K,
                             ConstLWECiphertext& ctQN) const;
 
+    /**
+   * Switches independent ciphertexts from (Q,N) to (Q,n) as one batch; the ciphertexts
+   * share the reads of the switching key rows
+   *
+   * @param params a shared pointer to LWE scheme parameters
+   * @param K switching key
+   * @param ctQN input ciphertexts
+   * @return the resulting ciphertexts, in the order of the inputs
+   */
+    std::vector<LWECiphertext> KeySwitch(const std::shared_ptr<LWECryptoParams>& params, ConstLWESwitchingKey& K,
+                                         const std::vector<LWECiphertext>& ctQN) const;
+
     /**
    * Embeds a plaintext bit without noise or encryption
    *
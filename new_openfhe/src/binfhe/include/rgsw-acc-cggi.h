@@ -35,6 +35,7 @@
 #include "rgsw-acc.h"
 
 #include <memory>
+#include <vector>
 
 namespace lbcrypto {
 
@@ -68,6 +69,18 @@ public:
     void EvalAcc(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWACCKey& ek, RLWECiphertext& acc,
                  const NativeVector& a) const override;
 
+    /**
+   * Accumulator function for a batch of independent bootstrappings - GINX variant. Each thread updates a
+   * slice of the accumulators key by key, so every bootstrapping key is read once per slice.
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param ek the accumulator key
+   * @param acc previous values of the accumulators
+   * @param a values to update the accumulators with, one per accumulator
+   */
+    void EvalAccBatch(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWACCKey& ek,
+                      std::vector<RLWECiphertext>& acc, const std::vector<NativeVector>& a) const override;
+
 private:
     /**
    * Key generation for internal Ring GSW as described in https://eprint.iacr.org/2020/086
@@ -75,6 +75,18 @@ public:
         OPENFHE_THROW(not_implemented_error, "ACC operation not supported");
     }
 
+    /**
+   * Main accumulator function for a batch of independent bootstrappings. By default the
+   * accumulators are updated in parallel, one EvalAcc call each.
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param ek the accumulator key
+   * @param acc previous values of the accumulators
+   * @param a values to update the accumulators with, one per accumulator
+   */
+    virtual void EvalAccBatch(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWACCKey& ek,
+                              std::vector<RLWECiphertext>& acc, const std::vector<NativeVector>& a) const;
+
     /**
    * The signed digit decomposition which takes an RLWE ciphertext input and outputs a vector of its digits, i.e., an
    * RLWE' ciphertext
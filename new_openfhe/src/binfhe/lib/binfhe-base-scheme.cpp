@@ -100,26 +100,68 @@ LWECiphertext BinFHEScheme::EvalBinGate(const std::shared_ptr<BinFHECryptoParams
 
     auto acc{BootstrapGateCore(params, gate, EK.BSkey, ctprep)};
 
-    // the accumulator result is encrypted w.r.t. the transposed secret key
-    // we can transpose "a" to get an encryption under the original secret key
-    std::vector<NativePoly>& accVec{acc->GetElements()};
-    accVec[0] = accVec[0].Transpose();
-    accVec[0].SetFormat(Format::COEFFICIENT);
-    accVec[1].SetFormat(Format::COEFFICIENT);
-
     // we add Q/8 to "b" to to map back to Q/4 (i.e., mod 2) arithmetic.
-    const auto& LWEParams = params->GetLWEParams();
-    NativeInteger Q{LWEParams->GetQ()};
-    NativeInteger b{(Q >> 3) + 1};
-    b.ModAddFastEq(accVec[1][0], Q);
+    NativeInteger Q{params->GetLWEParams()->GetQ()};
+    return ExtractACC(params, EK, acc, (Q >> 3) + 1, ct1->GetModulus());
+}
 
-    auto ctExt = std::make_shared<LWECiphertextImpl>(std::move(accVec[0].GetValues()), std::move(b));
-    // Modulus switching to a middle step Q'
-    auto ctMS = LWEscheme->ModSwitch(LWEParams->GetqKS(), ctExt);
-    // Key switching
-    auto ctKS = LWEscheme->KeySwitch(LWEParams, EK.KSkey, ctMS);
-    // Modulus switching
-    return LWEscheme->ModSwitch(ct1->GetModulus(), ctKS);
+// Batched evaluation of independent gates; the blind rotations share the reads of the bootstrapping keys
+std::vector<LWECiphertext> BinFHEScheme::EvalBinGateBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                          BINGATE gate, const RingGSWBTKey& EK,
+                                                          const std::vector<LWECiphertext>& ct1,
+                                                          const std::vector<LWECiphertext>& ct2) const {
+    if (ct1.size() != ct2.size())
+        OPENFHE_THROW(config_error, "Input ciphertext vectors should have the same size");
+    for (size_t i = 0; i < ct1.size(); ++i) {
+        if (ct1[i] == ct2[i])
+            OPENFHE_THROW(config_error, "Input ciphertexts should be independant");
+    }
+    size_t k{ct1.size()};
+    if (k == 0)
+        return {};
+
+    // XOR/XNOR are computed using a combination of AND, OR, and NOT gates; both ANDs run as one batch
+    if ((gate == XOR) || (gate == XNOR)) {
+        std::vector<LWECiphertext> lhs(2 * k);
+        std::vector<LWECiphertext> rhs(2 * k);
+        for (size_t i = 0; i < k; ++i) {
+            lhs[i]     = ct1[i];
+            rhs[i]     = EvalNOT(params, ct2[i]);
+            lhs[k + i] = EvalNOT(params, ct1[i]);
+            rhs[k + i] = ct2[i];
+        }
+        auto ctAND = EvalBinGateBatch(params, AND, EK, lhs, rhs);
+        std::vector<LWECiphertext> ctAND1(ctAND.begin(), ctAND.begin() + k);
+        std::vector<LWECiphertext> ctAND2(ctAND.begin() + k, ctAND.end());
+        auto ctOR = EvalBinGateBatch(params, OR, EK, ctAND1, ctAND2);
+        if (gate == XNOR) {
+            for (auto& ct : ctOR)
+                ct = EvalNOT(params, ct);
+        }
+        return ctOR;
+    }
+
+    std::vector<LWECiphertext> ctprep(k);
+    for (size_t i = 0; i < k; ++i) {
+        ctprep[i] = std::make_shared<LWECiphertextImpl>(*ct1[i]);
+        if ((gate == XOR_FAST) || (gate == XNOR_FAST)) {
+            LWEscheme->EvalSubEq(ctprep[i], ct2[i]);
+            LWEscheme->EvalAddEq(ctprep[i], ctprep[i]);
+        }
+        else {
+            LWEscheme->EvalAddEq(ctprep[i], ct2[i]);
+        }
+    }
+
+    auto acc{BootstrapGateCoreBatch(params, gate, EK.BSkey, ctprep)};
+
+    // we add Q/8 to "b" to to map back to Q/4 (i.e., mod 2) arithmetic.
+    NativeInteger Q{params->GetLWEParams()->GetQ()};
+    std::vector<NativeInteger> b0(k, (Q >> 3) + 1);
+    std::vector<NativeInteger> mod(k);
+    for (size_t i = 0; i < k; ++i)
+        mod[i] = ct1[i]->GetModulus();
+    return ExtractACCBatch(params, EK, acc, b0, mod);
 }
 
 // Full evaluation as described in https://eprint.iacr.org/2020/086
@@ -145,26 +187,9 @@ LWECiphertext BinFHEScheme::EvalBinGate(const std::shared_ptr<BinFHECryptoParams
         }
         auto acc = BootstrapGateCore(params, gate, EK.BSkey, ctprep);
 
-        std::vector<NativePoly>& accVec = acc->GetElements();
-        // the accumulator result is encrypted w.r.t. the transposed secret key
-        // we can transpose "a" to get an encryption under the original secret key
-        accVec[0] = accVec[0].Transpose();
-        accVec[0].SetFormat(Format::COEFFICIENT);
-        accVec[1].SetFormat(Format::COEFFICIENT);
-
         // we add Q/8 to "b" to to map back to Q/4 (i.e., mod 2) arithmetic.
-        auto& LWEParams = params->GetLWEParams();
-        NativeInteger Q = LWEParams->GetQ();
-        NativeInteger b = Q / NativeInteger(2 * p) + 1;
-        b.ModAddFastEq(accVec[1][0], Q);
-
-        auto ctExt = std::make_shared<LWECiphertextImpl>(std::move(accVec[0].GetValues()), std::move(b));
-        // Modulus switching to a middle step Q'
-        auto ctMS = LWEscheme->ModSwitch(LWEParams->GetqKS(), ctExt);
-        // Key switching
-        auto ctKS = LWEscheme->KeySwitch(LWEParams, EK.KSkey, ctMS);
-        // Modulus switching
-        return LWEscheme->ModSwitch(ctvector[0]->GetModulus(), ctKS);
+        NativeInteger Q = params->GetLWEParams()->GetQ();
+        return ExtractACC(params, EK, acc, Q / NativeInteger(2 * p) + 1, ctvector[0]->GetModulus());
     }
     else if (gate == CMUX) {
         if (ctvector.size() != 3)
@@ -190,26 +215,37 @@ LWECiphertext BinFHEScheme::Bootstrap(const std::shared_ptr<BinFHECryptoParams>&
 
     auto acc{BootstrapGateCore(params, AND, EK.BSkey, ctprep)};
 
-    // the accumulator result is encrypted w.r.t. the transposed secret key
-    // we can transpose "a" to get an encryption under the original secret key
-    std::vector<NativePoly>& accVec{acc->GetElements()};
-    accVec[0] = accVec[0].Transpose();
-    accVec[0].SetFormat(Format::COEFFICIENT);
-    accVec[1].SetFormat(Format::COEFFICIENT);
-
     // we add Q/8 to "b" to to map back to Q/4 (i.e., mod 2) arithmetic.
-    const auto& LWEParams = params->GetLWEParams();
-    NativeInteger Q{LWEParams->GetQ()};
-    NativeInteger b = Q / NativeInteger(2 * p) + 1;
-    b.ModAddFastEq(accVec[1][0], Q);
+    NativeInteger Q{params->GetLWEParams()->GetQ()};
+    return ExtractACC(params, EK, acc, Q / NativeInteger(2 * p) + 1, ct->GetModulus());
+}
 
-    auto ctExt = std::make_shared<LWECiphertextImpl>(std::move(accVec[0].GetValues()), std::move(b));
-    // Modulus switching to a middle step Q'
-    auto ctMS = LWEscheme->ModSwitch(LWEParams->GetqKS(), ctExt);
-    // Key switching
-    auto ctKS = LWEscheme->KeySwitch(LWEParams, EK.KSkey, ctMS);
-    // Modulus switching
-    return LWEscheme->ModSwitch(ct->GetModulus(), ctKS);
+// Batched bootstrapping of independent ciphertexts
+std::vector<LWECiphertext> BinFHEScheme::BootstrapBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                        const RingGSWBTKey& EK,
+                                                        const std::vector<LWECiphertext>& ct) const {
+    size_t k{ct.size()};
+    if (k == 0)
+        return {};
+
+    std::vector<LWECiphertext> ctprep(k);
+    for (size_t i = 0; i < k; ++i) {
+        // ctprep = ct + q/4
+        ctprep[i] = std::make_shared<LWECiphertextImpl>(*ct[i]);
+        LWEscheme->EvalAddConstEq(ctprep[i], (ct[i]->GetModulus() >> 2));
+    }
+
+    auto acc{BootstrapGateCoreBatch(params, AND, EK.BSkey, ctprep)};
+
+    // we add Q/8 to "b" to to map back to Q/4 (i.e., mod 2) arithmetic.
+    NativeInteger Q{params->GetLWEParams()->GetQ()};
+    std::vector<NativeInteger> b0(k);
+    std::vector<NativeInteger> mod(k);
+    for (size_t i = 0; i < k; ++i) {
+        b0[i]  = Q / NativeInteger(2 * ct[i]->GetptModulus()) + 1;
+        mod[i] = ct[i]->GetModulus();
+    }
+    return ExtractACCBatch(params, EK, acc, b0, mod);
 }
 
 // Evaluation of the NOT operation; no key material is needed
@@ -229,18 +265,46 @@ LWECiphertext BinFHEScheme::EvalNOT(const std::shared_ptr<BinFHECryptoParams>& p
 LWECiphertext BinFHEScheme::EvalFunc(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
                                      ConstLWECiphertext& ct, const std::vector<NativeInteger>& LUT,
                                      const NativeInteger& beta) const {
-    auto ct1 = std::make_shared<LWECiphertextImpl>(*ct);
-    NativeInteger q{ct->GetModulus()};
+    return EvalFuncBatch(params, EK, {std::make_shared<LWECiphertextImpl>(*ct)}, LUT, beta)[0];
+}
+
+// Evaluate Arbitrary Function homomorphically on independent ciphertexts
+// Modulus of ct is q | 2N
+std::vector<LWECiphertext> BinFHEScheme::EvalFuncBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                       const RingGSWBTKey& EK, const std::vector<LWECiphertext>& ct,
+                                                       const std::vector<NativeInteger>& LUT,
+                                                       const NativeInteger& beta) const {
+    size_t k{ct.size()};
+    if (k == 0)
+        return {};
+    NativeInteger q{ct[0]->GetModulus()};
+    for (size_t i = 1; i < k; ++i) {
+        if (ct[i]->GetModulus() != q)
+            OPENFHE_THROW(config_error, "Input ciphertexts should have the same modulus");
+    }
     uint32_t functionProperty{this->checkInputFunction(LUT, q)};
 
+    std::vector<LWECiphertext> ct1(k);
+    for (size_t i = 0; i < k; ++i)
+        ct1[i] = std::make_shared<LWECiphertextImpl>(*ct[i]);
+
     if (functionProperty == 0) {  // negacyclic function only needs one bootstrap
         auto fLUT = [LUT](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
             return LUT[x.ConvertToInt()];
         };
-        LWEscheme->EvalAddConstEq(ct1, beta);
-        return BootstrapFunc(params, EK, ct1, fLUT, q);
+        for (auto& c : ct1)
+            LWEscheme->EvalAddConstEq(c, beta);
+        return BootstrapFuncBatch(params, EK, ct1, fLUT, q);
     }
 
+    // this is 1/4q_small or -1/4q_small mod q
+    auto f0 = [](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
+        if (x < (q >> 1))
+            return Q - (q >> 2);
+        else
+            return (q >> 2);
+    };
+
     if (functionProperty == 2) {  // arbitary funciton
         const auto& LWEParams = params->GetLWEParams();
         uint32_t N{LWEParams->GetN()};
@@ -257,22 +321,19 @@ LWECiphertext BinFHEScheme::EvalFunc(const std::shared_ptr<BinFHECryptoParams>&
         LUT2.insert(LUT2.end(), LUT.begin(), LUT.end());
 
         NativeInteger dq{q << 1};
-        // raise the modulus of ct1 : q -> 2q
-        ct1->GetA().SetModulus(dq);
-
-        auto ct2 = std::make_shared<LWECiphertextImpl>(*ct1);
-        LWEscheme->EvalAddConstEq(ct2, beta);
-        // this is 1/4q_small or -1/4q_small mod q
-        auto f0 = [](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
-            if (x < (q >> 1))
-                return Q - (q >> 2);
-            else
-                return (q >> 2);
-        };
-        auto ct3 = BootstrapFunc(params, EK, ct2, f0, dq);
-        LWEscheme->EvalSubEq2(ct1, ct3);
-        LWEscheme->EvalAddConstEq(ct3, beta);
-        LWEscheme->EvalSubConstEq(ct3, q >> 1);
+        std::vector<LWECiphertext> ct2(k);
+        for (size_t i = 0; i < k; ++i) {
+            // raise the modulus of ct1 : q -> 2q
+            ct1[i]->GetA().SetModulus(dq);
+            ct2[i] = std::make_shared<LWECiphertextImpl>(*ct1[i]);
+            LWEscheme->EvalAddConstEq(ct2[i], beta);
+        }
+        auto ct3 = BootstrapFuncBatch(params, EK, ct2, f0, dq);
+        for (size_t i = 0; i < k; ++i) {
+            LWEscheme->EvalSubEq2(ct1[i], ct3[i]);
+            LWEscheme->EvalAddConstEq(ct3[i], beta);
+            LWEscheme->EvalSubConstEq(ct3[i], q >> 1);
+        }
 
         // Now the input is within the range [0, q/2).
         // Note that for non-periodic function, the input q is boosted up to 2q
@@ -282,24 +343,21 @@ LWECiphertext BinFHEScheme::EvalFunc(const std::shared_ptr<BinFHECryptoParams>&
             else
                 return Q - LUT2[x.ConvertToInt() - q.ConvertToInt() / 2];
         };
-        auto ct4 = BootstrapFunc(params, EK, ct3, fLUT2, dq);
-        ct4->SetModulus(q);
+        auto ct4 = BootstrapFuncBatch(params, EK, ct3, fLUT2, dq);
+        for (auto& c : ct4)
+            c->SetModulus(q);
         return ct4;
     }
 
     // Else it's periodic function so we evaluate directly
-    LWEscheme->EvalAddConstEq(ct1, beta);
-    // this is 1/4q_small or -1/4q_small mod q
-    auto f0 = [](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
-        if (x < (q >> 1))
-            return Q - (q >> 2);
-        else
-            return (q >> 2);
-    };
-    auto ct2 = BootstrapFunc(params, EK, ct1, f0, q);
-    LWEscheme->EvalSubEq2(ct, ct2);
-    LWEscheme->EvalAddConstEq(ct2, beta);
-    LWEscheme->EvalSubConstEq(ct2, q >> 2);
+    for (auto& c : ct1)
+        LWEscheme->EvalAddConstEq(c, beta);
+    auto ct2 = BootstrapFuncBatch(params, EK, ct1, f0, q);
+    for (size_t i = 0; i < k; ++i) {
+        LWEscheme->EvalSubEq2(ct[i], ct2[i]);
+        LWEscheme->EvalAddConstEq(ct2[i], beta);
+        LWEscheme->EvalSubConstEq(ct2[i], q >> 2);
+    }
 
     // Now the input is within the range [0, q/2).
     // Note that for non-periodic function, the input q is boosted up to 2q
@@ -309,7 +367,7 @@ LWECiphertext BinFHEScheme::EvalFunc(const std::shared_ptr<BinFHECryptoParams>&
         else
             return Q - LUT[x.ConvertToInt() - q.ConvertToInt() / 2];
     };
-    return BootstrapFunc(params, EK, ct2, fLUT1, q);
+    return BootstrapFuncBatch(params, EK, ct2, fLUT1, q);
 }
 
 // Evaluate Homomorphic Flooring
@@ -490,15 +548,55 @@ std::vector<LWECiphertext> BinFHEScheme::EvalDecomp(const std::shared_ptr<BinFHE
 
 // private:
 
-RLWECiphertext BinFHEScheme::BootstrapGateCore(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
-                                               ConstRingGSWACCKey& ek, ConstLWECiphertext& ct) const {
-    if (ek == nullptr) {
-        std::string errMsg =
-            "Bootstrapping keys have not been generated. Please call BTKeyGen "
-            "before calling bootstrapping.";
-        OPENFHE_THROW(config_error, errMsg);
-    }
+LWECiphertext BinFHEScheme::ExtractACC(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
+                                       RLWECiphertext& acc, const NativeInteger& b0,
+                                       const NativeInteger& mod) const {
+    // Key switching
+    auto ctKS = LWEscheme->KeySwitch(params->GetLWEParams(), EK.KSkey, ExtractLWE(params, acc, b0));
+    // Modulus switching
+    return LWEscheme->ModSwitch(mod, ctKS);
+}
+
+std::vector<LWECiphertext> BinFHEScheme::ExtractACCBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                         const RingGSWBTKey& EK, std::vector<RLWECiphertext>& acc,
+                                                         const std::vector<NativeInteger>& b0,
+                                                         const std::vector<NativeInteger>& mod) const {
+    size_t k{acc.size()};
+    std::vector<LWECiphertext> ctMS(k);
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(k))
+    for (size_t i = 0; i < k; ++i)
+        ctMS[i] = ExtractLWE(params, acc[i], b0[i]);
+
+    // the key switchings of the batch share the reads of the switching key
+    auto ctKS = LWEscheme->KeySwitch(params->GetLWEParams(), EK.KSkey, ctMS);
+
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(k))
+    for (size_t i = 0; i < k; ++i)
+        ctKS[i] = LWEscheme->ModSwitch(mod[i], ctKS[i]);
+    return ctKS;
+}
 
+LWECiphertext BinFHEScheme::ExtractLWE(const std::shared_ptr<BinFHECryptoParams>& params, RLWECiphertext& acc,
+                                       const NativeInteger& b0) const {
+    // the accumulator result is encrypted w.r.t. the transposed secret key
+    // we can transpose "a" to get an encryption under the original secret key
+    std::vector<NativePoly>& accVec{acc->GetElements()};
+    accVec[0] = accVec[0].Transpose();
+    accVec[0].SetFormat(Format::COEFFICIENT);
+    accVec[1].SetFormat(Format::COEFFICIENT);
+
+    const auto& LWEParams = params->GetLWEParams();
+    NativeInteger Q{LWEParams->GetQ()};
+    NativeInteger b{b0};
+    b.ModAddFastEq(accVec[1][0], Q);
+
+    auto ctExt = std::make_shared<LWECiphertextImpl>(std::move(accVec[0].GetValues()), std::move(b));
+    // Modulus switching to a middle step Q'
+    return LWEscheme->ModSwitch(LWEParams->GetqKS(), ctExt);
+}
+
+RLWECiphertext BinFHEScheme::InitGateAcc(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
+                                         ConstLWECiphertext& ct) const {
     auto& LWEParams  = params->GetLWEParams();
     auto& RGSWParams = params->GetRingGSWParams();
     auto polyParams  = RGSWParams->GetPolyParams();
@@ -537,27 +635,56 @@ RLWECiphertext BinFHEScheme::BootstrapGateCore(const std::shared_ptr<BinFHECrypt
     res[1].SetValues(std::move(m), Format::COEFFICIENT);
     res[1].SetFormat(Format::EVALUATION);
 
+    return std::make_shared<RLWECiphertextImpl>(std::move(res));
+}
+
+RLWECiphertext BinFHEScheme::BootstrapGateCore(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
+                                               ConstRingGSWACCKey& ek, ConstLWECiphertext& ct) const {
+    if (ek == nullptr) {
+        std::string errMsg =
+            "Bootstrapping keys have not been generated. Please call BTKeyGen "
+            "before calling bootstrapping.";
+        OPENFHE_THROW(config_error, errMsg);
+    }
+
     // main accumulation computation
     // the following loop is the bottleneck of bootstrapping/binary gate
     // evaluation
-    auto acc = std::make_shared<RLWECiphertextImpl>(std::move(res));
-    ACCscheme->EvalAcc(RGSWParams, ek, acc, ct->GetA());
+    auto acc = InitGateAcc(params, gate, ct);
+    ACCscheme->EvalAcc(params->GetRingGSWParams(), ek, acc, ct->GetA());
     return acc;
 }
 
-// Functions below are for large-precision sign evaluation,
-// flooring, homomorphic digit decomposition, and arbitrary
-// funciton evaluation, from https://eprint.iacr.org/2021/1337
-template <typename Func>
-RLWECiphertext BinFHEScheme::BootstrapFuncCore(const std::shared_ptr<BinFHECryptoParams>& params,
-                                               ConstRingGSWACCKey& ek, ConstLWECiphertext& ct, const Func f,
-                                               const NativeInteger& fmod) const {
+std::vector<RLWECiphertext> BinFHEScheme::BootstrapGateCoreBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                                 BINGATE gate, ConstRingGSWACCKey& ek,
+                                                                 const std::vector<LWECiphertext>& ct) const {
     if (ek == nullptr) {
         std::string errMsg =
-            "Bootstrapping keys have not been generated. Please call BTKeyGen before calling bootstrapping.";
+            "Bootstrapping keys have not been generated. Please call BTKeyGen "
+            "before calling bootstrapping.";
         OPENFHE_THROW(config_error, errMsg);
     }
 
+    size_t k{ct.size()};
+    std::vector<RLWECiphertext> acc(k);
+    std::vector<NativeVector> a(k);
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(k))
+    for (size_t i = 0; i < k; ++i) {
+        acc[i] = InitGateAcc(params, gate, ct[i]);
+        a[i]   = ct[i]->GetA();
+    }
+
+    // all accumulators are advanced together so that each bootstrapping key is streamed once per batch
+    ACCscheme->EvalAccBatch(params->GetRingGSWParams(), ek, acc, a);
+    return acc;
+}
+
+// Functions below are for large-precision sign evaluation,
+// flooring, homomorphic digit decomposition, and arbitrary
+// funciton evaluation, from https://eprint.iacr.org/2021/1337
+template <typename Func>
+RLWECiphertext BinFHEScheme::InitFuncAcc(const std::shared_ptr<BinFHECryptoParams>& params, ConstLWECiphertext& ct,
+                                         const Func f, const NativeInteger& fmod) const {
     auto& LWEParams  = params->GetLWEParams();
     auto& RGSWParams = params->GetRingGSWParams();
     auto polyParams  = RGSWParams->GetPolyParams();
@@ -580,11 +707,24 @@ RLWECiphertext BinFHEScheme::BootstrapFuncCore(const std::shared_ptr<BinFHECrypt
     res[1].SetValues(std::move(m), Format::COEFFICIENT);
     res[1].SetFormat(Format::EVALUATION);
 
+    return std::make_shared<RLWECiphertextImpl>(std::move(res));
+}
+
+template <typename Func>
+RLWECiphertext BinFHEScheme::BootstrapFuncCore(const std::shared_ptr<BinFHECryptoParams>& params,
+                                               ConstRingGSWACCKey& ek, ConstLWECiphertext& ct, const Func f,
+                                               const NativeInteger& fmod) const {
+    if (ek == nullptr) {
+        std::string errMsg =
+            "Bootstrapping keys have not been generated. Please call BTKeyGen before calling bootstrapping.";
+        OPENFHE_THROW(config_error, errMsg);
+    }
+
     // main accumulation computation
     // the following loop is the bottleneck of bootstrapping/binary gate
     // evaluation
-    auto acc = std::make_shared<RLWECiphertextImpl>(std::move(res));
-    ACCscheme->EvalAcc(RGSWParams, ek, acc, ct->GetA());
+    auto acc = InitFuncAcc(params, ct, f, fmod);
+    ACCscheme->EvalAcc(params->GetRingGSWParams(), ek, acc, ct->GetA());
     return acc;
 }
 
@@ -593,22 +733,32 @@ template <typename Func>
 LWECiphertext BinFHEScheme::BootstrapFunc(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
                                           ConstLWECiphertext& ct, const Func f, const NativeInteger& fmod) const {
     auto acc = BootstrapFuncCore(params, EK.BSkey, ct, f, fmod);
+    return ExtractACC(params, EK, acc, NativeInteger(0), fmod);
+}
 
-    std::vector<NativePoly>& accVec = acc->GetElements();
-    // the accumulator result is encrypted w.r.t. the transposed secret key
-    // we can transpose "a" to get an encryption under the original secret key
-    accVec[0] = accVec[0].Transpose();
-    accVec[0].SetFormat(Format::COEFFICIENT);
-    accVec[1].SetFormat(Format::COEFFICIENT);
+// Batched counterpart of BootstrapFunc; the blind rotations share the reads of the bootstrapping keys
+template <typename Func>
+std::vector<LWECiphertext> BinFHEScheme::BootstrapFuncBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                            const RingGSWBTKey& EK,
+                                                            const std::vector<LWECiphertext>& ct, const Func f,
+                                                            const NativeInteger& fmod) const {
+    if (EK.BSkey == nullptr) {
+        std::string errMsg =
+            "Bootstrapping keys have not been generated. Please call BTKeyGen before calling bootstrapping.";
+        OPENFHE_THROW(config_error, errMsg);
+    }
 
-    auto ctExt      = std::make_shared<LWECiphertextImpl>(std::move(accVec[0].GetValues()), std::move(accVec[1][0]));
-    auto& LWEParams = params->GetLWEParams();
-    // Modulus switching to a middle step Q'
-    auto ctMS = LWEscheme->ModSwitch(LWEParams->GetqKS(), ctExt);
-    // Key switching
-    auto ctKS = LWEscheme->KeySwitch(LWEParams, EK.KSkey, ctMS);
-    // Modulus switching
-    return LWEscheme->ModSwitch(fmod, ctKS);
+    size_t k{ct.size()};
+    std::vector<RLWECiphertext> acc(k);
+    std::vector<NativeVector> a(k);
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(k))
+    for (size_t i = 0; i < k; ++i) {
+        acc[i] = InitFuncAcc(params, ct[i], f, fmod);
+        a[i]   = ct[i]->GetA();
+    }
+
+    ACCscheme->EvalAccBatch(params->GetRingGSWParams(), EK.BSkey, acc, a);
+    return ExtractACCBatch(params, EK, acc, std::vector<NativeInteger>(k), std::vector<NativeInteger>(k, fmod));
 }
 
 };  // namespace lbcrypto
@@ -306,10 +306,19 @@ LWECiphertext BinFHEContext::EvalBinGate(const BINGATE gate, const std::vector<L
     return m_binfhescheme->EvalBinGate(m_params, gate, m_BTKey, ctvector);
 }
 
+std::vector<LWECiphertext> BinFHEContext::EvalBinGateBatch(const BINGATE gate, const std::vector<LWECiphertext>& ct1,
+                                                           const std::vector<LWECiphertext>& ct2) const {
+    return m_binfhescheme->EvalBinGateBatch(m_params, gate, m_BTKey, ct1, ct2);
+}
+
 LWECiphertext BinFHEContext::Bootstrap(ConstLWECiphertext& ct) const {
     return m_binfhescheme->Bootstrap(m_params, m_BTKey, ct);
 }
 
+std::vector<LWECiphertext> BinFHEContext::BootstrapBatch(const std::vector<LWECiphertext>& ct) const {
+    return m_binfhescheme->BootstrapBatch(m_params, m_BTKey, ct);
+}
+
 LWECiphertext BinFHEContext::EvalNOT(ConstLWECiphertext& ct) const {
     return m_binfhescheme->EvalNOT(m_params, ct);
 }
@@ -322,6 +331,11 @@ LWECiphertext BinFHEContext::EvalFunc(ConstLWECiphertext& ct, const std::vector<
     return m_binfhescheme->EvalFunc(m_params, m_BTKey, ct, LUT, GetBeta());
 }
 
+std::vector<LWECiphertext> BinFHEContext::EvalFuncBatch(const std::vector<LWECiphertext>& ct,
+                                                        const std::vector<NativeInteger>& LUT) const {
+    return m_binfhescheme->EvalFuncBatch(m_params, m_BTKey, ct, LUT, GetBeta());
+}
+
 LWECiphertext BinFHEContext::EvalFloor(ConstLWECiphertext& ct, uint32_t roundbits) const {
     //    auto q = m_params->GetLWEParams()->Getq().ConvertToInt();
     //    if (roundbits != 0) {
@@ -35,6 +35,9 @@
 #include "math/discreteuniformgenerator.h"
 #include "math/ternaryuniformgenerator.h"
 
+#include <limits>
+#include <vector>
+
 namespace lbcrypto {
 // the main rounding operation used in ModSwitch (as described in Section 3 of
 // https://eprint.iacr.org/2014/816) The idea is that Round(x) = 0.5 + Floor(x)
@@ -326,8 +329,9 @@ LWESwitchingKey LWEEncryptionScheme::KeySwitchGen(const std::shared_ptr<LWECrypt
 
     NativeInteger mu(qKS.ComputeMu());
 
-    std::vector<std::vector<std::vector<NativeVector>>> resultVecA(N);
-    std::vector<std::vector<std::vector<NativeInteger>>> resultVecB(N);
+    // rows of the key are laid out as ((i * digitCount + k) * baseKS + j), see LWESwitchingKeyImpl
+    NativeVector resultVecA(N * digitCount * baseKS * n, qKS);
+    NativeVector resultVecB(N * digitCount * baseKS, qKS);
 
 // TODO (cpascoe/dsuponit): this pragma needs to be revised as it may have to be removed completely
 // #if !defined(__MINGW32__) && !defined(__MINGW64__)
@@ -335,19 +339,10 @@ LWESwitchingKey LWEEncryptionScheme::KeySwitchGen(const std::shared_ptr<LWECrypt
 // #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(N))
 // #endif
     for (size_t i = 0; i < N; ++i) {
-        std::vector<std::vector<NativeVector>> vector1A;
-        vector1A.reserve(baseKS);
-        std::vector<std::vector<NativeInteger>> vector1B;
-        vector1B.reserve(baseKS);
-
         for (size_t j = 0; j < baseKS; ++j) {
-            std::vector<NativeVector> vector2A;
-            vector2A.reserve(digitCount);
-            std::vector<NativeInteger> vector2B;
-            vector2B.reserve(digitCount);
             for (size_t k = 0; k < digitCount; ++k) {
-                vector2A.emplace_back(dug.GenerateVector(n));
-                NativeVector& a = vector2A.back();
+                size_t row{(i * digitCount + k) * baseKS + j};
+                NativeVector a = dug.GenerateVector(n);
                 NativeInteger b =
                     (params->GetDggKS().GenerateInteger(qKS)).ModAdd(svN[i].ModMul(j * digitsKS[k], qKS), qKS);
 #if NATIVEINT == 32
@@ -360,43 +355,136 @@ LWESwitchingKey LWEEncryptionScheme::KeySwitchGen(const std::shared_ptr<LWECrypt
                 }
                 b.ModEq(qKS);
 #endif
-                vector2B.emplace_back(b);
+                for (size_t l = 0; l < n; ++l)
+                    resultVecA[row * n + l] = a[l];
+                resultVecB[row] = b;
             }
-            vector1A.push_back(std::move(vector2A));
-            vector1B.push_back(std::move(vector2B));
         }
-        resultVecA[i] = std::move(vector1A);
-        resultVecB[i] = std::move(vector1B);
     }
-    return std::make_shared<LWESwitchingKeyImpl>(LWESwitchingKeyImpl(std::move(resultVecA), std::move(resultVecB)));
+    return std::make_shared<LWESwitchingKeyImpl>(std::move(resultVecA), std::move(resultVecB), N, baseKS, digitCount);
 }
 
 // the key switching operation as described in Section 3 of
 // https://eprint.iacr.org/2014/816
 LWECiphertext LWEEncryptionScheme::KeySwitch(const std::shared_ptr<LWECryptoParams>& params, ConstLWESwitchingKey& K,
                                              ConstLWECiphertext& ctQN) const {
-    const size_t n(params->Getn());
-    const size_t N(params->GetN());
-    NativeInteger Q(params->GetqKS());
-    NativeInteger::Integer baseKS(params->GetBaseKS());
-    const auto digitCount = static_cast<size_t>(std::ceil(log(Q.ConvertToDouble()) / log(static_cast<double>(baseKS))));
+    CheckSwitchingKey(params, K);
+    std::vector<LWECiphertext> result(1);
+    KeySwitchSlice(*K, {ctQN}, 0, 1, result);
+    return result[0];
+}
 
-    NativeVector a(n, Q);
-    NativeInteger b(ctQN->GetB());
-    for (size_t i = 0; i < N; ++i) {
-        auto& refA = K->GetElementsA()[i];
-        auto& refB = K->GetElementsB()[i];
+std::vector<LWECiphertext> LWEEncryptionScheme::KeySwitch(const std::shared_ptr<LWECryptoParams>& params,
+                                                          ConstLWESwitchingKey& K,
+                                                          const std::vector<LWECiphertext>& ctQN) const {
+    CheckSwitchingKey(params, K);
+    size_t k{ctQN.size()};
+    std::vector<LWECiphertext> result(k);
+    if (k == 0)
+        return result;
+
+    // each thread switches a slice of the ciphertexts, walking the key rows in order
+    std::vector<std::shared_ptr<const LWECiphertextImpl>> ct(ctQN.begin(), ctQN.end());
+    size_t slices = OpenFHEParallelControls.GetThreadLimit(k);
+#pragma omp parallel for num_threads(slices) schedule(static, 1)
+    for (size_t s = 0; s < slices; ++s)
+        KeySwitchSlice(*K, ct, s, slices, result);
+    return result;
+}
+
+void LWEEncryptionScheme::CheckSwitchingKey(const std::shared_ptr<LWECryptoParams>& params,
+                                            ConstLWESwitchingKey& K) const {
+    if (K->GetN() != params->GetN() || K->Getn() != params->Getn() || K->GetBaseKS() != params->GetBaseKS() ||
+        K->GetFlatElementsB().GetModulus() != params->GetqKS())
+        OPENFHE_THROW(config_error, "The switching key does not match the LWE parameters");
+}
+
+void LWEEncryptionScheme::KeySwitchRows(const LWESwitchingKeyImpl& K, ConstLWECiphertext& ctQN,
+                                        std::vector<size_t>& rows) const {
+    uint32_t N{K.GetN()};
+    uint32_t digitCount{K.GetDigitCount()};
+    NativeInteger::Integer baseKS{K.GetBaseKS()};
+    rows.resize(static_cast<size_t>(N) * digitCount);
+    if ((baseKS & (baseKS - 1)) == 0) {
+        // power-of-two base: the digits are read with shifts and masks
+        uint32_t shift{GetMSB(baseKS) - 1};
+        NativeInteger::Integer mask{baseKS - 1};
+        for (uint32_t i = 0; i < N; ++i) {
+            NativeInteger::Integer atmp(ctQN->GetA(i).ConvertToInt());
+            for (uint32_t j = 0; j < digitCount; ++j, atmp >>= shift)
+                rows[i * digitCount + j] = K.GetRow(i, j, static_cast<uint32_t>(atmp & mask));
+        }
+        return;
+    }
+    for (uint32_t i = 0; i < N; ++i) {
         NativeInteger::Integer atmp(ctQN->GetA(i).ConvertToInt());
-        for (size_t j = 0; j < digitCount; ++j) {
-            const auto a0 = (atmp % baseKS);
-            atmp /= baseKS;
-            b.ModSubFastEq(refB[a0][j], Q);
-            auto& refAj = refA[a0][j];
-            for (size_t k = 0; k < n; ++k)
-                a[k].ModSubFastEq(refAj[k], Q);
+        for (uint32_t j = 0; j < digitCount; ++j, atmp /= baseKS)
+            rows[i * digitCount + j] = K.GetRow(i, j, static_cast<uint32_t>(atmp % baseKS));
+    }
+}
+
+void LWEEncryptionScheme::KeySwitchSlice(const LWESwitchingKeyImpl& K,
+                                         const std::vector<std::shared_ptr<const LWECiphertextImpl>>& ctQN,
+                                         size_t first, size_t step, std::vector<LWECiphertext>& result) const {
+    const NativeVector& keyA{K.GetFlatElementsA()};
+    const NativeVector& keyB{K.GetFlatElementsB()};
+    const NativeInteger& Q{keyB.GetModulus()};
+    uint32_t n{K.Getn()};
+    size_t count{static_cast<size_t>(K.GetN()) * K.GetDigitCount()};
+
+    std::vector<size_t> items;
+    for (size_t c = first; c < ctQN.size(); c += step)
+        items.push_back(c);
+    std::vector<std::vector<size_t>> rows(items.size());
+    std::vector<NativeInteger> b(items.size());
+    for (size_t c = 0; c < items.size(); ++c) {
+        KeySwitchRows(K, ctQN[items[c]], rows[c]);
+        b[c] = ctQN[items[c]]->GetB();
+        for (size_t r = 0; r < count; ++r)
+            b[c].ModSubFastEq(keyB[rows[c][r]], Q);
+    }
+
+    std::vector<NativeVector> a(items.size(), NativeVector(n, Q));
+#if NATIVEINT == 64
+    static_assert(sizeof(NativeInteger) == sizeof(uint64_t), "the key rows are read as 64-bit words");
+    // the rows are summed without reduction; key values are below Q, so this many rows fit in 64 bits
+    const uint64_t q{Q.ConvertToInt()};
+    const size_t room{static_cast<size_t>(std::numeric_limits<uint64_t>::max() / q)};
+    const uint64_t* key{reinterpret_cast<const uint64_t*>(&keyA[0])};
+    std::vector<std::vector<uint64_t>> acc(items.size(), std::vector<uint64_t>(n, 0));
+    for (size_t r = 0, terms = 0; r < count; ++r, ++terms) {
+        if (terms == room) {
+            for (auto& z : acc) {
+                for (uint32_t l = 0; l < n; ++l)
+                    z[l] %= q;
+            }
+            // the reduced sums count as one more row
+            terms = 1;
+        }
+        for (size_t c = 0; c < items.size(); ++c) {
+            const uint64_t* row{key + rows[c][r] * n};
+            uint64_t* z{acc[c].data()};
+            for (uint32_t l = 0; l < n; ++l)
+                z[l] += row[l];
         }
     }
-    return std::make_shared<LWECiphertextImpl>(LWECiphertextImpl(std::move(a), b));
+    for (size_t c = 0; c < items.size(); ++c) {
+        for (uint32_t l = 0; l < n; ++l) {
+            uint64_t v{acc[c][l] % q};
+            a[c][l] = v == 0 ? 0 : q - v;
+        }
+    }
+#else
+    for (size_t r = 0; r < count; ++r) {
+        for (size_t c = 0; c < items.size(); ++c) {
+            size_t row{rows[c][r] * n};
+            for (uint32_t l = 0; l < n; ++l)
+                a[c][l].ModSubFastEq(keyA[row + l], Q);
+        }
+    }
+#endif
+    for (size_t c = 0; c < items.size(); ++c)
+        result[items[c]] = std::make_shared<LWECiphertextImpl>(std::move(a[c]), std::move(b[c]));
 }
 
 // noiseless LWE embedding
@@ -67,6 +67,28 @@ void RingGSWAccumulatorCGGI::EvalAcc(const std::shared_ptr<RingGSWCryptoParams>&
     }
 }
 
+void RingGSWAccumulatorCGGI::EvalAccBatch(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWACCKey& ek,
+                                          std::vector<RLWECiphertext>& acc, const std::vector<NativeVector>& a) const {
+    if (acc.empty())
+        return;
+    size_t n{a[0].GetLength()};
+    NativeInteger M{2 * params->GetN()};
+    uint32_t slices = OpenFHEParallelControls.GetThreadLimit(acc.size());
+    // the key loop is outside the loop over the accumulators of the slice
+#pragma omp parallel for num_threads(slices) schedule(static, 1)
+    for (uint32_t s = 0; s < slices; ++s) {
+        size_t begin{acc.size() * s / slices};
+        size_t end{acc.size() * (s + 1) / slices};
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = begin; j < end; ++j) {
+                auto mod{a[j].GetModulus()};
+                AddToAccCGGI(params, (*ek)[0][0][i], (*ek)[0][1][i],
+                             NativeInteger(0).ModSubFast(a[j][i], mod) * (M / mod), acc[j]);
+            }
+        }
+    }
+}
+
 // Encryption for the CGGI variant, as described in https://eprint.iacr.org/2020/086
 RingGSWEvalKey RingGSWAccumulatorCGGI::KeyGenCGGI(const std::shared_ptr<RingGSWCryptoParams>& params,
                                                   const NativePoly& skNTT, LWEPlaintext m) const {
@@ -76,6 +76,34 @@ void RingGSWAccumulatorDM::EvalAcc(const std::shared_ptr<RingGSWCryptoParams>& p
     }
 }
 
+void RingGSWAccumulatorDM::EvalAccBatch(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWACCKey& ek,
+                                        std::vector<RLWECiphertext>& acc, const std::vector<NativeVector>& a) const {
+    if (acc.empty())
+        return;
+    NativeInteger baseR{params->GetBaseR()};
+    auto q       = params->Getq();
+    auto digitsR = params->GetDigitsR().size();
+    uint32_t n   = a[0].GetLength();
+
+    uint32_t slices = OpenFHEParallelControls.GetThreadLimit(acc.size());
+    // the key loop is outside the loop over the accumulators of the slice
+#pragma omp parallel for num_threads(slices) schedule(static, 1)
+    for (uint32_t s = 0; s < slices; ++s) {
+        size_t begin{acc.size() * s / slices};
+        size_t end{acc.size() * (s + 1) / slices};
+        for (uint32_t i = 0; i < n; ++i) {
+            for (size_t j = begin; j < end; ++j) {
+                auto aI = NativeInteger(0).ModSubFast(a[j][i], q);
+                for (size_t k = 0; k < digitsR; ++k, aI /= baseR) {
+                    auto a0 = (aI.Mod(baseR)).ConvertToInt<uint32_t>();
+                    if (a0)
+                        AddToAccDM(params, (*ek)[i][a0][k], acc[j]);
+                }
+            }
+        }
+    }
+}
+
 // Encryption as described in Section 5 of https://eprint.iacr.org/2014/816
 // skNTT corresponds to the secret key z
 RingGSWEvalKey RingGSWAccumulatorDM::KeyGenDM(const std::shared_ptr<RingGSWCryptoParams>& params,
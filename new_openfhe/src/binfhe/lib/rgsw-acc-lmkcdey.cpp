@@ -64,6 +64,11 @@ RingGSWACCKey RingGSWAccumulatorLMKCDEY::KeyGenAcc(const std::shared_ptr<RingGSW
 #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(numAutoKeys))
     for (uint32_t i = 1; i <= numAutoKeys; ++i)
         (*ek)[0][1][i] = KeyGenAuto(params, skNTT, gen.ModExp(i, 2 * N).ConvertToInt<LWEPlaintext>());
+
+    // builds the maps of the automorphisms EvalAcc applies with these keys
+    GetAutoMap(N, 2 * N - gen.ConvertToInt());
+    for (uint32_t i = 1; i <= numAutoKeys; ++i)
+        GetAutoMap(N, gen.ModExp(i, 2 * N).ConvertToInt<uint32_t>());
     return ek;
 }
 
@@ -258,10 +263,9 @@ void RingGSWAccumulatorLMKCDEY::AddToAccLMKCDEY(const std::shared_ptr<RingGSWCry
 // Automorphism
 void RingGSWAccumulatorLMKCDEY::Automorphism(const std::shared_ptr<RingGSWCryptoParams>& params, const NativeInteger& a,
                                              ConstRingGSWEvalKey& ak, RLWECiphertext& acc) const {
-    // precompute bit reversal for the automorphism into vec
+    // bit reversal map of the automorphism, built at key generation
     uint32_t N{params->GetN()};
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, a.ConvertToInt<usint>(), &vec);
+    const std::vector<usint>& vec = GetAutoMap(N, a.ConvertToInt<usint>());
 
     acc->GetElements()[1] = acc->GetElements()[1].AutomorphismTransform(a.ConvertToInt<usint>(), vec);
 
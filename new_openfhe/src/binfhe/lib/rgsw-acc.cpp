@@ -51,6 +51,15 @@
 
 namespace lbcrypto {
 
+void RingGSWAccumulator::EvalAccBatch(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWACCKey& ek,
+                                      std::vector<RLWECiphertext>& acc, const std::vector<NativeVector>& a) const {
+    if (acc.empty())
+        return;
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(acc.size()))
+    for (size_t j = 0; j < acc.size(); ++j)
+        EvalAcc(params, ek, acc[j], a[j]);
+}
+
 void RingGSWAccumulator::SignedDigitDecompose(const std::shared_ptr<RingGSWCryptoParams>& params,
                                               const std::vector<NativePoly>& input,
                                               std::vector<NativePoly>& output) const {
@@ -61,6 +61,7 @@ enum TEST_CASE_TYPE {
     FHEW_OR4,
     FHEW_MAJORITY,
     FHEW_CMUX,
+    FHEW_BATCH,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -120,6 +121,9 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case FHEW_CMUX:
             typeName = "FHEW_CMUX";
             break;
+        case FHEW_BATCH:
+            typeName = "FHEW_BATCH";
+            break;
         default:
             typeName = "UNKNOWN_TESTTYPE";
             break;
@@ -240,6 +244,13 @@ static std::vector<TEST_CASE_UTGENERAL_FHEW> testCasesUTGENERAL_FHEW = {
     { FHEW_NOT, "01", TOY,      GINX,    2,                 4,        OR, {0, 1} },  // OR is not needed; added as a random value
     { FHEW_NOT, "02", TOY,      AP,      2,                 4,        OR, {0, 1} },  // OR is not needed; added as a random value
     { FHEW_NOT, "03", TOY,      LMKCDEY, 2,                 4,        OR, {0, 1} },  // OR is not needed; added as a random value
+    // ==========================================
+    { FHEW_BATCH, "01", TOY,      GINX,    2,               4,        AND,   {1, 0, 0, 0} },
+    { FHEW_BATCH, "02", TOY,      AP,      2,               4,        AND,   {1, 0, 0, 0} },
+    { FHEW_BATCH, "03", TOY,      LMKCDEY, 2,               4,        AND,   {1, 0, 0, 0} },
+    { FHEW_BATCH, "04", TOY,      GINX,    2,               4,        XOR,   {0, 1, 1, 0} },
+    { FHEW_BATCH, "05", TOY,      AP,      2,               4,        XNOR,  {1, 0, 0, 1} },
+    { FHEW_BATCH, "06", TOY,      LMKCDEY, 2,               4,        XOR_FAST, {0, 1, 1, 0} },
 };
 // clang-format on
 //===========================================================================================================
@@ -281,6 +292,16 @@ protected:
 
             EXPECT_EQ(testData.results[0], resultAfterKeySwitch1) << failed;
             EXPECT_EQ(testData.results[1], resultAfterKeySwitch0) << failed;
+
+            // the batched key switching gives the same ciphertexts
+            auto eQ = cc.GetLWEScheme()->KeySwitch(cc.GetParams()->GetLWEParams(), keySwitchHint, {ctQN1, ctQN0});
+            ASSERT_EQ(2U, eQ.size()) << failed;
+            EXPECT_EQ(*eQ1, *eQ[0]) << failed;
+            EXPECT_EQ(*eQ0, *eQ[1]) << failed;
+
+            // the nested view of the key round-trips through the flat layout
+            LWESwitchingKeyImpl nested(keySwitchHint->GetElementsA(), keySwitchHint->GetElementsB());
+            EXPECT_EQ(*keySwitchHint, nested) << failed;
         }
         catch (std::exception& e) {
             std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
@@ -548,6 +569,57 @@ protected:
             std::string name("EMSCRIPTEN_UNKNOWN");
 #else
             std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_FHEW_BATCH(const TEST_CASE_UTGENERAL_FHEW& testData, const std::string& failmsg = std::string()) {
+        try {
+            auto cc = BinFHEContext();
+            cc.GenerateBinFHEContext(testData.securityLevel, testData.method);
+
+            auto sk = cc.KeyGen();
+
+            cc.BTKeyGen(sk);
+
+            // inputs 11, 01, 10, 00 evaluated as one batch
+            std::vector<LWECiphertext> ct1{cc.Encrypt(sk, 1), cc.Encrypt(sk, 0), cc.Encrypt(sk, 1), cc.Encrypt(sk, 0)};
+            std::vector<LWECiphertext> ct2{cc.Encrypt(sk, 1), cc.Encrypt(sk, 1), cc.Encrypt(sk, 0), cc.Encrypt(sk, 0)};
+
+            auto ctGate = cc.EvalBinGateBatch(testData.gate, ct1, ct2);
+            auto ctBoot = cc.BootstrapBatch(ct1);
+
+            std::string failed = testData.toString() + " failed";
+
+            ASSERT_EQ(ct1.size(), ctGate.size()) << failed;
+            ASSERT_EQ(ct1.size(), ctBoot.size()) << failed;
+            for (size_t i = 0; i < ct1.size(); ++i) {
+                LWEPlaintext resultGate;
+                cc.Decrypt(sk, ctGate[i], &resultGate);
+                EXPECT_EQ(testData.results[i], resultGate) << failed;
+
+                LWEPlaintext resultBoot;
+                cc.Decrypt(sk, ctBoot[i], &resultBoot);
+                LWEPlaintext expected;
+                cc.Decrypt(sk, ct1[i], &expected);
+                EXPECT_EQ(expected, resultBoot) << failed;
+            }
+
+            EXPECT_TRUE(cc.EvalBinGateBatch(testData.gate, {}, {}).empty()) << failed;
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
 #endif
             std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
             // make it fail
@@ -591,6 +663,9 @@ TEST_P(UTGENERAL_FHEW, BINFHE) {
         case FHEW_NOT:
             UnitTest_FHEW_NOT(test, test.buildTestName());
             break;
+        case FHEW_BATCH:
+            UnitTest_FHEW_BATCH(test, test.buildTestName());
+            break;
         default:
             break;
     }
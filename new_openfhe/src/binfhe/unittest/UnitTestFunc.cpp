@@ -70,6 +70,37 @@ TEST(UnitTestFHEWGINX, EvalArbFunc) {
     }
 }
 
+// Checks the batched arbitrary function evaluation
+TEST(UnitTestFHEWGINX, EvalArbFuncBatch) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, true, 12);
+    auto sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+    int p   = cc.GetMaxPlaintextSpace().ConvertToInt();
+    auto fp = [](NativeInteger m, NativeInteger p1) -> NativeInteger {
+        if (m < p1)
+            return (m * m * m) % p1;
+        else
+            return ((m - p1 / 2) * (m - p1 / 2) * (m - p1 / 2)) % p1;
+    };
+    auto lut = cc.GenerateLUTviaFunction(fp, p);
+
+    std::vector<LWECiphertext> ct(p);
+    for (int i = 0; i < p; i++)
+        ct[i] = cc.Encrypt(sk, i % p, FRESH, p);
+
+    auto ct_cube = cc.EvalFuncBatch(ct, lut);
+    ASSERT_EQ(ct.size(), ct_cube.size());
+
+    for (int i = 0; i < p; i++) {
+        LWEPlaintext result;
+
+        cc.Decrypt(sk, ct_cube[i], &result, p);
+        std::string failed = "Batched Arbitrary Function Evaluation failed";
+        EXPECT_EQ(usint(fp(i, p).ConvertToInt()), result) << failed;
+    }
+}
+
 // Checks the rounding down evaluation
 TEST(UnitTestFHEWGINX, EvalFloorFunc) {
     auto cc = BinFHEContext();
@@ -40,6 +40,7 @@
 
 #include "lattice/hal/default/poly-impl.h"
 #include "lattice/hal/default/dcrtpoly.h"
+#include "math/hal/intnat/basisconvnat.h"
 
 #include "utils/exception.h"
 #include "utils/inttypes.h"
@@ -47,6 +48,7 @@
 #include "utils/utilities.h"
 #include "utils/utilities-int.h"
 
+#include <algorithm>
 #include <ostream>
 #include <memory>
 #include <string>
@@ -172,6 +174,27 @@ DCRTPolyImpl<VecType>::DCRTPolyImpl(DugType& dug, const std::shared_ptr<Params>&
     }
 }
 
+template <typename VecType>
+DCRTPolyImpl<VecType>::DCRTPolyImpl(const PRNGSeed& seed, uint32_t stream, const std::shared_ptr<Params>& dcrtParams,
+                                    Format format)
+    : m_params{dcrtParams}, m_format{format} {
+    const auto& params{m_params->GetParams()};
+    size_t size{params.size()};
+    m_vectors.resize(size);
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (size_t i = 0; i < size; ++i) {
+        PRNGSeed towerSeed{seed};
+        towerSeed[14] ^= stream;
+        towerSeed[15] ^= static_cast<PRNG::result_type>(i);
+        PRNG prng(towerSeed);
+        DCRTPolyImpl::PolyType ilvector(params[i]);
+        ilvector.SetValues(DiscreteUniformGeneratorImpl<NativeVector>::GenerateVectorFromPRNG(
+                               params[i]->GetRingDimension(), params[i]->GetModulus(), prng),
+                           m_format);
+        m_vectors[i] = std::move(ilvector);
+    }
+}
+
 template <typename VecType>
 DCRTPolyImpl<VecType>::DCRTPolyImpl(const BugType& bug, const std::shared_ptr<Params>& dcrtParams, Format format)
     : m_params{dcrtParams}, m_format{format} {
@@ -397,11 +420,11 @@ template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Minus(const DCRTPolyImpl& rhs) const {
     if (m_vectors.size() != rhs.m_vectors.size())
         OPENFHE_THROW(math_error, "tower size mismatch; cannot subtract");
-    DCRTPolyImpl<VecType> tmp(m_params, m_format);
+    DCRTPolyImpl<VecType> tmp(*this);
     size_t size{m_vectors.size()};
 #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
     for (size_t i = 0; i < size; ++i)
-        tmp.m_vectors[i] = m_vectors[i].Minus(rhs.m_vectors[i]);
+        tmp.m_vectors[i] -= rhs.m_vectors[i];
     return tmp;
 }
 
@@ -635,6 +658,163 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::TimesNoCheck(const std::vector<Nati
     return tmp;
 }
 
+template <typename VecType>
+DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::MultiplyAccumulate(const DCRTPolyImpl& a, const DCRTPolyImpl& b) {
+    if (m_format != Format::EVALUATION || a.m_format != Format::EVALUATION || b.m_format != Format::EVALUATION)
+        OPENFHE_THROW(not_implemented_error, "MultiplyAccumulate is supported only in Format::EVALUATION");
+    size_t size{m_vectors.size()};
+    if (size != a.m_vectors.size() || size != b.m_vectors.size())
+        OPENFHE_THROW(math_error, "tower size mismatch; cannot multiply-accumulate");
+    for (size_t i = 0; i < size; ++i) {
+        if (m_vectors[i].GetModulus() != a.m_vectors[i].GetModulus() ||
+            m_vectors[i].GetModulus() != b.m_vectors[i].GetModulus())
+            OPENFHE_THROW(math_error, "Modulus missmatch");
+    }
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (size_t i = 0; i < size; ++i) {
+        if (m_vectors[i].IsEmpty())
+            m_vectors[i].SetValuesToZero();
+        const PolyType* x{&a.m_vectors[i]};
+        const PolyType* y{&b.m_vectors[i]};
+        AccumulateProducts(m_vectors[i], true, &x, &y, 1);
+    }
+    return *this;
+}
+
+template <typename VecType>
+DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::InnerProduct(const std::vector<DCRTPolyImpl>& digits,
+                                                          const std::vector<DCRTPolyImpl>& keys,
+                                                          const std::vector<uint32_t>& keyTowers) {
+    if (digits.empty())
+        OPENFHE_THROW(math_error, "InnerProduct of no digits");
+    uint32_t count{static_cast<uint32_t>(digits.size())};
+    if (keys.size() < count)
+        OPENFHE_THROW(math_error, "InnerProduct has fewer keys than digits");
+    size_t size{digits[0].m_vectors.size()};
+    if (!keyTowers.empty() && keyTowers.size() != size)
+        OPENFHE_THROW(math_error, "InnerProduct needs a key tower for every tower of the digits");
+    for (uint32_t j = 0; j < count; ++j) {
+        if (digits[j].m_format != Format::EVALUATION || keys[j].m_format != Format::EVALUATION)
+            OPENFHE_THROW(not_implemented_error, "InnerProduct is supported only in Format::EVALUATION");
+        if (digits[j].m_vectors.size() != size)
+            OPENFHE_THROW(math_error, "tower size mismatch; cannot compute the inner product");
+        for (size_t i = 0; i < size; ++i) {
+            size_t t{keyTowers.empty() ? i : keyTowers[i]};
+            if (t >= keys[j].m_vectors.size() ||
+                keys[j].m_vectors[t].GetModulus() != digits[j].m_vectors[i].GetModulus() ||
+                digits[j].m_vectors[i].GetModulus() != digits[0].m_vectors[i].GetModulus())
+                OPENFHE_THROW(math_error, "Modulus missmatch");
+        }
+    }
+
+    DCRTPolyImpl<VecType> result(digits[0].m_params, Format::EVALUATION, true);
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (size_t i = 0; i < size; ++i) {
+        size_t t{keyTowers.empty() ? i : keyTowers[i]};
+        std::vector<const PolyType*> x(count), y(count);
+        for (uint32_t j = 0; j < count; ++j) {
+            x[j] = &digits[j].m_vectors[i];
+            y[j] = &keys[j].m_vectors[t];
+        }
+        AccumulateProducts(result.m_vectors[i], false, x.data(), y.data(), count);
+    }
+    return result;
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::AccumulateProducts(PolyType& out, bool add, const PolyType* const* x,
+                                               const PolyType* const* y, uint32_t count) {
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    static_assert(sizeof(NativeInteger) == sizeof(uint64_t), "the accumulation reads the towers as 64-bit words");
+    // the accumulators of a tile stay in L1 while the products of every digit are added to them
+    constexpr uint32_t TILE{256};
+    const uint64_t q{out.GetModulus().ConvertToInt()};
+    const DoubleNativeInt mu{~DoubleNativeInt(0) / q};
+    // products of reduced operands are below (q - 1)^2: this many fit on top of a reduced value
+    const DoubleNativeInt maxProduct{DoubleNativeInt(q - 1) * (q - 1)};
+    const DoubleNativeInt fit{maxProduct == 0 ? count : (~DoubleNativeInt(0) - q) / maxProduct};
+    const uint32_t room{fit < count ? static_cast<uint32_t>(fit) : count};
+
+    std::vector<const uint64_t*> xs(count), ys(count);
+    for (uint32_t j = 0; j < count; ++j) {
+        xs[j] = reinterpret_cast<const uint64_t*>(&x[j]->GetValues()[0]);
+        ys[j] = reinterpret_cast<const uint64_t*>(&y[j]->GetValues()[0]);
+    }
+    uint32_t n{out.GetLength()};
+    uint64_t* z{reinterpret_cast<uint64_t*>(&out[0])};
+    DoubleNativeInt acc[TILE];
+    for (uint32_t k0 = 0; k0 < n; k0 += TILE) {
+        uint32_t len{std::min(TILE, n - k0)};
+        for (uint32_t k = 0; k < len; ++k)
+            acc[k] = add ? z[k0 + k] : 0;
+        for (uint32_t j = 0, terms = 0; j < count; ++j, ++terms) {
+            if (terms == room) {
+                for (uint32_t k = 0; k < len; ++k)
+                    acc[k] = BarrettUint128ModUint64(acc[k], q, mu);
+                terms = 0;
+            }
+            const uint64_t* a{xs[j] + k0};
+            const uint64_t* b{ys[j] + k0};
+            for (uint32_t k = 0; k < len; ++k)
+                acc[k] += DoubleNativeInt(a[k]) * b[k];
+        }
+        for (uint32_t k = 0; k < len; ++k)
+            z[k0 + k] = BarrettUint128ModUint64(acc[k], q, mu);
+    }
+#else
+    if (!add)
+        out.SetValuesToZero();
+    for (uint32_t j = 0; j < count; ++j)
+        out.PlusNoCheckEq(x[j]->TimesNoCheck(*y[j]));
+#endif
+}
+
+template <typename VecType>
+std::vector<NativeVector> DCRTPolyImpl<VecType>::ComputeShoupPrecon() const {
+    if (m_format != Format::EVALUATION)
+        OPENFHE_THROW(not_implemented_error, "ComputeShoupPrecon is supported only in Format::EVALUATION");
+    size_t size{m_vectors.size()};
+    std::vector<NativeVector> precon(size);
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (size_t i = 0; i < size; ++i) {
+        const NativeInteger& qi{m_vectors[i].GetModulus()};
+        const auto& values{m_vectors[i].GetValues()};
+        size_t n{values.GetLength()};
+        NativeVector p(n, qi);
+        for (size_t k = 0; k < n; ++k)
+            p[k] = values[k].PrepModMulConst(qi);
+        precon[i] = std::move(p);
+    }
+    return precon;
+}
+
+template <typename VecType>
+DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::TimesShoupEq(const DCRTPolyImpl& rhs,
+                                                           const std::vector<NativeVector>& rhsPrecon) {
+    if (m_format != Format::EVALUATION || rhs.m_format != Format::EVALUATION)
+        OPENFHE_THROW(not_implemented_error, "TimesShoupEq is supported only in Format::EVALUATION");
+    size_t size{m_vectors.size()};
+    if (rhs.m_vectors.size() < size || rhsPrecon.size() < size)
+        OPENFHE_THROW(math_error, "tower size mismatch; cannot multiply");
+    for (size_t i = 0; i < size; ++i) {
+        if (m_vectors[i].GetModulus() != rhs.m_vectors[i].GetModulus() ||
+            rhsPrecon[i].GetModulus() != m_vectors[i].GetModulus())
+            OPENFHE_THROW(math_error, "Modulus missmatch");
+        if (rhsPrecon[i].GetLength() != m_vectors[i].GetLength())
+            OPENFHE_THROW(math_error, "RingDimension missmatch");
+    }
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (size_t i = 0; i < size; ++i) {
+        const NativeInteger& qi{m_vectors[i].GetModulus()};
+        const auto& b{rhs.m_vectors[i].GetValues()};
+        const auto& bPrecon{rhsPrecon[i]};
+        uint32_t n{m_vectors[i].GetLength()};
+        for (uint32_t k = 0; k < n; ++k)
+            m_vectors[i][k].ModMulFastConstEq(b[k], qi, bPrecon[k]);
+    }
+    return *this;
+}
+
 template <typename VecType>
 DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator*=(const Integer& rhs) {
     NativeInteger val{rhs};
@@ -740,6 +920,103 @@ void DCRTPolyImpl<VecType>::DropLastElements(size_t i) {
     m_params.reset(newP);
 }
 
+template <typename VecType>
+bool DCRTPolyImpl<VecType>::IsContiguous() const {
+    if (m_vectors.empty() || m_vectors[0].IsEmpty())
+        return false;
+    const auto* slab = m_vectors[0].GetValues().GetSlab();
+    if (!slab || slab->GetNumTowers() < m_vectors.size() || slab->GetRingDimension() != m_params->GetRingDimension())
+        return false;
+    for (size_t i = 0; i < m_vectors.size(); ++i) {
+        if (m_vectors[i].IsEmpty())
+            return false;
+        const auto& v = m_vectors[i].GetValues();
+        if (reinterpret_cast<const uint64_t*>(&v[0]) != slab->Tower(i))
+            return false;
+    }
+    return true;
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::MakeContiguous() {
+    if (IsContiguous())
+        return;
+    CopyTowersToSlab(m_vectors);
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::CopyTowersToSlab(const std::vector<PolyType>& src) {
+    static_assert(sizeof(NativeInteger) == sizeof(uint64_t), "slab storage needs 64-bit native integers");
+    usint ringDim{m_params->GetRingDimension()};
+    size_t size{src.size()};
+    auto slab = LimbSlab::Create(ringDim, size);
+    if (&src != &m_vectors) {
+        m_vectors.clear();
+        m_vectors.reserve(size);
+        for (const auto& tower : src)
+            m_vectors.emplace_back(tower.GetParams(), tower.GetFormat());
+    }
+    for (size_t i = 0; i < size; ++i) {
+        NativeVector v(ringDim, src[i].GetParams()->GetModulus(), LimbAllocator<NativeInteger>(slab.get(), i));
+        if (!src[i].IsEmpty()) {
+            const auto& old = src[i].GetValues();
+            for (usint j = 0; j < ringDim; ++j)
+                v[j] = old[j];
+        }
+        // the values are unchanged, and so are the formats recorded for them
+        auto formats = std::atomic_load(&src[i].m_formats);
+        m_vectors[i].m_formats.reset();
+        m_vectors[i].SetValues(std::move(v), m_vectors[i].GetFormat());
+        m_vectors[i].m_formats = std::move(formats);
+    }
+}
+
+#if defined(HAVE_INT128) && NATIVEINT == 64
+template <typename VecType>
+void DCRTPolyImpl<VecType>::FastBasisConversion(const PolyType* in, uint32_t sizeIn, const NativeInteger* scale,
+                                                const NativeInteger* scalePrecon,
+                                                const std::vector<std::vector<NativeInteger>>& matrix, PolyType* out,
+                                                uint32_t sizeOut, const std::vector<DoubleNativeInt>& barrettMu) {
+    static_assert(sizeof(NativeInteger) == sizeof(uint64_t), "the kernel reads the towers as 64-bit words");
+    uint32_t n = in[0].GetLength();
+    std::vector<const uint64_t*> x(sizeIn);
+    std::vector<uint64_t> q(sizeIn);
+    for (uint32_t i = 0; i < sizeIn; ++i) {
+        x[i] = reinterpret_cast<const uint64_t*>(&in[i].GetValues()[0]);
+        q[i] = in[i].GetModulus().ConvertToInt();
+    }
+    std::vector<uint64_t*> y(sizeOut);
+    std::vector<uint64_t> p(sizeOut);
+    // the kernel reads the constants of one output modulus contiguously
+    std::vector<uint64_t> m(static_cast<size_t>(sizeOut) * sizeIn);
+    for (uint32_t j = 0; j < sizeOut; ++j) {
+        y[j] = reinterpret_cast<uint64_t*>(&out[j][0]);
+        p[j] = out[j].GetModulus().ConvertToInt();
+        for (uint32_t i = 0; i < sizeIn; ++i)
+            m[static_cast<size_t>(j) * sizeIn + i] = matrix[i][j].ConvertToInt();
+    }
+    intnat::FastBasisConversion(x.data(), q.data(), reinterpret_cast<const uint64_t*>(scale),
+                                reinterpret_cast<const uint64_t*>(scalePrecon), sizeIn, m.data(), y.data(), p.data(),
+                                barrettMu.data(), sizeOut, n);
+}
+#endif
+
+template <typename VecType>
+DCRTRawView DCRTPolyImpl<VecType>::GetRawView() {
+    if (!IsContiguous())
+        OPENFHE_THROW(config_error, "DCRTPoly towers are not in a single slab; call MakeContiguous() first");
+    for (auto& v : m_vectors)
+        v.DropFormatCache();
+    DCRTRawView view;
+    view.data      = m_vectors[0].GetValues().GetSlab()->Data();
+    view.ringDim   = m_params->GetRingDimension();
+    view.numTowers = m_vectors.size();
+    view.moduli.reserve(m_vectors.size());
+    for (const auto& v : m_vectors)
+        view.moduli.push_back(v.GetModulus().ConvertToInt());
+    return view;
+}
+
 // used for CKKS rescaling
 template <typename VecType>
 void DCRTPolyImpl<VecType>::DropLastElementAndScale(const std::vector<NativeInteger>& QlQlInvModqlDivqlModq,
@@ -1037,27 +1314,11 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
 #if defined(HAVE_INT128) && NATIVEINT == 64
     DCRTPolyImpl<VecType> ans(paramsP, m_format, true);
 
-    usint ringDim = m_params->GetRingDimension();
-    usint sizeQ   = (m_vectors.size() > paramsQ->GetParams().size()) ? paramsQ->GetParams().size() : m_vectors.size();
-    usint sizeP   = ans.m_vectors.size();
-
-    #pragma omp parallel for
-    for (usint ri = 0; ri < ringDim; ri++) {
-        std::vector<DoubleNativeInt> sum(sizeP);
-        for (usint i = 0; i < sizeQ; i++) {
-            const NativeInteger& xi     = m_vectors[i][ri];
-            const NativeInteger& qi     = m_vectors[i].GetModulus();
-            NativeInteger xQHatInvModqi = xi.ModMulFastConst(QHatInvModq[i], qi, QHatInvModqPrecon[i]);
-            for (usint j = 0; j < sizeP; j++) {
-                sum[j] += Mul128(xQHatInvModqi.ConvertToInt(), QHatModp[i][j].ConvertToInt());
-            }
-        }
+    usint sizeQ = (m_vectors.size() > paramsQ->GetParams().size()) ? paramsQ->GetParams().size() : m_vectors.size();
+    usint sizeP = ans.m_vectors.size();
 
-        for (usint j = 0; j < sizeP; j++) {
-            const NativeInteger& pj = ans.m_vectors[j].GetModulus();
-            ans.m_vectors[j][ri]    = BarrettUint128ModUint64(sum[j], pj.ConvertToInt(), modpBarrettMu[j]);
-        }
-    }
+    FastBasisConversion(m_vectors.data(), sizeQ, QHatInvModq.data(), QHatInvModqPrecon.data(), QHatModp,
+                        ans.m_vectors.data(), sizeP, modpBarrettMu);
     return ans;
 }
 
@@ -1410,34 +1671,15 @@ void DCRTPolyImpl<VecType>::ExpandCRTBasisReverseOrder(
 
 template <typename VecType>
 void DCRTPolyImpl<VecType>::FastExpandCRTBasisPloverQ(const Precomputations& precomputed) {
-    usint ringDim = m_params->GetRingDimension();
-    size_t sizeQ  = m_vectors.size();
+    size_t sizeQ = m_vectors.size();
     DCRTPolyImpl<VecType> partPl(precomputed.paramsPl, m_format, true);
     const size_t sizePl = partPl.m_vectors.size();
 
 #if defined(HAVE_INT128) && NATIVEINT == 64
     // (k + kl)n
-    #pragma omp parallel for
-    for (usint ri = 0; ri < ringDim; ri++) {
-        std::vector<DoubleNativeInt> sum(sizePl);
-        for (usint i = 0; i < sizeQ; i++) {
-            const NativeInteger& xi                     = m_vectors[i][ri];
-            const NativeInteger& qi                     = m_vectors[i].GetModulus();
-            const std::vector<NativeInteger>& qInvModpi = precomputed.qInvModp[i];
-            NativeInteger xQHatInvModqi =
-                xi.ModMulFastConst(precomputed.mPlQHatInvModq[i], qi, precomputed.mPlQHatInvModqPrecon[i]);
-            for (usint j = 0; j < sizePl; j++) {
-                auto a = xQHatInvModqi.ConvertToInt();
-                auto b = qInvModpi[j].ConvertToInt();
-                sum[j] += Mul128(a, b);
-            }
-        }
-
-        for (usint j = 0; j < sizePl; j++) {
-            const NativeInteger& pj = partPl.m_vectors[j].GetModulus();
-            partPl.m_vectors[j][ri] = BarrettUint128ModUint64(sum[j], pj.ConvertToInt(), precomputed.modpBarrettMu[j]);
-        }
-    }
+    FastBasisConversion(m_vectors.data(), sizeQ, precomputed.mPlQHatInvModq.data(),
+                        precomputed.mPlQHatInvModqPrecon.data(), precomputed.qInvModp, partPl.m_vectors.data(), sizePl,
+                        precomputed.modpBarrettMu);
 
     // EMM: (l + ll)n
     // EFP: ln
@@ -1465,6 +1707,7 @@ void DCRTPolyImpl<VecType>::FastExpandCRTBasisPloverQ(const Precomputations& pre
 }
 
 #else
+    usint ringDim = m_params->GetRingDimension();
     // (k + kl)n
     #pragma omp parallel for
     for (usint ri = 0; ri < ringDim; ri++) {
@@ -2109,18 +2352,10 @@ void DCRTPolyImpl<VecType>::FastBaseConvqToBskMontgomery(
 
 #if defined(HAVE_INT128) && NATIVEINT == 64
     // mod Bsk
-    for (uint32_t j = 0; j < numBsk; j++) {
-        DCRTPolyImpl::PolyType newvec(m_params->GetParams()[numQ + j], m_format, true);
-        m_vectors[numQ + j] = std::move(newvec);
-        for (uint32_t k = 0; k < n; k++) {
-            DoubleNativeInt result = 0;
-            for (uint32_t i = 0; i < numQ; i++) {
-                const NativeInteger& QHatModbskij = QHatModbsk[i][j];
-                result += Mul128(ximtildeQHatModqi[i * n + k].ConvertToInt(), QHatModbskij.ConvertToInt());
-            }
-            m_vectors[numQ + j][k] = BarrettUint128ModUint64(result, moduliBsk[j].ConvertToInt(), modbskBarrettMu[j]);
-        }
-    }
+    for (uint32_t j = 0; j < numBsk; j++)
+        m_vectors[numQ + j] = DCRTPolyImpl::PolyType(m_params->GetParams()[numQ + j], m_format, true);
+    FastBasisConversion(m_vectors.data(), numQ, mtildeQHatInvModq.data(), mtildeQHatInvModqPrecon.data(), QHatModbsk,
+                        m_vectors.data() + numQ, numBsk, modbskBarrettMu);
 #else
     std::vector<NativeInteger> mu(numBsk);
     for (usint j = 0; j < numBsk; j++) {
@@ -2337,18 +2572,9 @@ void DCRTPolyImpl<VecType>::FastBaseConvSK(
         }
     }
 
-    for (uint32_t j = 0; j < sizeQ; j++) {
-    #pragma omp parallel for
-        for (uint32_t k = 0; k < n; k++) {
-            DoubleNativeInt result = 0;
-            for (uint32_t i = 0; i < sizeBsk - 1; i++) {  // exclude msk residue
-                const NativeInteger& currentBDivBiModqj = BHatModq[i][j];
-                const NativeInteger& xi                 = m_vectors[sizeQ + i][k];
-                result += Mul128(xi.ConvertToInt(), currentBDivBiModqj.ConvertToInt());
-            }
-            m_vectors[j][k] = BarrettUint128ModUint64(result, moduliQ[j].ConvertToInt(), modqBarrettMu[j]);
-        }
-    }
+    // exclude msk residue
+    FastBasisConversion(m_vectors.data() + sizeQ, sizeBsk - 1, nullptr, nullptr, BHatModq, m_vectors.data(), sizeQ,
+                        modqBarrettMu);
 
     // calculate alphaskx
     // FastBaseConv(x, B, msk)
@@ -45,8 +45,10 @@
 
 #include "utils/exception.h"
 #include "utils/inttypes.h"
+#include "utils/limbslab.h"
 #include "utils/parallel.h"
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
@@ -55,6 +57,25 @@
 
 namespace lbcrypto {
 
+/**
+ * @brief Raw limb-major view of the towers of a DCRTPoly, tower i at data + i * ringDim.
+ * Only valid while the towers stay in the slab they were viewed in.
+ */
+struct DCRTRawView {
+    uint64_t* data{nullptr};
+    usint ringDim{0};
+    usint numTowers{0};
+    std::vector<uint64_t> moduli;
+};
+
+/**
+ * @brief Where the towers of the DCRTPolys keep their coefficients.
+ * TOWER_HEAP: one heap block per tower (the default).
+ * LIMB_SLAB: one LimbSlab of numTowers x ringDim words per DCRTPoly, as after MakeContiguous(); the
+ * constructors and copies allocate the slab at once, in place of one block per tower.
+ */
+enum DCRTStoragePolicy { TOWER_HEAP, LIMB_SLAB };
+
 template <typename VecType>
 class DCRTPolyImpl final : public DCRTPolyInterface<DCRTPolyImpl<VecType>, VecType, NativeVector, PolyImpl> {
 public:
@@ -73,11 +94,28 @@ public:
 
     DCRTPolyImpl() = default;
 
-    DCRTPolyImpl(const DCRTPolyType& e) noexcept : m_params{e.m_params}, m_format{e.m_format}, m_vectors{e.m_vectors} {}
+    DCRTPolyImpl(const DCRTPolyType& e) noexcept : m_params{e.m_params}, m_format{e.m_format} {
+        if (GetStoragePolicy() == LIMB_SLAB && !e.m_vectors.empty())
+            CopyTowersToSlab(e.m_vectors);
+        else
+            m_vectors = e.m_vectors;
+    }
     DCRTPolyType& operator=(const DCRTPolyType& rhs) noexcept override {
-        m_params  = rhs.m_params;
-        m_format  = rhs.m_format;
-        m_vectors = rhs.m_vectors;
+        m_params = rhs.m_params;
+        m_format = rhs.m_format;
+        // a slab with room for the towers of rhs takes them in place
+        if (GetStoragePolicy() == LIMB_SLAB && rhs.m_vectors.size() <= m_vectors.size() && IsContiguous() &&
+            !rhs.IsEmpty()) {
+            m_vectors.resize(rhs.m_vectors.size());
+            for (size_t i = 0; i < m_vectors.size(); ++i)
+                m_vectors[i] = rhs.m_vectors[i];
+        }
+        else if (GetStoragePolicy() == LIMB_SLAB && !rhs.m_vectors.empty()) {
+            CopyTowersToSlab(rhs.m_vectors);
+        }
+        else {
+            m_vectors = rhs.m_vectors;
+        }
         return *this;
     }
 
@@ -102,8 +140,12 @@ public:
                  bool initializeElementToZero = false) noexcept
         : m_params{params}, m_format{format} {
         m_vectors.reserve(m_params->GetParams().size());
+        // the slab is zeroed, so its towers are initialized either way
+        bool slab{GetStoragePolicy() == LIMB_SLAB && !m_params->GetParams().empty()};
         for (const auto& p : m_params->GetParams())
-            m_vectors.emplace_back(p, m_format, initializeElementToZero);
+            m_vectors.emplace_back(p, m_format, initializeElementToZero && !slab);
+        if (slab)
+            CopyTowersToSlab(m_vectors);
     }
 
     DCRTPolyImpl(const DggType& dgg, const std::shared_ptr<Params>& p, Format f = Format::EVALUATION);
@@ -111,6 +153,16 @@ public:
     DCRTPolyImpl(const TugType& tug, const std::shared_ptr<Params>& p, Format f = Format::EVALUATION, uint32_t h = 0);
     DCRTPolyImpl(DugType& dug, const std::shared_ptr<Params>& p, Format f = Format::EVALUATION);
 
+    /**
+   * @brief Uniform polynomial expanded from a seed: tower i takes the values
+   * DiscreteUniformGeneratorImpl::GenerateVectorFromPRNG() draws from a PRNG on the seed with stream and i
+   * xored into its last two words. The values are taken in format f, a uniform polynomial being uniform in
+   * both. The same seed, stream and parameters give the same polynomial on any platform, so the seed can
+   * stand for the values when they are stored.
+   */
+    DCRTPolyImpl(const PRNGSeed& seed, uint32_t stream, const std::shared_ptr<Params>& p,
+                 Format f = Format::EVALUATION);
+
     DCRTPolyType& operator=(std::initializer_list<uint64_t> rhs) noexcept override;
     DCRTPolyType& operator=(uint64_t val) noexcept;
     DCRTPolyType& operator=(const std::vector<int64_t>& rhs) noexcept;
@@ -169,10 +221,11 @@ public:
             OPENFHE_THROW(math_error, "tower size mismatch; cannot add");
         if (m_vectors[0].GetModulus() != rhs.m_vectors[0].GetModulus())
             OPENFHE_THROW(math_error, "Modulus missmatch");
-        DCRTPolyType tmp(m_params, m_format);
+        // copy and update in place, so that a LIMB_SLAB copy keeps its towers in the slab
+        DCRTPolyType tmp(*this);
 #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
         for (size_t i = 0; i < size; ++i)
-            tmp.m_vectors[i] = m_vectors[i].PlusNoCheck(rhs.m_vectors[i]);
+            tmp.m_vectors[i].PlusNoCheckEq(rhs.m_vectors[i]);
         return tmp;
     }
 
@@ -190,10 +243,10 @@ public:
             OPENFHE_THROW(math_error, "tower size mismatch; cannot multiply");
         if (m_vectors[0].GetModulus() != rhs.m_vectors[0].GetModulus())
             OPENFHE_THROW(math_error, "Modulus missmatch");
-        DCRTPolyType tmp(m_params, m_format);
+        DCRTPolyType tmp(*this);
 #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
         for (size_t i = 0; i < size; ++i)
-            tmp.m_vectors[i] = m_vectors[i].TimesNoCheck(rhs.m_vectors[i]);
+            tmp.m_vectors[i].TimesNoCheckEq(rhs.m_vectors[i]);
         return tmp;
     }
     DCRTPolyType Times(const Integer& rhs) const override;
@@ -207,6 +260,44 @@ public:
     DCRTPolyType Times(const std::vector<NativeInteger>& rhs) const;
     DCRTPolyType TimesNoCheck(const std::vector<NativeInteger>& rhs) const;
 
+    /**
+     * this += a * b in EVALUATION format, each coefficient reduced once instead of after the product and
+     * after the sum.
+     */
+    DCRTPolyType& MultiplyAccumulate(const DCRTPolyType& a, const DCRTPolyType& b);
+
+    /**
+     * Fused sum_j digits[j] * keys[j] in EVALUATION format, as in the key switching inner products. Each tower
+     * is computed in one pass: the products are accumulated in 128 bits and every coefficient is reduced
+     * once, with no temporary polynomial.
+     *
+     * @param digits the polynomials to multiply, all on the parameters of the result.
+     * @param keys at least as many polynomials as digits; the extra ones are ignored.
+     * @param keyTowers the tower of the keys multiplied into each tower of the result, for keys on a larger
+     * basis than the digits; empty means the towers of the same index.
+     * @return the inner product, on the parameters of the digits.
+     */
+    static DCRTPolyType InnerProduct(const std::vector<DCRTPolyType>& digits, const std::vector<DCRTPolyType>& keys,
+                                     const std::vector<uint32_t>& keyTowers = {});
+
+    /**
+     * Shoup precomputations floor(x * 2^64 / q_i) of every coefficient of this polynomial in EVALUATION
+     * format, for a polynomial that multiplies many others through TimesShoupEq(). They are only valid for
+     * the values they were computed from.
+     *
+     * @return one vector per tower, on the modulus of the tower.
+     */
+    std::vector<NativeVector> ComputeShoupPrecon() const;
+
+    /**
+     * this *= rhs in EVALUATION format, using the Shoup precomputations of rhs: a multiply-high and a
+     * conditional subtraction replace the Barrett reduction of every product.
+     *
+     * @param rhs the constant operand; towers past the ones of this polynomial are ignored.
+     * @param rhsPrecon rhs.ComputeShoupPrecon(), or a prefix of it covering the towers of this polynomial.
+     */
+    DCRTPolyType& TimesShoupEq(const DCRTPolyType& rhs, const std::vector<NativeVector>& rhsPrecon);
+
     DCRTPolyType MultiplicativeInverse() const override;
     bool InverseExists() const override;
     bool IsEmpty() const override;
@@ -402,6 +493,90 @@ public:
         m_vectors[index] = std::move(element);
     }
 
+    /**
+     * Moves the towers into one limb-major LimbSlab unless they already share one. Afterwards
+     * GetRawView() is free. Operations that update or replace a tower (SetElementAtIndex, tower
+     * assignment) keep it in the slab, as long as its length does not change.
+     */
+    void MakeContiguous();
+
+    /**
+     * @return true if tower i lives at offset i * ringDim of a single LimbSlab for every i.
+     */
+    bool IsContiguous() const;
+
+    /**
+     * Raw view of the coefficients without copying. Writes through the view are writes to
+     * this DCRTPoly. Throws if !IsContiguous().
+     * The towers drop their recorded formats (PolyFormatCache), which such writes would leave stale.
+     */
+    DCRTRawView GetRawView();
+
+    /**
+     * Selects the storage of the DCRTPolys constructed or copied from now on, for all threads.
+     * Existing DCRTPolys keep their storage.
+     */
+    static void SetStoragePolicy(DCRTStoragePolicy policy) {
+        StoragePolicy().store(policy, std::memory_order_relaxed);
+    }
+
+    // the policy of the innermost StorageScope of the calling thread, else the global one
+    static DCRTStoragePolicy GetStoragePolicy() {
+        int scoped{ThreadStoragePolicy()};
+        return scoped < 0 ? StoragePolicy().load(std::memory_order_relaxed) : static_cast<DCRTStoragePolicy>(scoped);
+    }
+
+    /**
+     * @brief Overrides the storage policy on the calling thread while it lives; scopes nest.
+     * Hot paths open a LIMB_SLAB scope so that their temporaries draw whole slabs from the
+     * per-thread ScratchPool, where the previous call left them.
+     */
+    class StorageScope {
+    public:
+        explicit StorageScope(DCRTStoragePolicy policy) : m_saved{ThreadStoragePolicy()} {
+            ThreadStoragePolicy() = policy;
+        }
+        ~StorageScope() {
+            ThreadStoragePolicy() = m_saved;
+        }
+        StorageScope(const StorageScope&)            = delete;
+        StorageScope& operator=(const StorageScope&) = delete;
+
+    private:
+        int m_saved;
+    };
+
+private:
+    static std::atomic<DCRTStoragePolicy>& StoragePolicy() {
+        static std::atomic<DCRTStoragePolicy> policy{TOWER_HEAP};
+        return policy;
+    }
+
+    // -1 outside of any StorageScope
+    static int& ThreadStoragePolicy() {
+        thread_local int policy{-1};
+        return policy;
+    }
+
+    // replaces the towers by ones with the parameters and coefficients of src (which may be m_vectors)
+    // in a new LimbSlab; empty towers of src become zero towers
+    void CopyTowersToSlab(const std::vector<PolyType>& src);
+
+    // out = (add ? out : 0) + sum_j x[j] * y[j] of towers on one modulus, reduced once per coefficient
+    static void AccumulateProducts(PolyType& out, bool add, const PolyType* const* x, const PolyType* const* y,
+                                   uint32_t count);
+
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    // intnat::FastBasisConversion of the towers in[0, sizeIn) into the existing towers out[0, sizeOut), with
+    // the inputs scaled by scale[i] mod q_i unless scale is nullptr and the constants matrix[i][j] mod p_j
+    static void FastBasisConversion(const PolyType* in, uint32_t sizeIn, const NativeInteger* scale,
+                                    const NativeInteger* scalePrecon,
+                                    const std::vector<std::vector<NativeInteger>>& matrix, PolyType* out,
+                                    uint32_t sizeOut, const std::vector<DoubleNativeInt>& barrettMu);
+#endif
+
+public:
+
 //protected:
     std::shared_ptr<Params> m_params{std::make_shared<DCRTPolyImpl::Params>(0, 1)};
     Format m_format{Format::EVALUATION};
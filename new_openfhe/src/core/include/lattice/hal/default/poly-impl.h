@@ -89,6 +89,7 @@ template <typename VecType>
 PolyImpl<VecType>& PolyImpl<VecType>::operator=(const PolyImpl& rhs) noexcept {
     m_format = rhs.m_format;
     m_params = rhs.m_params;
+    m_formats = ShareFormats(rhs);
     if (!rhs.m_values) {
         m_values = nullptr;
         return *this;
@@ -104,6 +105,7 @@ PolyImpl<VecType>& PolyImpl<VecType>::operator=(const PolyImpl& rhs) noexcept {
 // assumes that elements in rhs less than modulus?
 template <typename VecType>
 PolyImpl<VecType>& PolyImpl<VecType>::operator=(std::initializer_list<uint64_t> rhs) {
+    DropFormatCache();
     static const Integer ZERO(0);
     const size_t llen = rhs.size();
     const size_t vlen = m_params->GetRingDimension();
@@ -120,6 +122,7 @@ PolyImpl<VecType>& PolyImpl<VecType>::operator=(std::initializer_list<uint64_t>
 // TODO: template with enable_if int64_t/int32_t
 template <typename VecType>
 PolyImpl<VecType>& PolyImpl<VecType>::operator=(const std::vector<int64_t>& rhs) {
+    DropFormatCache();
     static const Integer ZERO(0);
     m_format = Format::COEFFICIENT;
     const size_t llen{rhs.size()};
@@ -142,6 +145,7 @@ PolyImpl<VecType>& PolyImpl<VecType>::operator=(const std::vector<int64_t>& rhs)
 
 template <typename VecType>
 PolyImpl<VecType>& PolyImpl<VecType>::operator=(const std::vector<int32_t>& rhs) {
+    DropFormatCache();
     static const Integer ZERO(0);
     m_format = Format::COEFFICIENT;
     const size_t llen{rhs.size()};
@@ -164,6 +168,7 @@ PolyImpl<VecType>& PolyImpl<VecType>::operator=(const std::vector<int32_t>& rhs)
 
 template <typename VecType>
 PolyImpl<VecType>& PolyImpl<VecType>::operator=(std::initializer_list<std::string> rhs) {
+    DropFormatCache();
     const size_t vlen = m_params->GetRingDimension();
     if (!m_values) {
         VecType temp(vlen);
@@ -176,6 +181,7 @@ PolyImpl<VecType>& PolyImpl<VecType>::operator=(std::initializer_list<std::strin
 
 template <typename VecType>
 PolyImpl<VecType>& PolyImpl<VecType>::operator=(uint64_t val) {
+    DropFormatCache();
     m_format = Format::EVALUATION;
     if (!m_values) {
         auto d{m_params->GetRingDimension()};
@@ -195,6 +201,7 @@ void PolyImpl<VecType>::SetValues(const VecType& values, Format format) {
         OPENFHE_THROW(type_error, "Polynomial has a 0 root of unity");
     if (m_params->GetRingDimension() != values.GetLength() || m_params->GetModulus() != values.GetModulus())
         OPENFHE_THROW(type_error, "Parameter mismatch on SetValues for Polynomial");
+    DropFormatCache();
     m_format = format;
     m_values = std::make_unique<VecType>(values);
 }
@@ -205,6 +212,7 @@ void PolyImpl<VecType>::SetValues(VecType&& values, Format format) {
         OPENFHE_THROW(type_error, "Polynomial has a 0 root of unity");
     if (m_params->GetRingDimension() != values.GetLength() || m_params->GetModulus() != values.GetModulus())
         OPENFHE_THROW(type_error, "Parameter mismatch on SetValues for Polynomial");
+    DropFormatCache();
     m_format = format;
     m_values = std::make_unique<VecType>(std::move(values));
 }
@@ -285,6 +293,7 @@ PolyImpl<VecType> PolyImpl<VecType>::Negate() const {
 
 template <typename VecType>
 PolyImpl<VecType>& PolyImpl<VecType>::operator+=(const PolyImpl& element) {
+    DropFormatCache();
     if (!m_values)
         m_values = std::make_unique<VecType>(m_params->GetRingDimension(), m_params->GetModulus());
     m_values->ModAddEq(*element.m_values);
@@ -293,6 +302,7 @@ PolyImpl<VecType>& PolyImpl<VecType>::operator+=(const PolyImpl& element) {
 
 template <typename VecType>
 PolyImpl<VecType>& PolyImpl<VecType>::operator-=(const PolyImpl& element) {
+    DropFormatCache();
     if (!m_values)
         m_values = std::make_unique<VecType>(m_params->GetRingDimension(), m_params->GetModulus());
     m_values->ModSubEq(*element.m_values);
@@ -301,6 +311,7 @@ PolyImpl<VecType>& PolyImpl<VecType>::operator-=(const PolyImpl& element) {
 
 template <typename VecType>
 void PolyImpl<VecType>::AddILElementOne() {
+    DropFormatCache();
     static const Integer ONE(1);
     usint vlen{m_params->GetRingDimension()};
     const auto& m{m_params->GetModulus()};
@@ -401,6 +412,7 @@ PolyImpl<VecType> PolyImpl<VecType>::Mod(const Integer& modulus) const {
 template <typename VecType>
 void PolyImpl<VecType>::SwitchModulus(const Integer& modulus, const Integer& rootOfUnity, const Integer& modulusArb,
                                       const Integer& rootOfUnityArb) {
+    DropFormatCache();
     if (m_values != nullptr) {
         m_values->SwitchModulus(modulus);
         auto c{m_params->GetCyclotomicOrder()};
@@ -422,19 +434,62 @@ void PolyImpl<VecType>::SwitchFormat() {
     if (!m_values)
         OPENFHE_THROW(not_available_error, "Poly switch format to empty values");
 
-    if (m_format != Format::COEFFICIENT) {
-        m_format = Format::COEFFICIENT;
-        ChineseRemainderTransformFTT<VecType>().InverseTransformFromBitReverseInPlace(ru, co, &(*m_values));
-        return;
+    const Format target{(m_format == Format::COEFFICIENT) ? Format::EVALUATION : Format::COEFFICIENT};
+    // only the values of a polynomial that has been copied are recorded: the record is then shared by the
+    // other copies, which are the ones likely to be switched again
+    bool record{false};
+    if (m_formats) {
+        // held here, so that the record outlives its mutex when this polynomial drops it below
+        const auto formats{m_formats};
+        std::lock_guard<std::mutex> lock(formats->mutex);
+        const auto& source = formats->values[m_format];
+        if (source && *source != *m_values) {
+            // written through operator[] or at(), which do not drop the record
+            m_formats.reset();
+            PolyFormatCache::CountInvalidation();
+        }
+        else if (source && formats->values[target]) {
+            // copied into the current storage, which keeps a tower of a DCRTPoly slab in place
+            *m_values = *formats->values[target];
+            m_format  = target;
+            PolyFormatCache::CountTransformAvoided();
+            return;
+        }
+        else if (PolyFormatCache::IsEnabled()) {
+            if (!source)
+                formats->values[m_format] = std::make_shared<const VecType>(*m_values);
+            record = true;
+        }
+    }
+
+    if constexpr (std::is_same_v<VecType, NativeVector>) {
+        // the tables of the id the parameters keep, with no lookup by modulus
+        const uint32_t tables{m_params->GetNTTTablesId()};
+        if (m_format != Format::COEFFICIENT)
+            ChineseRemainderTransformFTT<VecType>().InverseTransformFromBitReverseInPlace(tables, &(*m_values));
+        else
+            ChineseRemainderTransformFTT<VecType>().ForwardTransformToBitReverseInPlace(tables, &(*m_values));
+    }
+    else {
+        if (m_format != Format::COEFFICIENT)
+            ChineseRemainderTransformFTT<VecType>().InverseTransformFromBitReverseInPlace(ru, co, &(*m_values));
+        else
+            ChineseRemainderTransformFTT<VecType>().ForwardTransformToBitReverseInPlace(ru, co, &(*m_values));
+    }
+    m_format = target;
+    PolyFormatCache::CountTransform();
+
+    if (record) {
+        std::lock_guard<std::mutex> lock(m_formats->mutex);
+        m_formats->values[target] = std::make_shared<const VecType>(*m_values);
     }
-    m_format = Format::EVALUATION;
-    ChineseRemainderTransformFTT<VecType>().ForwardTransformToBitReverseInPlace(ru, co, &(*m_values));
 }
 
 template <typename VecType>
 void PolyImpl<VecType>::ArbitrarySwitchFormat() {
     if (m_values == nullptr)
         OPENFHE_THROW(not_available_error, "Poly switch format to empty values");
+    DropFormatCache();
     const auto& lr = m_params->GetRootOfUnity();
     const auto& bm = m_params->GetBigModulus();
     const auto& br = m_params->GetBigRootOfUnity();
@@ -468,6 +523,7 @@ std::ostream& operator<<(std::ostream& os, const PolyImpl<VecType>& p) {
 template <typename VecType>
 void PolyImpl<VecType>::MakeSparse(uint32_t wFactor) {
     static const Integer ZERO(0);
+    DropFormatCache();
     if (m_values != nullptr) {
         uint32_t vlen{m_params->GetRingDimension()};
         for (uint32_t i = 0; i < vlen; ++i) {
@@ -47,14 +47,87 @@
 #include "utils/exception.h"
 #include "utils/inttypes.h"
 
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace lbcrypto {
 
+/**
+ * @brief Counters of the format cache of PolyImpl
+ */
+struct PolyFormatCacheStats {
+    uint64_t transforms{0};         // NTTs and inverse NTTs actually run by SwitchFormat()
+    uint64_t transformsAvoided{0};  // switches served by a cached copy in the requested format
+    uint64_t invalidations{0};      // cached copies dropped because the values were written
+};
+
+/**
+ * @class PolyFormatCache
+ * @brief Process-wide switch and counters of the format cache of PolyImpl.
+ *
+ * While enabled, copying a polynomial attaches a record shared by the source and the copy. SwitchFormat()
+ * on a polynomial with a record saves the values before and after the transform, and a later switch of
+ * the same values to a saved format, by any holder of the record, copies them instead of transforming.
+ * So the clone an operation switches serves the clones of the next operation on the same input. Each
+ * holder keeps the record until its first bulk write: the arithmetic operators, SetValues() and the other
+ * mutators of the whole vector drop it. Element writes through operator[] and at() do not, so they cost
+ * nothing extra in the hot loops; SwitchFormat() instead only serves a saved copy while the values still
+ * equal the ones it was saved from, and drops a record they no longer match. The price is two extra
+ * copies of the values per recorded polynomial, alive as long as one holder is, and a comparison of the
+ * values per recorded switch. Disabling the cache stops new records but does not drop the existing ones.
+ */
+class PolyFormatCache {
+public:
+    static void SetEnabled(bool enabled) {
+        Enabled().store(enabled, std::memory_order_relaxed);
+    }
+
+    static bool IsEnabled() {
+        return Enabled().load(std::memory_order_relaxed);
+    }
+
+    static PolyFormatCacheStats GetStats() {
+        PolyFormatCacheStats stats;
+        stats.transforms        = Counter(0).load(std::memory_order_relaxed);
+        stats.transformsAvoided = Counter(1).load(std::memory_order_relaxed);
+        stats.invalidations     = Counter(2).load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    static void ResetStats() {
+        for (uint32_t i = 0; i < 3; ++i)
+            Counter(i).store(0, std::memory_order_relaxed);
+    }
+
+    static void CountTransform() {
+        Counter(0).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void CountTransformAvoided() {
+        Counter(1).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void CountInvalidation() {
+        Counter(2).fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    static std::atomic<bool>& Enabled() {
+        static std::atomic<bool> enabled{false};
+        return enabled;
+    }
+
+    static std::atomic<uint64_t>& Counter(uint32_t i) {
+        static std::atomic<uint64_t> counters[3]{};
+        return counters[i];
+    }
+};
+
 /**
  * @class PolyImpl
  * @file poly.h
@@ -102,7 +175,8 @@ public:
              typename std::enable_if_t<std::is_same_v<T, NativeVector>, bool> = true)
         : m_format{rhs.m_format},
           m_params{rhs.m_params},
-          m_values{rhs.m_values ? std::make_unique<VecType>(*rhs.m_values) : nullptr} {
+          m_values{rhs.m_values ? std::make_unique<VecType>(*rhs.m_values) : nullptr},
+          m_formats{ShareFormats(rhs)} {
         PolyImpl<VecType>::SetFormat(format);
     }
 
@@ -128,15 +202,29 @@ public:
     PolyImpl(const PolyType& p) noexcept
         : m_format{p.m_format},
           m_params{p.m_params},
-          m_values{p.m_values ? std::make_unique<VecType>(*p.m_values) : nullptr} {}
+          m_values{p.m_values ? std::make_unique<VecType>(*p.m_values) : nullptr},
+          m_formats{ShareFormats(p)} {}
 
     PolyImpl(PolyType&& p) noexcept
-        : m_format{p.m_format}, m_params{std::move(p.m_params)}, m_values{std::move(p.m_values)} {}
+        : m_format{p.m_format},
+          m_params{std::move(p.m_params)},
+          m_values{std::move(p.m_values)},
+          m_formats{std::move(p.m_formats)} {}
 
     PolyType& operator=(const PolyType& rhs) noexcept override;
     PolyType& operator=(PolyType&& rhs) noexcept override {
         m_format = std::move(rhs.m_format);
         m_params = std::move(rhs.m_params);
+        m_formats = std::move(rhs.m_formats);
+        // a tower living in a DCRTPoly slab takes the values in place, so that the slab stays whole
+        if constexpr (std::is_same_v<VecType, NativeVector>) {
+            if (m_values && rhs.m_values && m_values->GetLength() == rhs.m_values->GetLength() &&
+                m_values->GetSlab()) {
+                *m_values = *rhs.m_values;
+                rhs.m_values.reset();
+                return *this;
+            }
+        }
         m_values = std::move(rhs.m_values);
         return *this;
     }
@@ -162,11 +250,21 @@ public:
     void SetValues(VecType&& values, Format format) override;
 
     void SetValuesToZero() override {
+        DropFormatCache();
         usint r{m_params->GetRingDimension()};
+        if constexpr (std::is_same_v<VecType, NativeVector>) {
+            if (m_values && m_values->GetLength() == r && m_values->GetSlab()) {
+                m_values->SetModulus(m_params->GetModulus());
+                for (usint i = 0; i < r; ++i)
+                    (*m_values)[i] = 0;
+                return;
+            }
+        }
         m_values = std::make_unique<VecType>(r, m_params->GetModulus());
     }
 
     void SetValuesToMax() override {
+        DropFormatCache();
         usint r{m_params->GetRingDimension()};
         auto max{m_params->GetModulus() - Integer(1)};
         m_values = std::make_unique<VecType>(r, m_params->GetModulus(), max);
@@ -177,9 +275,24 @@ public:
     }
 
     void OverrideFormat(const Format f) final {
+        DropFormatCache();
         m_format = f;
     }
 
+    /**
+     * @brief Detaches from the formats recorded by SwitchFormat(), see PolyFormatCache.
+     */
+    void DropFormatCache() {
+        if (m_formats) {
+            m_formats.reset();
+            PolyFormatCache::CountInvalidation();
+        }
+    }
+
+    inline bool HasFormatCache() const {
+        return m_formats != nullptr;
+    }
+
     inline const std::shared_ptr<Params>& GetParams() const {
         return m_params;
     }
@@ -221,15 +334,20 @@ public:
             OPENFHE_THROW(math_error, "Modulus missmatch");
         if (m_format != rhs.m_format)
             OPENFHE_THROW(not_implemented_error, "Format missmatch");
-        auto tmp(*this);
+        auto tmp(CopyWithoutFormatCache());
         tmp.m_values->ModAddNoCheckEq(*rhs.m_values);
         return tmp;
     }
     PolyImpl PlusNoCheck(const PolyImpl& rhs) const {
-        auto tmp(*this);
+        auto tmp(CopyWithoutFormatCache());
         tmp.m_values->ModAddNoCheckEq(*rhs.m_values);
         return tmp;
     }
+    PolyImpl& PlusNoCheckEq(const PolyImpl& rhs) {
+        DropFormatCache();
+        m_values->ModAddNoCheckEq(*rhs.m_values);
+        return *this;
+    }
     PolyImpl& operator+=(const PolyImpl& element) override;
 
     PolyImpl Plus(const Integer& element) const override;
@@ -242,6 +360,7 @@ public:
 
     PolyImpl Minus(const Integer& element) const override;
     PolyImpl& operator-=(const Integer& element) override {
+        DropFormatCache();
         m_values->ModSubEq(element);
         return *this;
     }
@@ -253,15 +372,20 @@ public:
             OPENFHE_THROW(math_error, "Modulus missmatch");
         if (m_format != Format::EVALUATION || rhs.m_format != Format::EVALUATION)
             OPENFHE_THROW(not_implemented_error, "operator* for PolyImpl supported only in Format::EVALUATION");
-        auto tmp(*this);
+        auto tmp(CopyWithoutFormatCache());
         tmp.m_values->ModMulNoCheckEq(*rhs.m_values);
         return tmp;
     }
     PolyImpl TimesNoCheck(const PolyImpl& rhs) const {
-        auto tmp(*this);
+        auto tmp(CopyWithoutFormatCache());
         tmp.m_values->ModMulNoCheckEq(*rhs.m_values);
         return tmp;
     }
+    PolyImpl& TimesNoCheckEq(const PolyImpl& rhs) {
+        DropFormatCache();
+        m_values->ModMulNoCheckEq(*rhs.m_values);
+        return *this;
+    }
     PolyImpl& operator*=(const PolyImpl& rhs) override {
         if (m_params->GetRingDimension() != rhs.m_params->GetRingDimension())
             OPENFHE_THROW(math_error, "RingDimension missmatch");
@@ -269,6 +393,7 @@ public:
             OPENFHE_THROW(math_error, "Modulus missmatch");
         if (m_format != Format::EVALUATION || rhs.m_format != Format::EVALUATION)
             OPENFHE_THROW(not_implemented_error, "operator* for PolyImpl supported only in Format::EVALUATION");
+        DropFormatCache();
         if (m_values) {
             m_values->ModMulNoCheckEq(*rhs.m_values);
             return *this;
@@ -279,6 +404,7 @@ public:
 
     PolyImpl Times(const Integer& element) const override;
     PolyImpl& operator*=(const Integer& element) override {
+        DropFormatCache();
         m_values->ModMulEq(element);
         return *this;
     }
@@ -332,6 +458,7 @@ public:
             OPENFHE_THROW(deserialize_error, "serialized object version " + std::to_string(version) +
                                                  " is from a later version of the library");
         }
+        DropFormatCache();
         ar(::cereal::make_nvp("v", m_values));
         ar(::cereal::make_nvp("f", m_format));
         ar(::cereal::make_nvp("p", m_params));
@@ -353,7 +480,36 @@ public:
     Format m_format{Format::EVALUATION};
     std::shared_ptr<Params> m_params{nullptr};
     std::unique_ptr<VecType> m_values{nullptr};
+    // the values in both formats as recorded by SwitchFormat(), shared by the unwritten copies
+    struct FormatRecord {
+        std::mutex mutex;
+        std::shared_ptr<const VecType> values[2];  // indexed by Format
+    };
+    // mutable: copying a polynomial attaches a record to it, see ShareFormats()
+    mutable std::shared_ptr<FormatRecord> m_formats{nullptr};
     void ArbitrarySwitchFormat();
+
+private:
+    // The record of p for a copy of it. While the cache is enabled, p gets an empty one first, so that a
+    // transform run by the copy also serves p and its other copies. Copies of the same p may run
+    // concurrently, hence the atomic accesses; the cache is not meant to be switched on meanwhile.
+    static std::shared_ptr<FormatRecord> ShareFormats(const PolyImpl& p) {
+        if (!PolyFormatCache::IsEnabled())
+            return p.m_formats;
+        auto formats = std::atomic_load(&p.m_formats);
+        if (formats || !p.m_values)
+            return formats;
+        auto fresh = std::make_shared<FormatRecord>();
+        return std::atomic_compare_exchange_strong(&p.m_formats, &formats, fresh) ? fresh : formats;
+    }
+
+    // a copy for a result about to be overwritten, which has no use for the recorded formats
+    PolyImpl CopyWithoutFormatCache() const {
+        PolyImpl tmp(m_params, m_format);
+        if (m_values)
+            tmp.m_values = std::make_unique<VecType>(*m_values);
+        return tmp;
+    }
 };
 
 // TODO: fix issue with pke build system so this can be moved back to implementation file
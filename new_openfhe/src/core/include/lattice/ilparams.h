@@ -44,7 +44,9 @@
 #include "utils/exception.h"
 #include "utils/inttypes.h"
 
+#include <atomic>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 namespace lbcrypto {
@@ -95,7 +97,8 @@ public:
    *
    * @param &rhs the input set of parameters which is copied.
    */
-    ILParamsImpl(const ILParamsImpl& rhs) : ElemParams<IntType>(rhs) {}
+    ILParamsImpl(const ILParamsImpl& rhs)
+        : ElemParams<IntType>(rhs), m_nttTablesId{rhs.m_nttTablesId.load(std::memory_order_acquire)} {}
 
     /**
    * @brief Assignment Operator.
@@ -105,6 +108,7 @@ public:
    */
     ILParamsImpl& operator=(const ILParamsImpl& rhs) {
         ElemParams<IntType>::operator=(rhs);
+        m_nttTablesId.store(rhs.m_nttTablesId.load(std::memory_order_acquire), std::memory_order_release);
         return *this;
     }
 
@@ -113,10 +117,12 @@ public:
    *
    * @param &rhs the input set of parameters which is copied.
    */
-    ILParamsImpl(ILParamsImpl&& rhs) noexcept : ElemParams<IntType>(std::move(rhs)) {}
+    ILParamsImpl(ILParamsImpl&& rhs) noexcept
+        : ElemParams<IntType>(std::move(rhs)), m_nttTablesId{rhs.m_nttTablesId.load(std::memory_order_acquire)} {}
 
     ILParamsImpl& operator=(ILParamsImpl&& rhs) noexcept {
         ElemParams<IntType>::operator=(std::move(rhs));
+        m_nttTablesId.store(rhs.m_nttTablesId.load(std::memory_order_acquire), std::memory_order_release);
         return *this;
     }
 
@@ -150,6 +156,29 @@ public:
                                                  " is from a later version of the library");
         }
         ar(::cereal::base_class<ElemParams<IntType>>(this));
+        m_nttTablesId.store(0, std::memory_order_release);
+    }
+
+    /**
+   * @brief Id of the NTT tables of the modulus and cyclotomic order in the registry of the native
+   * transforms, registered at the first call. The transforms of the polynomials on these parameters use it
+   * to skip the lookup of the tables by modulus. Only for native integers and power-of-two orders.
+   *
+   * @return the id, or 0 if the root of unity is 0 or 1, for which the transforms are the identity.
+   */
+    uint32_t GetNTTTablesId() const {
+        uint32_t id{m_nttTablesId.load(std::memory_order_acquire)};
+        if (id == 0 && this->m_rootOfUnity != IntType(0) && this->m_rootOfUnity != IntType(1)) {
+            if constexpr (std::is_same_v<IntType, NativeInteger>) {
+                id = ChineseRemainderTransformFTT<NativeVector>::RegisterTables(
+                    this->m_rootOfUnity, this->m_cyclotomicOrder, this->m_ciphertextModulus);
+                m_nttTablesId.store(id, std::memory_order_release);
+            }
+            else {
+                OPENFHE_THROW(not_implemented_error, "NTT table ids are only available for native integers");
+            }
+        }
+        return id;
     }
 
     std::string SerializedObjectName() const override {
@@ -160,6 +189,9 @@ public:
     }
 
 private:
+    // 0 until GetNTTTablesId() registers the tables
+    mutable std::atomic<uint32_t> m_nttTablesId{0};
+
     std::ostream& doprint(std::ostream& out) const override {
         out << "ILParams ";
         ElemParams<IntType>::doprint(out);
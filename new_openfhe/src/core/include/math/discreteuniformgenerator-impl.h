@@ -93,6 +93,35 @@ VecType DiscreteUniformGeneratorImpl<VecType>::GenerateVector(const usint size,
     return v;
 }
 
+template <typename VecType>
+VecType DiscreteUniformGeneratorImpl<VecType>::GenerateVectorFromPRNG(const usint size,
+                                                                     const typename VecType::Integer& modulus,
+                                                                     PRNG& prng) {
+    if (modulus == typename VecType::Integer(0))
+        OPENFHE_THROW(math_error, "0 modulus?");
+
+    const uint32_t bits{modulus.GetMSB()};
+    const uint32_t chunks{(bits + CHUNK_WIDTH - 1) / CHUNK_WIDTH};
+    const uint32_t shiftTop{(chunks - 1) * CHUNK_WIDTH};
+    const uint32_t maskTop{(bits - shiftTop == CHUNK_WIDTH) ? CHUNK_MAX : (uint32_t(1) << (bits - shiftTop)) - 1};
+
+    VecType v(size, modulus);
+    for (usint i = 0; i < size; i++) {
+        while (true) {
+            typename VecType::Integer result{};
+            for (uint32_t shift{0}; shift < shiftTop; shift += CHUNK_WIDTH)
+                result += typename VecType::Integer{prng()} << shift;
+            result += typename VecType::Integer{prng() & maskTop} << shiftTop;
+
+            if (result < modulus) {
+                v[i] = result;
+                break;
+            }
+        }
+    }
+    return v;
+}
+
 }  // namespace lbcrypto
 
 #endif
@@ -75,6 +75,14 @@ public:
     VecType GenerateVector(const usint size) const;
     VecType GenerateVector(const usint size, const typename VecType::Integer& modulus);
 
+    /**
+   * @brief Generates a vector of random integers mod modulus from the words of the given engine: each value
+   * takes the low bits of as many words as the modulus length needs and is drawn again if not below the
+   * modulus. The values only depend on the words, so an engine with a known seed reproduces them on any
+   * platform.
+   */
+    static VecType GenerateVectorFromPRNG(const usint size, const typename VecType::Integer& modulus, PRNG& prng);
+
 private:
     static constexpr uint32_t CHUNK_MIN{0};
     static constexpr uint32_t CHUNK_WIDTH{std::numeric_limits<uint32_t>::digits};
@@ -42,6 +42,7 @@
 #include "utils/parallel.h"
 #include "utils/prng/blake2engine.h"
 
+#include <array>
 #include <chrono>
 #include <memory>
 // #include <mutex>
@@ -60,6 +61,9 @@ namespace lbcrypto {
 // the same methods as for the Blake2Engine class.
 typedef Blake2Engine PRNG;
 
+// Seed of a PRNG engine, 512 bits as the seeds of the per-thread engines
+using PRNGSeed = std::array<PRNG::result_type, 16>;
+
 /**
  * @brief The class providing the PRNG capability to all random distribution
  * generators in OpenFHE. THe security of Ring Learning With Errors (used for
@@ -0,0 +1,78 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ This file contains the cache-blocked fast basis conversion of RNS residues for 64-bit native integers
+*/
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_BASISCONVNAT_H
+#define LBCRYPTO_MATH_HAL_INTNAT_BASISCONVNAT_H
+
+#include "math/hal/basicint.h"
+
+#include <cstdint>
+
+#if defined(HAVE_INT128) && NATIVEINT == 64
+
+namespace intnat {
+
+/**
+ * Fast basis conversion of n coefficients from sizeIn moduli q_i to sizeOut moduli p_j, computed as the
+ * product of a sizeOut x sizeIn matrix of constants with the sizeIn x n matrix of residues:
+ *
+ *   out[j][k] = ( sum_i [in[i][k] * scale[i]]_{q_i} * matrix[j * sizeIn + i] ) mod p_j
+ *
+ * The coefficients are processed in tiles whose scaled residues stay in L1 while every output row is
+ * accumulated from them. The sums are kept in 128 bits and reduced once per output (Barrett), and on
+ * CPUs with AVX512IFMA (at GetNTTSimdLevel() AVX512IFMA) moduli below 2^52 accumulate 8 coefficients per
+ * instruction. The output is word for word the one of the coefficient-major loop.
+ *
+ * @param in the sizeIn input residue vectors, each of n words in [0, q_i).
+ * @param moduliIn the q_i.
+ * @param scale the constants the inputs are multiplied by mod q_i first, or nullptr for none.
+ * @param scalePrecon their Shoup precomputations, as NativeInteger::PrepModMulConst().
+ * @param sizeIn the number of input moduli, at most 256 so that the sums fit in 128 bits.
+ * @param matrix the sizeOut x sizeIn constants, row j reduced mod p_j.
+ * @param out the sizeOut output vectors of n words; they may not overlap the inputs.
+ * @param moduliOut the p_j.
+ * @param barrettMu the Barrett constants floor(2^128 / p_j), as for BarrettUint128ModUint64().
+ * @param sizeOut the number of output moduli.
+ * @param n the number of coefficients.
+ */
+void FastBasisConversion(const uint64_t* const* in, const uint64_t* moduliIn, const uint64_t* scale,
+                         const uint64_t* scalePrecon, uint32_t sizeIn, const uint64_t* matrix, uint64_t* const* out,
+                         const uint64_t* moduliOut, const DoubleNativeInt* barrettMu, uint32_t sizeOut, uint32_t n);
+
+}  // namespace intnat
+
+#endif
+
+#endif
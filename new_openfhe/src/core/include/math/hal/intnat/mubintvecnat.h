@@ -45,12 +45,15 @@
 
 #include "utils/exception.h"
 #include "utils/inttypes.h"
+#include "utils/limbslab.h"
 #include "utils/serializable.h"
 
 #include <algorithm>
 #include <initializer_list>
 #include <iostream>
+#include <limits>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -126,7 +129,7 @@ private:
     IntegerType m_modulus{0};
 
 #if BLOCK_VECTOR_ALLOCATION != 1
-    std::vector<IntegerType> m_data{};
+    std::vector<IntegerType, lbcrypto::LimbAllocator<IntegerType>> m_data{};
 #else
     xvector<IntegerType> m_data;
 #endif
@@ -175,6 +178,25 @@ public:
         //                              " bits larger than max modulus bits " + std::to_string(MAX_MODULUS_SIZE));
     }
 
+    /**
+   * Constructor placing the entries in the region of a LimbSlab the allocator is bound to.
+   * Falls back to the heap, and then keeps no reference to the slab, when the region is
+   * already taken or too small.
+   *
+   * @param length is the length of the native vector, in terms of the number of
+   * entries.
+   * @param modulus is the modulus of the ring.
+   * @param alloc is an allocator bound to a tower of a LimbSlab.
+   */
+    NativeVectorT(usint length, const IntegerType& modulus, const lbcrypto::LimbAllocator<IntegerType>& alloc)
+#if BLOCK_VECTOR_ALLOCATION != 1
+        : m_modulus{modulus}, m_data(length, alloc.ForLength(length)) {
+    }
+#else
+        : m_modulus{modulus}, m_data(length) {
+    }
+#endif
+
     /**
    * Basic constructor for copying a vector
    *
@@ -342,6 +364,21 @@ public:
         return m_data.size();
     }
 
+    /**
+   * Gets the slab the entries live in.
+   *
+   * @return the slab, kept alive by this vector, or nullptr if the entries are in ordinary
+   * heap storage.
+   */
+    const lbcrypto::LimbSlab* GetSlab() const {
+#if BLOCK_VECTOR_ALLOCATION != 1
+        const auto& alloc = m_data.get_allocator();
+        if (alloc.Owns(m_data.data()))
+            return alloc.GetSlab();
+#endif
+        return nullptr;
+    }
+
     // MODULAR ARITHMETIC OPERATIONS
 
     /**
@@ -665,6 +702,26 @@ public:
         Archive& ar, std::uint32_t const version) const {
         ::cereal::size_type size = m_data.size();
         ar(size);
+        if constexpr (PACKED_SERIALIZATION) {
+            if (version >= 2) {
+                // the values are bit-packed at the length of the largest one, which is at most the modulus
+                // length when they are reduced
+                ar(m_modulus);
+                if (size > 0) {
+                    NativeInt all{0};
+                    for (const auto& v : m_data)
+                        all |= v.ConvertToInt();
+                    const auto bits = static_cast<uint8_t>(lbcrypto::GetMSB(all));
+                    ar(bits);
+                    NativeInt words[PACK_CHUNK];
+                    for (size_t i = 0; i < size; i += PACK_CHUNK) {
+                        size_t count = PackValues(&m_data[i], std::min<size_t>(PACK_CHUNK, size - i), bits, words);
+                        ar(::cereal::binary_data(words, count * sizeof(NativeInt)));
+                    }
+                }
+                return;
+            }
+        }
         if (size > 0) {
             ar(::cereal::binary_data(m_data.data(), size * sizeof(IntegerType)));
         }
@@ -688,13 +745,27 @@ public:
         ::cereal::size_type size;
         ar(size);
         m_data.resize(size);
-        if (size > 0) {
-            auto* data = reinterpret_cast<IntegerType*>(malloc(size * sizeof(IntegerType)));
-            ar(::cereal::binary_data(data, size * sizeof(IntegerType)));
-            for (::cereal::size_type i = 0; i < size; i++) {
-                m_data[i] = data[i];
+        if constexpr (PACKED_SERIALIZATION) {
+            if (version >= 2) {
+                ar(m_modulus);
+                if (size > 0) {
+                    uint8_t bits;
+                    ar(bits);
+                    if (bits > std::numeric_limits<NativeInt>::digits)
+                        OPENFHE_THROW(lbcrypto::deserialize_error, "invalid bit length of packed values");
+                    // read and unpacked a chunk at a time, straight into the entries
+                    NativeInt words[PACK_CHUNK];
+                    for (size_t i = 0; i < size; i += PACK_CHUNK) {
+                        size_t count = std::min<size_t>(PACK_CHUNK, size - i);
+                        ar(::cereal::binary_data(words, PackedWords(count, bits) * sizeof(NativeInt)));
+                        UnpackValues(words, count, bits, &m_data[i]);
+                    }
+                }
+                return;
             }
-            free(data);
+        }
+        if (size > 0) {
+            ar(::cereal::binary_data(m_data.data(), size * sizeof(IntegerType)));
         }
         ar(m_modulus);
     }
@@ -714,8 +785,66 @@ public:
         return "NativeVectorT";
     }
 
+    // version 2 bit-packs the values in binary archives
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
+    }
+
+private:
+    using NativeInt = typename IntegerType::Integer;
+
+    // packing is defined for 64-bit words; the other widths keep the version 1 layout
+    static constexpr bool PACKED_SERIALIZATION{std::is_same_v<NativeInt, uint64_t>};
+
+    // values packed at a time: PACK_CHUNK values of any length fill a whole number of words, so the chunks
+    // concatenate to the packing of the whole vector
+    static constexpr size_t PACK_CHUNK{1024};
+
+    static constexpr size_t PackedWords(size_t count, uint32_t bits) {
+        return (count * bits + std::numeric_limits<NativeInt>::digits - 1) / std::numeric_limits<NativeInt>::digits;
+    }
+
+    // packs the low bits of count values into consecutive words, least significant bits first
+    static size_t PackValues(const IntegerType* values, size_t count, uint32_t bits, NativeInt* words) {
+        constexpr uint32_t digits{std::numeric_limits<NativeInt>::digits};
+        size_t w{0};
+        NativeInt acc{0};
+        uint32_t fill{0};
+        for (size_t i = 0; i < count && bits > 0; ++i) {
+            const NativeInt x{values[i].ConvertToInt()};
+            acc |= x << fill;
+            fill += bits;
+            if (fill >= digits) {
+                words[w++] = acc;
+                fill -= digits;
+                acc = fill ? x >> (bits - fill) : 0;
+            }
+        }
+        if (fill)
+            words[w++] = acc;
+        return w;
+    }
+
+    static void UnpackValues(const NativeInt* words, size_t count, uint32_t bits, IntegerType* values) {
+        constexpr uint32_t digits{std::numeric_limits<NativeInt>::digits};
+        if (bits == 0) {
+            std::fill(values, values + count, IntegerType(0));
+            return;
+        }
+        const NativeInt mask{bits == digits ? ~NativeInt(0) : (NativeInt(1) << bits) - 1};
+        size_t w{0};
+        uint32_t pos{0};
+        for (size_t i = 0; i < count; ++i) {
+            NativeInt x{words[w] >> pos};
+            pos += bits;
+            if (pos >= digits) {
+                pos -= digits;
+                ++w;
+                if (pos)
+                    x |= words[w] << (bits - pos);
+            }
+            values[i] = x & mask;
+        }
     }
 };
 
@@ -40,40 +40,26 @@
 #include "math/hal/intnat/ubintnat.h"
 #include "math/hal/intnat/mubintvecnat.h"
 #include "math/hal/intnat/transformnat.h"
+#include "math/hal/intnat/transformnat-simd.h"
 #include "math/nbtheory.h"
 
 #include "utils/exception.h"
 #include "utils/inttypes.h"
 #include "utils/utilities.h"
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace intnat {
 
 template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_cycloOrderInverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_cycloOrderInversePreconTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityReverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityInverseReverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityPreconReverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityInversePreconReverseTableByModulus;
+std::atomic<std::atomic<const NTTTables<VecType>*>*>
+    ChineseRemainderTransformFTTNat<VecType>::m_tableSegments[ChineseRemainderTransformFTTNat<VecType>::MAX_SEGMENTS];
 
 template <typename VecType>
 std::map<typename VecType::Integer, VecType> ChineseRemainderTransformArbNat<VecType>::m_cyclotomicPolyMap;
@@ -301,6 +287,16 @@ void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlace(c
                                                                                const VecType& preconRootOfUnityTable,
                                                                                VecType* element) {
     auto modulus{element->GetModulus()};
+    if constexpr (std::is_same<typename IntType::Integer, uint64_t>::value) {
+        // the AVX2/AVX-512 butterflies when the CPU has them (transformnat-simd.h), same output
+        static_assert(sizeof(IntType) == sizeof(uint64_t), "the vector kernels read NativeIntegers as words");
+        if (element->GetLength() != 0 &&
+            ForwardTransformToBitReverseSimd(reinterpret_cast<uint64_t*>(&(*element)[0]),
+                                             reinterpret_cast<const uint64_t*>(&rootOfUnityTable[0]),
+                                             reinterpret_cast<const uint64_t*>(&preconRootOfUnityTable[0]),
+                                             modulus.ConvertToInt(), element->GetLength()))
+            return;
+    }
     uint32_t n(element->GetLength() >> 1), t{n}, logt{lbcrypto::GetMSB(t)};
     for (uint32_t m{1}; m < n; m <<= 1, t >>= 1, --logt) {
         for (uint32_t i{0}; i < m; ++i) {
@@ -493,6 +489,16 @@ void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlace
     const VecType& rootOfUnityInverseTable, const VecType& preconRootOfUnityInverseTable, const IntType& cycloOrderInv,
     const IntType& preconCycloOrderInv, VecType* element) {
     auto modulus{element->GetModulus()};
+    if constexpr (std::is_same<typename IntType::Integer, uint64_t>::value) {
+        static_assert(sizeof(IntType) == sizeof(uint64_t), "the vector kernels read NativeIntegers as words");
+        if (element->GetLength() != 0 &&
+            InverseTransformFromBitReverseSimd(reinterpret_cast<uint64_t*>(&(*element)[0]),
+                                               reinterpret_cast<const uint64_t*>(&rootOfUnityInverseTable[0]),
+                                               reinterpret_cast<const uint64_t*>(&preconRootOfUnityInverseTable[0]),
+                                               cycloOrderInv.ConvertToInt(), preconCycloOrderInv.ConvertToInt(),
+                                               modulus.ConvertToInt(), element->GetLength()))
+            return;
+    }
     uint32_t n(element->GetLength());
     for (uint32_t i{0}; i < n; i += 2) {
         auto omega{rootOfUnityInverseTable[(i + n) >> 1]};
@@ -571,6 +577,142 @@ void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverse(
     return;
 }
 
+/**
+ * The registrations of ChineseRemainderTransformFTTNat: the ids by modulus and cyclotomic order, and the
+ * storage of the tables and of the segments that publish them.
+ */
+template <typename VecType>
+struct NTTTablesRegistry {
+    using IntType = typename VecType::Integer;
+
+    std::shared_mutex mutex;
+    std::map<std::pair<IntType, usint>, uint32_t> ids;
+    // id 0 stands for no tables
+    std::vector<std::unique_ptr<const NTTTables<VecType>>> tables{1};
+    std::vector<std::unique_ptr<std::atomic<const NTTTables<VecType>*>[]>> segments;
+
+    static NTTTablesRegistry& Get() {
+        static NTTTablesRegistry registry;
+        return registry;
+    }
+};
+
+template <typename VecType>
+uint32_t ChineseRemainderTransformFTTNat<VecType>::RegisterTables(const IntType& rootOfUnity, const usint CycloOrder,
+                                                                  const IntType& modulus) {
+    if (!lbcrypto::IsPowerOfTwo(CycloOrder)) {
+        OPENFHE_THROW(lbcrypto::math_error, "CyclotomicOrder is not a power of two");
+    }
+
+    auto& registry{NTTTablesRegistry<VecType>::Get()};
+    const std::pair<IntType, usint> key{modulus, CycloOrder};
+    {
+        std::shared_lock<std::shared_mutex> lock(registry.mutex);
+        auto it = registry.ids.find(key);
+        if (it != registry.ids.end())
+            return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(registry.mutex);
+    auto it = registry.ids.find(key);
+    if (it != registry.ids.end())
+        return it->second;
+
+    uint32_t id = registry.tables.size();
+    if (id / TABLES_PER_SEGMENT >= MAX_SEGMENTS) {
+        OPENFHE_THROW(lbcrypto::math_error, "too many moduli and cyclotomic orders for the NTT table registry");
+    }
+
+    // Half of cyclo order
+    usint CycloOrderHf = (CycloOrder >> 1);
+    usint msb          = lbcrypto::GetMSB(CycloOrderHf - 1);
+
+    auto t         = std::make_unique<NTTTables<VecType>>();
+    t->modulus     = modulus;
+    t->rootOfUnity = rootOfUnity;
+    t->cycloOrder  = CycloOrder;
+
+    IntType x(1), xinv(1);
+    IntType mu = modulus.ComputeMu();
+    VecType Table(CycloOrderHf, modulus);
+    VecType TableI(CycloOrderHf, modulus);
+    IntType rootOfUnityInverse = rootOfUnity.ModInverse(modulus);
+    usint iinv;
+    for (usint i = 0; i < CycloOrderHf; i++) {
+        iinv         = lbcrypto::ReverseBits(i, msb);
+        Table[iinv]  = x;
+        TableI[iinv] = xinv;
+        x.ModMulEq(rootOfUnity, modulus, mu);
+        xinv.ModMulEq(rootOfUnityInverse, modulus, mu);
+    }
+
+    NativeInteger nativeModulus = modulus.ConvertToInt();
+    VecType preconTable(CycloOrderHf, nativeModulus);
+    VecType preconTableI(CycloOrderHf, nativeModulus);
+    for (usint i = 0; i < CycloOrderHf; i++) {
+        preconTable[i]  = NativeInteger(Table[i].ConvertToInt()).PrepModMulConst(nativeModulus);
+        preconTableI[i] = NativeInteger(TableI[i].ConvertToInt()).PrepModMulConst(nativeModulus);
+    }
+
+    t->rootOfUnityReverse              = std::move(Table);
+    t->rootOfUnityInverseReverse       = std::move(TableI);
+    t->rootOfUnityPreconReverse        = std::move(preconTable);
+    t->rootOfUnityInversePreconReverse = std::move(preconTableI);
+    t->cycloOrderInverse               = IntType(1 << msb).ModInverse(modulus);
+    t->cycloOrderInversePrecon =
+        NativeInteger(t->cycloOrderInverse.ConvertToInt()).PrepModMulConst(nativeModulus).ConvertToInt();
+
+    auto* segment{m_tableSegments[id / TABLES_PER_SEGMENT].load(std::memory_order_relaxed)};
+    if (segment == nullptr) {
+        registry.segments.emplace_back(new std::atomic<const NTTTables<VecType>*>[TABLES_PER_SEGMENT]());
+        segment = registry.segments.back().get();
+        m_tableSegments[id / TABLES_PER_SEGMENT].store(segment, std::memory_order_release);
+    }
+    segment[id % TABLES_PER_SEGMENT].store(t.get(), std::memory_order_release);
+    registry.tables.push_back(std::move(t));
+    registry.ids.emplace(key, id);
+    return id;
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlace(uint32_t tablesId,
+                                                                                   VecType* element) {
+    if (tablesId == 0) {
+        return;
+    }
+
+    const auto& t{GetTables(tablesId)};
+    if (element->GetLength() != t.rootOfUnityReverse.GetLength()) {
+        OPENFHE_THROW(lbcrypto::math_error, "element size must be equal to CyclotomicOrder / 2");
+    }
+    if (element->GetModulus() != t.modulus) {
+        OPENFHE_THROW(lbcrypto::math_error, "element modulus does not match the modulus of the tables");
+    }
+
+    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlace(t.rootOfUnityReverse,
+                                                                               t.rootOfUnityPreconReverse, element);
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInPlace(uint32_t tablesId,
+                                                                                     VecType* element) {
+    if (tablesId == 0) {
+        return;
+    }
+
+    const auto& t{GetTables(tablesId)};
+    if (element->GetLength() != t.rootOfUnityInverseReverse.GetLength()) {
+        OPENFHE_THROW(lbcrypto::math_error, "element size must be equal to CyclotomicOrder / 2");
+    }
+    if (element->GetModulus() != t.modulus) {
+        OPENFHE_THROW(lbcrypto::math_error, "element modulus does not match the modulus of the tables");
+    }
+
+    NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
+        t.rootOfUnityInverseReverse, t.rootOfUnityInversePreconReverse, t.cycloOrderInverse,
+        t.cycloOrderInversePrecon, element);
+}
+
 template <typename VecType>
 void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlace(const IntType& rootOfUnity,
                                                                                    const usint CycloOrder,
@@ -588,15 +730,9 @@ void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPla
         OPENFHE_THROW(lbcrypto::math_error, "element size must be equal to CyclotomicOrder / 2");
     }
 
-    IntType modulus = element->GetModulus();
-
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
-
-    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlace(
-        m_rootOfUnityReverseTableByModulus[modulus], m_rootOfUnityPreconReverseTableByModulus[modulus], element);
+    const auto& t{GetTables(RegisterTables(rootOfUnity, CycloOrder, element->GetModulus()))};
+    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlace(t.rootOfUnityReverse,
+                                                                               t.rootOfUnityPreconReverse, element);
 }
 
 template <typename VecType>
@@ -617,16 +753,9 @@ void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverse(cons
         OPENFHE_THROW(lbcrypto::math_error, "result size must be equal to CyclotomicOrder / 2");
     }
 
-    IntType modulus = element.GetModulus();
-
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
-
-    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverse(
-        element, m_rootOfUnityReverseTableByModulus[modulus], m_rootOfUnityPreconReverseTableByModulus[modulus],
-        result);
+    const auto& t{GetTables(RegisterTables(rootOfUnity, CycloOrder, element.GetModulus()))};
+    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverse(element, t.rootOfUnityReverse,
+                                                                        t.rootOfUnityPreconReverse, result);
 
     return;
 }
@@ -648,18 +777,10 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInP
         OPENFHE_THROW(lbcrypto::math_error, "element size must be equal to CyclotomicOrder / 2");
     }
 
-    IntType modulus = element->GetModulus();
-
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
-
-    usint msb = lbcrypto::GetMSB(CycloOrderHf - 1);
+    const auto& t{GetTables(RegisterTables(rootOfUnity, CycloOrder, element->GetModulus()))};
     NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
-        m_rootOfUnityInverseReverseTableByModulus[modulus], m_rootOfUnityInversePreconReverseTableByModulus[modulus],
-        m_cycloOrderInverseTableByModulus[modulus][msb], m_cycloOrderInversePreconTableByModulus[modulus][msb],
-        element);
+        t.rootOfUnityInverseReverse, t.rootOfUnityInversePreconReverse, t.cycloOrderInverse,
+        t.cycloOrderInversePrecon, element);
 }
 
 template <typename VecType>
@@ -680,12 +801,7 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverse(co
         OPENFHE_THROW(lbcrypto::math_error, "result size must be equal to CyclotomicOrder / 2");
     }
 
-    IntType modulus = element.GetModulus();
-
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
+    const auto& t{GetTables(RegisterTables(rootOfUnity, CycloOrder, element.GetModulus()))};
 
     usint n = element.GetLength();
     result->SetModulus(element.GetModulus());
@@ -693,10 +809,9 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverse(co
         (*result)[i] = element[i];
     }
 
-    usint msb = lbcrypto::GetMSB(CycloOrderHf - 1);
     NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
-        m_rootOfUnityInverseReverseTableByModulus[modulus], m_rootOfUnityInversePreconReverseTableByModulus[modulus],
-        m_cycloOrderInverseTableByModulus[modulus][msb], m_cycloOrderInversePreconTableByModulus[modulus][msb], result);
+        t.rootOfUnityInverseReverse, t.rootOfUnityInversePreconReverse, t.cycloOrderInverse,
+        t.cycloOrderInversePrecon, result);
 
     return;
 }
@@ -704,59 +819,7 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverse(co
 template <typename VecType>
 void ChineseRemainderTransformFTTNat<VecType>::PreCompute(const IntType& rootOfUnity, const usint CycloOrder,
                                                           const IntType& modulus) {
-    // Half of cyclo order
-    usint CycloOrderHf = (CycloOrder >> 1);
-
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-#pragma omp critical
-        {
-            IntType x(1), xinv(1);
-            usint msb  = lbcrypto::GetMSB(CycloOrderHf - 1);
-            IntType mu = modulus.ComputeMu();
-            VecType Table(CycloOrderHf, modulus);
-            VecType TableI(CycloOrderHf, modulus);
-            IntType rootOfUnityInverse = rootOfUnity.ModInverse(modulus);
-            usint iinv;
-            for (usint i = 0; i < CycloOrderHf; i++) {
-                iinv         = lbcrypto::ReverseBits(i, msb);
-                Table[iinv]  = x;
-                TableI[iinv] = xinv;
-                x.ModMulEq(rootOfUnity, modulus, mu);
-                xinv.ModMulEq(rootOfUnityInverse, modulus, mu);
-            }
-            m_rootOfUnityReverseTableByModulus[modulus]        = Table;
-            m_rootOfUnityInverseReverseTableByModulus[modulus] = TableI;
-
-            VecType TableCOI(msb + 1, modulus);
-            for (usint i = 0; i < msb + 1; i++) {
-                IntType coInv(IntType(1 << i).ModInverse(modulus));
-                TableCOI[i] = coInv;
-            }
-            m_cycloOrderInverseTableByModulus[modulus] = TableCOI;
-
-            NativeInteger nativeModulus = modulus.ConvertToInt();
-            VecType preconTable(CycloOrderHf, nativeModulus);
-            VecType preconTableI(CycloOrderHf, nativeModulus);
-
-            for (usint i = 0; i < CycloOrderHf; i++) {
-                preconTable[i] = NativeInteger(m_rootOfUnityReverseTableByModulus[modulus][i].ConvertToInt())
-                                     .PrepModMulConst(nativeModulus);
-                preconTableI[i] = NativeInteger(m_rootOfUnityInverseReverseTableByModulus[modulus][i].ConvertToInt())
-                                      .PrepModMulConst(nativeModulus);
-            }
-
-            VecType preconTableCOI(msb + 1, nativeModulus);
-            for (usint i = 0; i < msb + 1; i++) {
-                preconTableCOI[i] = NativeInteger(m_cycloOrderInverseTableByModulus[modulus][i].ConvertToInt())
-                                        .PrepModMulConst(nativeModulus);
-            }
-
-            m_rootOfUnityPreconReverseTableByModulus[modulus]        = preconTable;
-            m_rootOfUnityInversePreconReverseTableByModulus[modulus] = preconTableI;
-            m_cycloOrderInversePreconTableByModulus[modulus]         = preconTableCOI;
-        }
-    }
+    RegisterTables(rootOfUnity, CycloOrder, modulus);
 }
 
 template <typename VecType>
@@ -778,12 +841,9 @@ void ChineseRemainderTransformFTTNat<VecType>::PreCompute(std::vector<IntType>&
 
 template <typename VecType>
 void ChineseRemainderTransformFTTNat<VecType>::Reset() {
-    m_cycloOrderInverseTableByModulus.clear();
-    m_cycloOrderInversePreconTableByModulus.clear();
-    m_rootOfUnityReverseTableByModulus.clear();
-    m_rootOfUnityInverseReverseTableByModulus.clear();
-    m_rootOfUnityPreconReverseTableByModulus.clear();
-    m_rootOfUnityInversePreconReverseTableByModulus.clear();
+    auto& registry{NTTTablesRegistry<VecType>::Get()};
+    std::unique_lock<std::shared_mutex> lock(registry.mutex);
+    registry.ids.clear();
 }
 
 template <typename VecType>
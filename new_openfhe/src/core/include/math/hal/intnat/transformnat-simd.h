@@ -0,0 +1,107 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ This file contains the runtime-dispatched vector kernels of the negacyclic NTT for 64-bit native integers
+*/
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_H
+#define LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_H
+
+#include <cstdint>
+#include <ostream>
+
+namespace intnat {
+
+/**
+ * @brief Instruction sets the NTT of NumberTheoreticTransformNat can run on, in increasing order.
+ * SCALAR is the portable loop of transformnat-impl.h.
+ */
+enum class NTTSimdLevel { SCALAR = 0, AVX2, AVX512, AVX512IFMA };
+
+std::ostream& operator<<(std::ostream& os, NTTSimdLevel level);
+
+/**
+ * The best level both the library build and the running CPU support.
+ */
+NTTSimdLevel GetNTTSimdLevelSupported();
+
+/**
+ * The level the transforms currently use; GetNTTSimdLevelSupported() unless changed.
+ */
+NTTSimdLevel GetNTTSimdLevel();
+
+/**
+ * Selects the level the transforms use, for all threads. A level the build or the CPU does not support
+ * is lowered to GetNTTSimdLevelSupported().
+ *
+ * @param level the requested level; SCALAR disables the vector kernels.
+ */
+void SetNTTSimdLevel(NTTSimdLevel level);
+
+/**
+ * In-place forward negacyclic NTT with bit-reversed output, the vector counterpart of
+ * NumberTheoreticTransformNat::ForwardTransformToBitReverseInPlace() with Shoup precomputations.
+ * The butterflies are Harvey's lazy ones, with values kept in [0, 4q) between stages and fully
+ * reduced at the end, so the output is the one of the scalar loop word for word.
+ *
+ * @param element[in,out] the n coefficients, in [0, modulus).
+ * @param rootOfUnityTable the n powers of the 2n-th root of unity in bit-reversed order.
+ * @param preconRootOfUnityTable their Shoup precomputations floor(w * 2^64 / modulus).
+ * @param modulus the prime modulus.
+ * @param n the ring dimension, a power of two.
+ * @return false, leaving \p element untouched, if the active level, the modulus (below 2^61, below
+ * 2^50 for IFMA) or the ring dimension rule the vector kernels out.
+ */
+bool ForwardTransformToBitReverseSimd(uint64_t* element, const uint64_t* rootOfUnityTable,
+                                      const uint64_t* preconRootOfUnityTable, uint64_t modulus, uint32_t n);
+
+/**
+ * In-place inverse negacyclic NTT from bit-reversed input, the vector counterpart of
+ * NumberTheoreticTransformNat::InverseTransformFromBitReverseInPlace() with Shoup precomputations,
+ * including the scaling by cycloOrderInv. Values stay in [0, 2q) between stages.
+ *
+ * @param element[in,out] the n coefficients, in [0, modulus).
+ * @param rootOfUnityInverseTable the n inverse powers of the root of unity in bit-reversed order.
+ * @param preconRootOfUnityInverseTable their Shoup precomputations.
+ * @param cycloOrderInv n^-1 mod modulus.
+ * @param preconCycloOrderInv its Shoup precomputation.
+ * @param modulus the prime modulus.
+ * @param n the ring dimension, a power of two.
+ * @return false, leaving \p element untouched, under the conditions of ForwardTransformToBitReverseSimd().
+ */
+bool InverseTransformFromBitReverseSimd(uint64_t* element, const uint64_t* rootOfUnityInverseTable,
+                                        const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                        uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t n);
+
+}  // namespace intnat
+
+#endif
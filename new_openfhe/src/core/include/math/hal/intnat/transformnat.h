@@ -40,6 +40,7 @@
 
 #include "utils/inttypes.h"
 
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <unordered_map>
@@ -241,6 +242,31 @@ public:
                                                VecType* element);
 };
 
+/**
+ * @brief The tables of the negacyclic NTT modulo one prime for one cyclotomic order, as registered by
+ * ChineseRemainderTransformFTTNat::RegisterTables(). They are never modified once registered.
+ */
+template <typename VecType>
+struct NTTTables {
+    using IntType = typename VecType::Integer;
+
+    IntType modulus;
+    IntType rootOfUnity;
+    usint cycloOrder;
+
+    /// powers of the root of unity in bit-reversed order (the twiddle factors) and their Shoup precomputations
+    VecType rootOfUnityReverse;
+    VecType rootOfUnityPreconReverse;
+
+    /// the same for the inverse of the root of unity
+    VecType rootOfUnityInverseReverse;
+    VecType rootOfUnityInversePreconReverse;
+
+    /// (cycloOrder / 2)^-1 mod modulus, which scales the inverse transform, and its Shoup precomputation
+    IntType cycloOrderInverse;
+    IntType cycloOrderInversePrecon;
+};
+
 /**
  * @brief Golden Chinese Remainder Transform FFT implementation.
  */
@@ -318,9 +344,50 @@ public:
    */
     void InverseTransformFromBitReverseInPlace(const IntType& rootOfUnity, const usint CycloOrder, VecType* element);
 
+    /**
+   * In-place Forward Transform with the tables of an id of RegisterTables(), which skips their lookup by
+   * modulus.
+   *
+   * @param tablesId the id of the tables; 0 leaves \p element untouched, as a root of unity of 0 or 1.
+   * @param[in,out] &element is the input to the transform, of the modulus and length of the tables.
+   * @see ForwardTransformToBitReverseInPlace(const IntType&, const usint, VecType*)
+   */
+    void ForwardTransformToBitReverseInPlace(uint32_t tablesId, VecType* element);
+
+    /**
+   * In-place Inverse Transform with the tables of an id of RegisterTables(), which skips their lookup by
+   * modulus.
+   *
+   * @param tablesId the id of the tables; 0 leaves \p element untouched, as a root of unity of 0 or 1.
+   * @param[in,out] &element is the input to the transform, of the modulus and length of the tables.
+   * @see InverseTransformFromBitReverseInPlace(const IntType&, const usint, VecType*)
+   */
+    void InverseTransformFromBitReverseInPlace(uint32_t tablesId, VecType* element);
+
+    /**
+   * Registers the tables of the transforms modulo \p modulus for \p CycloOrder, computing them if no call
+   * did before, and returns their id. Safe to call from any thread. The tables of an id are immutable and
+   * live as long as the process, so the transforms by id read them with no lock and no lookup; the
+   * ILNativeParams keep the id of their modulus (ILParamsImpl::GetNTTTablesId()).
+   *
+   * @param &rootOfUnity is the 2n-th root of unity in Z_q, used if the tables are computed by this call.
+   * @param CycloOrder is a power-of-two, equal to 2n.
+   * @param &modulus is q, the prime modulus
+   * @return the id of the tables, never 0.
+   */
+    static uint32_t RegisterTables(const IntType& rootOfUnity, const usint CycloOrder, const IntType& modulus);
+
+    /**
+   * The tables of an id returned by RegisterTables(). Lock-free.
+   */
+    static const NTTTables<VecType>& GetTables(uint32_t tablesId) {
+        const auto* segment{m_tableSegments[tablesId / TABLES_PER_SEGMENT].load(std::memory_order_acquire)};
+        return *segment[tablesId % TABLES_PER_SEGMENT].load(std::memory_order_acquire);
+    }
+
     /**
    * Precomputation of root of unity tables for transforms in the ring
-   * Z_q[X]/(X^n+1)
+   * Z_q[X]/(X^n+1), that is RegisterTables().
    *
    * @param &rootOfUnity is the 2n-th root of unity in Z_q. Used to precompute
    * the root of unity tables if needed. If rootOfUnity == 0 or 1, then the
@@ -343,29 +410,18 @@ public:
     void PreCompute(std::vector<IntType>& rootOfUnity, const usint CycloOrder, std::vector<IntType>& moduliChain);
 
     /**
-   * Reset cached values for the root of unity tables to empty.
+   * Forgets the ids of the moduli, so that the next registrations compute their tables again. The tables
+   * registered so far stay valid, since parameters may keep their ids.
    */
     void Reset();
 
-    /// map to store the cyclo order inverse with modulus as a key
-    /// For inverse FTT, we also need #m_cycloOrderInversePreconTableByModulus (this is to use an N-size NTT for FTT instead of 2N-size NTT).
-    static std::map<IntType, VecType> m_cycloOrderInverseTableByModulus;
-
-    /// map to store the cyclo order inverse preconditioned with modulus as a key
-    /// Shoup's precomputation of above #m_cycloOrderInverseTableByModulus
-    static std::map<IntType, VecType> m_cycloOrderInversePreconTableByModulus;
-
-    /// map to store the forward roots of Unity for NTT, with bits reversed, with modulus as a key (aka twiddle factors)
-    static std::map<IntType, VecType> m_rootOfUnityReverseTableByModulus;
-
-    /// map to store inverse roots of unity for iNTT, with bits reversed, with modulus as a key (aka inverse twiddle factors)
-    static std::map<IntType, VecType> m_rootOfUnityInverseReverseTableByModulus;
-
-    /// map to store Shoup's precomputations of forward roots of unity for NTT, with bits reversed, with modulus as a key
-    static std::map<IntType, VecType> m_rootOfUnityPreconReverseTableByModulus;
+private:
+    static constexpr uint32_t TABLES_PER_SEGMENT = 256;
+    static constexpr uint32_t MAX_SEGMENTS       = 4096;
 
-    /// map to store Shoup's precomputations of inverse rou for iNTT, with bits reversed, with modulus as a key
-    static std::map<IntType, VecType> m_rootOfUnityInversePreconReverseTableByModulus;
+    /// registered tables, id i at [i / TABLES_PER_SEGMENT][i % TABLES_PER_SEGMENT]; a segment is allocated
+    /// by the registration that needs it and never moves, so the readers need no lock
+    static std::atomic<std::atomic<const NTTTables<VecType>*>*> m_tableSegments[MAX_SEGMENTS];
 };
 
 // struct used as a key in BlueStein transform
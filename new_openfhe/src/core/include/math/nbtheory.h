@@ -479,6 +479,16 @@ uint32_t FindAutomorphismIndexCyclic(int32_t i, uint32_t m, uint32_t g);
  */
 void PrecomputeAutoMap(uint32_t n, uint32_t k, std::vector<uint32_t>* precomp);
 
+/**
+ * Returns the bit reversal map of PrecomputeAutoMap for a specific automorphism. The map of (n, k) is computed
+ * at the first request and kept for the life of the process; the maps are immutable and shared by all threads.
+ * Key generation requests the maps of its automorphism indices, so evaluation finds them already built.
+ * @param n ring dimension, a power of two
+ * @param k automorphism index
+ * @return the precomputed table
+ */
+const std::vector<uint32_t>& GetAutoMap(uint32_t n, uint32_t k);
+
 }  // namespace lbcrypto
 
 #endif
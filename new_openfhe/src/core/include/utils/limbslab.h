@@ -0,0 +1,264 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Limb-major slab storage shared by the towers of a DCRTPoly
+ */
+
+#ifndef LBCRYPTO_UTILS_LIMBSLAB_H
+#define LBCRYPTO_UTILS_LIMBSLAB_H
+
+#include "utils/inttypes.h"
+#include "utils/scratchpool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace lbcrypto {
+
+template <typename T>
+class LimbAllocator;
+
+/**
+ * @brief One 64-byte aligned block of numTowers x ringDim 64-bit words, tower i at offset
+ * i * ringDim. Each tower region is handed to at most one vector at a time; a vector that
+ * outgrows it or asks for it while it is taken falls back to the heap. The block comes from
+ * and returns to ScratchPool, so slabs of the same size are recycled per thread.
+ *
+ * The slab is freed with the last reference to it: the Handle of its creator and one per
+ * LimbAllocator bound to one of its towers.
+ */
+class LimbSlab {
+public:
+    static constexpr size_t Alignment = ScratchPool::Alignment;
+
+    struct Unref {
+        void operator()(LimbSlab* slab) const noexcept {
+            slab->DropRef();
+        }
+    };
+    // the reference of the creator of a slab
+    using Handle = std::unique_ptr<LimbSlab, Unref>;
+
+    static Handle Create(usint ringDim, usint numTowers) {
+        return Handle(new LimbSlab(ringDim, numTowers));
+    }
+
+    LimbSlab(const LimbSlab&)            = delete;
+    LimbSlab& operator=(const LimbSlab&) = delete;
+
+    uint64_t* Data() const {
+        return m_data;
+    }
+
+    uint64_t* Tower(usint i) const {
+        return m_data + static_cast<size_t>(i) * m_ringDim;
+    }
+
+    usint GetRingDimension() const {
+        return m_ringDim;
+    }
+
+    usint GetNumTowers() const {
+        return m_numTowers;
+    }
+
+    // towers may be claimed and released from several threads; a tower goes to one claimant at a time
+    bool Claim(usint i) {
+        bool free{false};
+        return i < m_numTowers && m_regions[i].claimed.compare_exchange_strong(free, true, std::memory_order_acquire);
+    }
+
+    void Release(usint i) {
+        m_regions[i].claimed.store(false, std::memory_order_release);
+    }
+
+private:
+    template <typename T>
+    friend class LimbAllocator;
+
+    // what a bound LimbAllocator points to: the tower and its slab in one word
+    struct Region {
+        LimbSlab* slab;
+        std::atomic<bool> claimed{false};
+    };
+
+    LimbSlab(usint ringDim, usint numTowers)
+        : m_ringDim{ringDim},
+          m_numTowers{numTowers},
+          m_bytes{ScratchPool::RoundUp(static_cast<size_t>(ringDim) * numTowers * sizeof(uint64_t))},
+          m_regions{new Region[numTowers]} {
+        for (usint i = 0; i < numTowers; ++i)
+            m_regions[i].slab = this;
+        m_data = static_cast<uint64_t*>(ScratchPool::Acquire(m_bytes));
+    }
+
+    ~LimbSlab() {
+        ScratchPool::Release(m_data, m_bytes);
+    }
+
+    void AddRef() noexcept {
+        m_refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void DropRef() noexcept {
+        if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete this;
+    }
+
+    uint64_t* m_data{nullptr};
+    usint m_ringDim;
+    usint m_numTowers;
+    size_t m_bytes;
+    std::unique_ptr<Region[]> m_regions;
+    std::atomic<size_t> m_refs{1};
+};
+
+/**
+ * @brief Allocator for the coefficient storage of a NativeVector. A default constructed
+ * allocator uses the heap; one bound to (slab, tower) places the vector in that tower's
+ * region of the slab and keeps the slab alive while the vector uses it.
+ *
+ * The allocator is one pointer, null for the heap, so a vector outside of any slab carries no
+ * reference. Copies of a vector never inherit the binding (select_on_container_copy_construction),
+ * moves and swaps carry it along with the storage.
+ */
+template <typename T>
+class LimbAllocator {
+public:
+    using value_type                             = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    LimbAllocator() noexcept = default;
+
+    LimbAllocator(LimbSlab* slab, usint tower) noexcept : m_region{&slab->m_regions[tower]} {
+        slab->AddRef();
+    }
+
+    LimbAllocator(const LimbAllocator& other) noexcept : m_region{other.m_region} {
+        if (m_region)
+            m_region->slab->AddRef();
+    }
+
+    template <typename U>
+    LimbAllocator(const LimbAllocator<U>& other) noexcept : m_region{other.m_region} {
+        if (m_region)
+            m_region->slab->AddRef();
+    }
+
+    LimbAllocator(LimbAllocator&& other) noexcept : m_region{other.m_region} {
+        other.m_region = nullptr;
+    }
+
+    LimbAllocator& operator=(LimbAllocator other) noexcept {
+        std::swap(m_region, other.m_region);
+        return *this;
+    }
+
+    ~LimbAllocator() {
+        if (m_region)
+            m_region->slab->DropRef();
+    }
+
+    T* allocate(size_t n) {
+        if (Fits(n) && m_region->slab->Claim(GetTower()))
+            return reinterpret_cast<T*>(m_region->slab->Tower(GetTower()));
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        if (Owns(p)) {
+            m_region->slab->Release(GetTower());
+            return;
+        }
+        ::operator delete(p);
+    }
+
+    LimbAllocator select_on_container_copy_construction() const noexcept {
+        return LimbAllocator();
+    }
+
+    /**
+     * The allocator for a vector of n entries: this one if its tower region can take them now,
+     * otherwise the heap, so that a vector which would not end up in the slab holds no reference.
+     */
+    LimbAllocator ForLength(size_t n) const noexcept {
+        if (Fits(n) && !m_region->claimed.load(std::memory_order_relaxed))
+            return *this;
+        return LimbAllocator();
+    }
+
+    // true if p is the start of the slab region this allocator is bound to
+    bool Owns(const T* p) const noexcept {
+        return m_region && p != nullptr && p == reinterpret_cast<const T*>(m_region->slab->Tower(GetTower()));
+    }
+
+    // the slab this allocator is bound to, kept alive by it; nullptr for the heap
+    const LimbSlab* GetSlab() const noexcept {
+        return m_region ? m_region->slab : nullptr;
+    }
+
+    usint GetTower() const noexcept {
+        return m_region ? static_cast<usint>(m_region - m_region->slab->m_regions.get()) : 0;
+    }
+
+    // memory from one allocator can only be given back through an allocator with the same binding
+    template <typename U>
+    bool operator==(const LimbAllocator<U>& other) const noexcept {
+        return m_region == other.m_region;
+    }
+
+    template <typename U>
+    bool operator!=(const LimbAllocator<U>& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    template <typename U>
+    friend class LimbAllocator;
+
+    bool Fits(size_t n) const noexcept {
+        return m_region && n * sizeof(T) <= m_region->slab->GetRingDimension() * sizeof(uint64_t);
+    }
+
+    LimbSlab::Region* m_region{nullptr};
+};
+
+}  // namespace lbcrypto
+
+#endif
@@ -108,10 +108,12 @@ public:
 #endif
     }
 
-    // @Brief returns min of int n and machineThreads
+    // @Brief returns min of int n and the number of threads available to the calling thread;
+    // inside a parallel region this follows the team size set there with omp_set_num_threads
     int GetThreadLimit(int n) const {
 #ifdef PARALLEL
-        return n > machineThreads ? machineThreads : n;
+        int threads = omp_get_max_threads();
+        return n > threads ? threads : n;
 #else
         return 1;
 #endif
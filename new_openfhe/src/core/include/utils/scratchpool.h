@@ -0,0 +1,109 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Per-thread cache of the aligned blocks behind LimbSlabs, for the temporaries of key switching
+ */
+
+#ifndef LBCRYPTO_UTILS_SCRATCHPOOL_H
+#define LBCRYPTO_UTILS_SCRATCHPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lbcrypto {
+
+/**
+ * @brief Counters of ScratchPool, summed over all threads since the last ResetStats().
+ */
+struct ScratchPoolStats {
+    // blocks obtained from the system allocator
+    uint64_t allocations{0};
+    // blocks served from a thread cache
+    uint64_t reuses{0};
+    // blocks given back to a thread cache
+    uint64_t releases{0};
+    // blocks given back to the system because the cache was full
+    uint64_t frees{0};
+    // bytes currently held by the caches of all threads
+    uint64_t bytesCached{0};
+};
+
+/**
+ * @brief Thread-local free lists of 64-byte aligned blocks, keyed by size. A released block goes
+ * to the cache of the releasing thread and is handed out again by the next Acquire() of the
+ * same size on that thread, so repeated key switchings reuse the storage of the previous ones
+ * instead of going through malloc. Each thread keeps at most GetCacheLimit() bytes (64 MiB by
+ * default) and all threads together at most GetTotalCacheLimit() bytes (512 MiB by default), so
+ * the idle memory held by the caches is bounded by the smaller of threads * GetCacheLimit() and
+ * GetTotalCacheLimit() whatever the number of threads. A thread frees its cache with Trim() and
+ * when it exits.
+ */
+class ScratchPool {
+public:
+    static constexpr size_t Alignment = 64;
+
+    /**
+     * @param bytes the size, rounded up to a multiple of Alignment.
+     * @return an uninitialized block of at least bytes bytes.
+     */
+    static void* Acquire(size_t bytes);
+
+    /**
+     * Gives back a block from Acquire(); bytes must be the size it was acquired with.
+     */
+    static void Release(void* p, size_t bytes) noexcept;
+
+    /**
+     * Frees the blocks cached by the calling thread.
+     */
+    static void Trim() noexcept;
+
+    // bytes each thread may keep cached; 0 disables caching
+    static void SetCacheLimit(size_t bytes);
+    static size_t GetCacheLimit();
+
+    // bytes all threads together may keep cached; 0 disables caching
+    static void SetTotalCacheLimit(size_t bytes);
+    static size_t GetTotalCacheLimit();
+
+    static ScratchPoolStats GetStats();
+    // zeroes the event counters; bytesCached keeps tracking the caches
+    static void ResetStats();
+
+    static size_t RoundUp(size_t bytes) {
+        return bytes == 0 ? Alignment : (bytes + Alignment - 1) / Alignment * Alignment;
+    }
+};
+
+}  // namespace lbcrypto
+
+#endif
@@ -0,0 +1,95 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ This file contains the AVX512IFMA accumulation of the fast basis conversion. It is compiled with -mavx512f
+ -mavx512ifma (see src/core/CMakeLists.txt); basisconvnat.cpp only calls it on CPUs that support them
+*/
+
+#include "math/hal/intnat/basisconvnat-kernels.h"
+
+#if defined(__AVX512F__) && defined(__AVX512IFMA__)
+    #include <immintrin.h>
+#endif
+
+namespace intnat {
+namespace simd {
+
+#if defined(__AVX512F__) && defined(__AVX512IFMA__)
+
+bool BuiltBasisConvAVX512IFMA() {
+    return true;
+}
+
+void AccumulateTileAVX512IFMA(const uint64_t* xs, uint32_t sizeIn, const uint64_t* row, uint64_t* lo, uint64_t* hi) {
+    static_assert(kBasisConvTile == 32, "the kernel keeps one tile in four registers");
+    __m512i lo0 = _mm512_setzero_si512(), lo1 = _mm512_setzero_si512();
+    __m512i lo2 = _mm512_setzero_si512(), lo3 = _mm512_setzero_si512();
+    __m512i hi0 = _mm512_setzero_si512(), hi1 = _mm512_setzero_si512();
+    __m512i hi2 = _mm512_setzero_si512(), hi3 = _mm512_setzero_si512();
+    for (uint32_t i = 0; i < sizeIn; ++i) {
+        const uint64_t* x = xs + static_cast<size_t>(i) * kBasisConvTile;
+        __m512i m         = _mm512_set1_epi64(static_cast<long long>(row[i]));
+        __m512i x0        = _mm512_loadu_si512(x);
+        __m512i x1        = _mm512_loadu_si512(x + 8);
+        __m512i x2        = _mm512_loadu_si512(x + 16);
+        __m512i x3        = _mm512_loadu_si512(x + 24);
+        lo0               = _mm512_madd52lo_epu64(lo0, x0, m);
+        lo1               = _mm512_madd52lo_epu64(lo1, x1, m);
+        lo2               = _mm512_madd52lo_epu64(lo2, x2, m);
+        lo3               = _mm512_madd52lo_epu64(lo3, x3, m);
+        hi0               = _mm512_madd52hi_epu64(hi0, x0, m);
+        hi1               = _mm512_madd52hi_epu64(hi1, x1, m);
+        hi2               = _mm512_madd52hi_epu64(hi2, x2, m);
+        hi3               = _mm512_madd52hi_epu64(hi3, x3, m);
+    }
+    _mm512_storeu_si512(lo, lo0);
+    _mm512_storeu_si512(lo + 8, lo1);
+    _mm512_storeu_si512(lo + 16, lo2);
+    _mm512_storeu_si512(lo + 24, lo3);
+    _mm512_storeu_si512(hi, hi0);
+    _mm512_storeu_si512(hi + 8, hi1);
+    _mm512_storeu_si512(hi + 16, hi2);
+    _mm512_storeu_si512(hi + 24, hi3);
+}
+
+#else
+
+bool BuiltBasisConvAVX512IFMA() {
+    return false;
+}
+
+void AccumulateTileAVX512IFMA(const uint64_t*, uint32_t, const uint64_t*, uint64_t*, uint64_t*) {}
+
+#endif
+
+}  // namespace simd
+}  // namespace intnat
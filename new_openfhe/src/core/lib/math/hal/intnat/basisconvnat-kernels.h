@@ -0,0 +1,64 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ This file contains the interface between basisconvnat.cpp and its vector kernel in basisconvnat-avx512ifma.cpp.
+ That unit is compiled with the AVX-512 flags (see src/core/CMakeLists.txt), so, like the NTT kernels, it only
+ includes this header and does the accumulation; the reductions stay in basisconvnat.cpp.
+*/
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_BASISCONVNAT_KERNELS_H
+#define LBCRYPTO_MATH_HAL_INTNAT_BASISCONVNAT_KERNELS_H
+
+#include <cstdint>
+
+namespace intnat {
+namespace simd {
+
+// coefficients per tile; the scaled residues of a tile take sizeIn * 256 bytes
+constexpr uint32_t kBasisConvTile = 32;
+
+// each product is split into 52-bit halves, each half sum may take 2^12 terms
+constexpr uint64_t kMaxModulusBasisConvIFMA = uint64_t(1) << 52;
+constexpr uint32_t kMaxBasisConvSizeIFMA    = 4096;
+
+bool BuiltBasisConvAVX512IFMA();
+
+/**
+ * For the kBasisConvTile coefficients t of one tile, with xs input-major (xs[i * kBasisConvTile + t]):
+ * lo[t] + hi[t] * 2^52 = sum_i xs[i * kBasisConvTile + t] * row[i], every xs and row entry below 2^52.
+ */
+void AccumulateTileAVX512IFMA(const uint64_t* xs, uint32_t sizeIn, const uint64_t* row, uint64_t* lo, uint64_t* hi);
+
+}  // namespace simd
+}  // namespace intnat
+
+#endif
@@ -0,0 +1,134 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ This file contains the cache-blocked fast basis conversion of RNS residues for 64-bit native integers
+*/
+
+#include "math/hal/intnat/basisconvnat.h"
+
+#if defined(HAVE_INT128) && NATIVEINT == 64
+
+    #include "math/hal/intnat/basisconvnat-kernels.h"
+    #include "math/hal/intnat/transformnat-simd.h"
+    #include "utils/utilities-int.h"
+
+    #include <algorithm>
+    #include <vector>
+
+namespace intnat {
+
+namespace {
+
+// [x * b]_q with bPrecon = floor(b * 2^64 / q), as NativeInteger::ModMulFastConst()
+inline uint64_t MulModPrecon(uint64_t x, uint64_t b, uint64_t bPrecon, uint64_t q) {
+    uint64_t quot = static_cast<uint64_t>((static_cast<DoubleNativeInt>(x) * bPrecon) >> 64) + 1;
+    auto r        = static_cast<int64_t>(x * b - quot * q);
+    return static_cast<uint64_t>(r >= 0 ? r : r + static_cast<int64_t>(q));
+}
+
+void ConvertTileScalar(const uint64_t* xs, uint32_t sizeIn, const uint64_t* matrix, uint64_t* const* out,
+                       const uint64_t* moduliOut, const DoubleNativeInt* barrettMu, uint32_t sizeOut, uint32_t k,
+                       uint32_t len) {
+    DoubleNativeInt acc[simd::kBasisConvTile];
+    for (uint32_t j = 0; j < sizeOut; ++j) {
+        std::fill(acc, acc + len, 0);
+        const uint64_t* row = matrix + static_cast<size_t>(j) * sizeIn;
+        for (uint32_t i = 0; i < sizeIn; ++i) {
+            const uint64_t* x = xs + static_cast<size_t>(i) * simd::kBasisConvTile;
+            uint64_t m        = row[i];
+            for (uint32_t t = 0; t < len; ++t)
+                acc[t] += lbcrypto::Mul128(x[t], m);
+        }
+        for (uint32_t t = 0; t < len; ++t)
+            out[j][k + t] = lbcrypto::BarrettUint128ModUint64(acc[t], moduliOut[j], barrettMu[j]);
+    }
+}
+
+void ConvertTileIFMA(const uint64_t* xs, uint32_t sizeIn, const uint64_t* matrix, uint64_t* const* out,
+                     const uint64_t* moduliOut, const DoubleNativeInt* barrettMu, uint32_t sizeOut, uint32_t k) {
+    uint64_t lo[simd::kBasisConvTile];
+    uint64_t hi[simd::kBasisConvTile];
+    for (uint32_t j = 0; j < sizeOut; ++j) {
+        simd::AccumulateTileAVX512IFMA(xs, sizeIn, matrix + static_cast<size_t>(j) * sizeIn, lo, hi);
+        for (uint32_t t = 0; t < simd::kBasisConvTile; ++t) {
+            DoubleNativeInt acc = (static_cast<DoubleNativeInt>(hi[t]) << 52) + lo[t];
+            out[j][k + t]       = lbcrypto::BarrettUint128ModUint64(acc, moduliOut[j], barrettMu[j]);
+        }
+    }
+}
+
+}  // namespace
+
+void FastBasisConversion(const uint64_t* const* in, const uint64_t* moduliIn, const uint64_t* scale,
+                         const uint64_t* scalePrecon, uint32_t sizeIn, const uint64_t* matrix, uint64_t* const* out,
+                         const uint64_t* moduliOut, const DoubleNativeInt* barrettMu, uint32_t sizeOut, uint32_t n) {
+    constexpr uint32_t tile = simd::kBasisConvTile;
+
+    // the IFMA kernel splits each product at bit 52, so every factor has to be below 2^52
+    bool ifma = GetNTTSimdLevel() == NTTSimdLevel::AVX512IFMA && simd::BuiltBasisConvAVX512IFMA() &&
+                sizeIn <= simd::kMaxBasisConvSizeIFMA;
+    for (uint32_t i = 0; ifma && i < sizeIn; ++i)
+        ifma = moduliIn[i] < simd::kMaxModulusBasisConvIFMA;
+    for (uint32_t j = 0; ifma && j < sizeOut; ++j)
+        ifma = moduliOut[j] < simd::kMaxModulusBasisConvIFMA;
+
+    uint32_t numTiles = (n + tile - 1) / tile;
+    #pragma omp parallel
+    {
+        // the scaled residues of one tile, input-major
+        std::vector<uint64_t> xs(static_cast<size_t>(sizeIn) * tile);
+    #pragma omp for
+        for (uint32_t b = 0; b < numTiles; ++b) {
+            uint32_t k   = b * tile;
+            uint32_t len = std::min(tile, n - k);
+            for (uint32_t i = 0; i < sizeIn; ++i) {
+                const uint64_t* x = in[i] + k;
+                uint64_t* y       = xs.data() + static_cast<size_t>(i) * tile;
+                if (scale != nullptr) {
+                    for (uint32_t t = 0; t < len; ++t)
+                        y[t] = MulModPrecon(x[t], scale[i], scalePrecon[i], moduliIn[i]);
+                }
+                else {
+                    std::copy(x, x + len, y);
+                }
+            }
+            if (ifma && len == tile)
+                ConvertTileIFMA(xs.data(), sizeIn, matrix, out, moduliOut, barrettMu, sizeOut, k);
+            else
+                ConvertTileScalar(xs.data(), sizeIn, matrix, out, moduliOut, barrettMu, sizeOut, k, len);
+        }
+    }
+}
+
+}  // namespace intnat
+
+#endif
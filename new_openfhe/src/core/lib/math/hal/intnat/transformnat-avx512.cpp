@@ -0,0 +1,80 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ This file contains the AVX512 kernels of the native NTT. It is compiled with -mavx512f -mavx512dq
+ (see src/core/CMakeLists.txt); transformnat-simd.cpp only calls it on CPUs that support them
+*/
+
+#include "math/hal/intnat/transformnat-simd-kernels.h"
+
+namespace intnat {
+namespace simd {
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+
+bool BuiltAVX512() {
+    return true;
+}
+
+bool ForwardAVX512(uint64_t* a, const uint64_t* roots, const uint64_t* precons, uint64_t q, uint32_t n) {
+    if (q >= kMaxModulus || n < 2 * VecAVX512::kLanes)
+        return false;
+    ForwardTransform<VecAVX512>(a, roots, precons, q, n);
+    return true;
+}
+
+bool InverseAVX512(uint64_t* a, const uint64_t* roots, const uint64_t* precons, uint64_t nInv, uint64_t nInvPrecon,
+                   uint64_t q, uint32_t n) {
+    if (q >= kMaxModulus || n < 2 * VecAVX512::kLanes)
+        return false;
+    InverseTransform<VecAVX512>(a, roots, precons, nInv, nInvPrecon, q, n);
+    return true;
+}
+
+#else
+
+bool BuiltAVX512() {
+    return false;
+}
+
+bool ForwardAVX512(uint64_t*, const uint64_t*, const uint64_t*, uint64_t, uint32_t) {
+    return false;
+}
+
+bool InverseAVX512(uint64_t*, const uint64_t*, const uint64_t*, uint64_t, uint64_t, uint64_t, uint32_t) {
+    return false;
+}
+
+#endif
+
+}  // namespace simd
+}  // namespace intnat
@@ -0,0 +1,431 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ This file contains the vector NTT loops shared by transformnat-avx2.cpp, transformnat-avx512.cpp and
+ transformnat-avx512ifma.cpp. Each of them is compiled with the flags of its instruction set
+ (see src/core/CMakeLists.txt) and includes this header only, so nothing here may pull in code
+ the rest of the library shares: all of it is internal to the including translation unit.
+*/
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_KERNELS_H
+#define LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_KERNELS_H
+
+#include <cstdint>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+namespace intnat {
+namespace simd {
+
+// entry points of the three translation units; false when the unit was built without its instruction
+// set or the arguments are out of its range (see transformnat-simd.h)
+bool ForwardAVX2(uint64_t* a, const uint64_t* roots, const uint64_t* precons, uint64_t q, uint32_t n);
+bool InverseAVX2(uint64_t* a, const uint64_t* roots, const uint64_t* precons, uint64_t nInv, uint64_t nInvPrecon,
+                 uint64_t q, uint32_t n);
+bool ForwardAVX512(uint64_t* a, const uint64_t* roots, const uint64_t* precons, uint64_t q, uint32_t n);
+bool InverseAVX512(uint64_t* a, const uint64_t* roots, const uint64_t* precons, uint64_t nInv, uint64_t nInvPrecon,
+                   uint64_t q, uint32_t n);
+bool ForwardAVX512IFMA(uint64_t* a, const uint64_t* roots, const uint64_t* precons, uint64_t q, uint32_t n);
+bool InverseAVX512IFMA(uint64_t* a, const uint64_t* roots, const uint64_t* precons, uint64_t nInv,
+                       uint64_t nInvPrecon, uint64_t q, uint32_t n);
+bool BuiltAVX2();
+bool BuiltAVX512();
+bool BuiltAVX512IFMA();
+
+// the 64-bit kernels keep 4q below 2^63, the IFMA ones below 2^52
+constexpr uint64_t kMaxModulus     = uint64_t(1) << 61;
+constexpr uint64_t kMaxModulusIFMA = uint64_t(1) << 50;
+
+namespace {
+
+// Shoup precomputation floor(w * 2^64 / q), for the one constant the kernels derive themselves
+inline uint64_t ShoupPrecon(uint64_t w, uint64_t q) {
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(w) << 64) / q);
+}
+
+inline uint64_t ShoupMul(uint64_t a, uint64_t w, uint64_t wPrecon, uint64_t q) {
+    uint64_t hi = static_cast<uint64_t>((static_cast<unsigned __int128>(a) * wPrecon) >> 64);
+    uint64_t r  = a * w - hi * q;
+    return r >= q ? r - q : r;
+}
+
+/*
+ A vector backend V provides, on registers V::Reg of V::kLanes words:
+   Load, Store, Set1                 unaligned memory access and broadcast
+   Precon(x)                         a register of 64-bit Shoup precomputations in the form MulLazy takes
+   Add, Sub                          wrapping word arithmetic
+   Reduce(x, m)                      x - m if x >= m, for x < 2m
+   MulLazy(y, w, wPrecon, q)         y * w mod q in [0, 2q), Shoup's product without its correction
+   Split<T>, Merge<T>                for T < kLanes: two registers of whole butterfly groups of 2T words
+                                     to the registers of their first and second halves, and back
+   Twiddles<T>(p)                    p[k / T] in lane k, matching the lane order of Split<T>
+*/
+
+// Harvey's lazy butterflies: the forward one takes X, Y in [0, 4q) and returns them in [0, 4q),
+// the inverse one takes and returns them in [0, 2q)
+template <class V>
+inline void ForwardButterfly(typename V::Reg& x, typename V::Reg& y, typename V::Reg w, typename V::Reg wPrecon,
+                             typename V::Reg q, typename V::Reg q2) {
+    auto xr = V::Reduce(x, q2);
+    auto t  = V::MulLazy(y, w, wPrecon, q);
+    x       = V::Add(xr, t);
+    y       = V::Add(V::Sub(xr, t), q2);
+}
+
+template <class V>
+inline void InverseButterfly(typename V::Reg& x, typename V::Reg& y, typename V::Reg w, typename V::Reg wPrecon,
+                             typename V::Reg q, typename V::Reg q2) {
+    auto d = V::Add(V::Sub(x, y), q2);
+    x      = V::Reduce(V::Add(x, y), q2);
+    y      = V::MulLazy(d, w, wPrecon, q);
+}
+
+// a stage with groups of 2T < 2 kLanes words: each pair of registers holds kLanes / T whole groups
+template <class V, uint32_t T>
+inline void ForwardSmallStage(uint64_t* a, const uint64_t* roots, const uint64_t* precons, typename V::Reg q,
+                              typename V::Reg q2, uint32_t m) {
+    constexpr uint32_t L = V::kLanes;
+    for (uint32_t i = 0; i < m; i += L / T) {
+        uint64_t* x = a + 2 * T * i;
+        auto r0     = V::Load(x);
+        auto r1     = V::Load(x + L);
+        typename V::Reg lo, hi;
+        V::template Split<T>(r0, r1, lo, hi);
+        ForwardButterfly<V>(lo, hi, V::template Twiddles<T>(roots + m + i),
+                            V::Precon(V::template Twiddles<T>(precons + m + i)), q, q2);
+        if constexpr (T == 1) {
+            // the last stage, back to [0, q)
+            lo = V::Reduce(V::Reduce(lo, q2), q);
+            hi = V::Reduce(V::Reduce(hi, q2), q);
+        }
+        V::template Merge<T>(lo, hi, r0, r1);
+        V::Store(x, r0);
+        V::Store(x + L, r1);
+    }
+}
+
+template <class V, uint32_t T>
+inline void InverseSmallStage(uint64_t* a, const uint64_t* roots, const uint64_t* precons, typename V::Reg q,
+                              typename V::Reg q2, uint32_t m) {
+    constexpr uint32_t L = V::kLanes;
+    for (uint32_t i = 0; i < m; i += L / T) {
+        uint64_t* x = a + 2 * T * i;
+        auto r0     = V::Load(x);
+        auto r1     = V::Load(x + L);
+        typename V::Reg lo, hi;
+        V::template Split<T>(r0, r1, lo, hi);
+        InverseButterfly<V>(lo, hi, V::template Twiddles<T>(roots + m + i),
+                            V::Precon(V::template Twiddles<T>(precons + m + i)), q, q2);
+        V::template Merge<T>(lo, hi, r0, r1);
+        V::Store(x, r0);
+        V::Store(x + L, r1);
+    }
+}
+
+// the stage order and the table indexing of NumberTheoreticTransformNat::ForwardTransformToBitReverseInPlace,
+// n >= 2 kLanes
+template <class V>
+inline void ForwardTransform(uint64_t* a, const uint64_t* roots, const uint64_t* precons, uint64_t modulus,
+                             uint32_t n) {
+    constexpr uint32_t L = V::kLanes;
+    const auto q         = V::Set1(modulus);
+    const auto q2        = V::Set1(2 * modulus);
+    uint32_t m = 1, t = n >> 1;
+    for (; t >= L; m <<= 1, t >>= 1) {
+        for (uint32_t i = 0; i < m; ++i) {
+            const auto w       = V::Set1(roots[m + i]);
+            const auto wPrecon = V::Precon(V::Set1(precons[m + i]));
+            uint64_t* x        = a + 2 * i * t;
+            uint64_t* y        = x + t;
+            for (uint32_t j = 0; j < t; j += L) {
+                auto vx = V::Load(x + j);
+                auto vy = V::Load(y + j);
+                ForwardButterfly<V>(vx, vy, w, wPrecon, q, q2);
+                V::Store(x + j, vx);
+                V::Store(y + j, vy);
+            }
+        }
+    }
+    if constexpr (L > 4) {
+        ForwardSmallStage<V, 4>(a, roots, precons, q, q2, m);
+        m <<= 1;
+    }
+    ForwardSmallStage<V, 2>(a, roots, precons, q, q2, m);
+    ForwardSmallStage<V, 1>(a, roots, precons, q, q2, m << 1);
+}
+
+// the stage order of NumberTheoreticTransformNat::InverseTransformFromBitReverseInPlace; the scaling by
+// n^-1 is folded into the last stage, where the second output takes w * n^-1 at once
+template <class V>
+inline void InverseTransform(uint64_t* a, const uint64_t* roots, const uint64_t* precons, uint64_t nInv,
+                             uint64_t nInvPrecon, uint64_t modulus, uint32_t n) {
+    constexpr uint32_t L = V::kLanes;
+    const auto q         = V::Set1(modulus);
+    const auto q2        = V::Set1(2 * modulus);
+    uint32_t m = n >> 1, t;
+    InverseSmallStage<V, 1>(a, roots, precons, q, q2, m);
+    InverseSmallStage<V, 2>(a, roots, precons, q, q2, m >> 1);
+    m >>= 2;
+    t = 4;
+    if constexpr (L > 4) {
+        InverseSmallStage<V, 4>(a, roots, precons, q, q2, m);
+        m >>= 1;
+        t = 8;
+    }
+    for (; m > 1; m >>= 1, t <<= 1) {
+        for (uint32_t i = 0; i < m; ++i) {
+            const auto w       = V::Set1(roots[m + i]);
+            const auto wPrecon = V::Precon(V::Set1(precons[m + i]));
+            uint64_t* x        = a + 2 * i * t;
+            uint64_t* y        = x + t;
+            for (uint32_t j = 0; j < t; j += L) {
+                auto vx = V::Load(x + j);
+                auto vy = V::Load(y + j);
+                InverseButterfly<V>(vx, vy, w, wPrecon, q, q2);
+                V::Store(x + j, vx);
+                V::Store(y + j, vy);
+            }
+        }
+    }
+    const uint64_t wn  = ShoupMul(roots[1], nInv, nInvPrecon, modulus);
+    const auto vnInv   = V::Set1(nInv);
+    const auto vnInvP  = V::Precon(V::Set1(nInvPrecon));
+    const auto vwn     = V::Set1(wn);
+    const auto vwnP    = V::Precon(V::Set1(ShoupPrecon(wn, modulus)));
+    uint64_t* x        = a;
+    uint64_t* y        = a + t;
+    for (uint32_t j = 0; j < t; j += L) {
+        auto vx = V::Load(x + j);
+        auto vy = V::Load(y + j);
+        auto d  = V::Add(V::Sub(vx, vy), q2);
+        V::Store(x + j, V::Reduce(V::MulLazy(V::Add(vx, vy), vnInv, vnInvP, q), q));
+        V::Store(y + j, V::Reduce(V::MulLazy(d, vwn, vwnP, q), q));
+    }
+}
+
+#if defined(__AVX2__)
+// 4 lanes; the 64-bit products are built from 32-bit ones, comparisons are signed (values below 2^63)
+struct VecAVX2 {
+    using Reg                       = __m256i;
+    static constexpr uint32_t kLanes = 4;
+
+    static inline Reg Load(const uint64_t* p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    static inline void Store(uint64_t* p, Reg x) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x);
+    }
+    static inline Reg Set1(uint64_t x) {
+        return _mm256_set1_epi64x(static_cast<int64_t>(x));
+    }
+    static inline Reg Precon(Reg x) {
+        return x;
+    }
+    static inline Reg Add(Reg a, Reg b) {
+        return _mm256_add_epi64(a, b);
+    }
+    static inline Reg Sub(Reg a, Reg b) {
+        return _mm256_sub_epi64(a, b);
+    }
+    static inline Reg Reduce(Reg x, Reg m) {
+        return _mm256_sub_epi64(x, _mm256_andnot_si256(_mm256_cmpgt_epi64(m, x), m));
+    }
+    static inline Reg MulHi(Reg a, Reg b) {
+        const Reg lo32 = _mm256_set1_epi64x(0xFFFFFFFF);
+        Reg aHi        = _mm256_srli_epi64(a, 32);
+        Reg bHi        = _mm256_srli_epi64(b, 32);
+        Reg ll         = _mm256_mul_epu32(a, b);
+        Reg lh         = _mm256_mul_epu32(a, bHi);
+        Reg hl         = _mm256_mul_epu32(aHi, b);
+        Reg hh         = _mm256_mul_epu32(aHi, bHi);
+        Reg mid        = _mm256_add_epi64(_mm256_srli_epi64(ll, 32),
+                                          _mm256_add_epi64(_mm256_and_si256(lh, lo32), _mm256_and_si256(hl, lo32)));
+        return _mm256_add_epi64(_mm256_add_epi64(hh, _mm256_srli_epi64(mid, 32)),
+                                _mm256_add_epi64(_mm256_srli_epi64(lh, 32), _mm256_srli_epi64(hl, 32)));
+    }
+    static inline Reg MulLo(Reg a, Reg b) {
+        Reg cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                     _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+        return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+    }
+    static inline Reg MulLazy(Reg y, Reg w, Reg wPrecon, Reg q) {
+        return _mm256_sub_epi64(MulLo(y, w), MulLo(MulHi(y, wPrecon), q));
+    }
+    template <uint32_t T>
+    static inline void Split(Reg r0, Reg r1, Reg& x, Reg& y) {
+        if constexpr (T == 2) {
+            x = _mm256_permute2x128_si256(r0, r1, 0x20);
+            y = _mm256_permute2x128_si256(r0, r1, 0x31);
+        }
+        else {
+            // groups 0, 2, 1, 3 in the lanes
+            x = _mm256_unpacklo_epi64(r0, r1);
+            y = _mm256_unpackhi_epi64(r0, r1);
+        }
+    }
+    template <uint32_t T>
+    static inline void Merge(Reg x, Reg y, Reg& r0, Reg& r1) {
+        if constexpr (T == 2) {
+            r0 = _mm256_permute2x128_si256(x, y, 0x20);
+            r1 = _mm256_permute2x128_si256(x, y, 0x31);
+        }
+        else {
+            r0 = _mm256_unpacklo_epi64(x, y);
+            r1 = _mm256_unpackhi_epi64(x, y);
+        }
+    }
+    template <uint32_t T>
+    static inline Reg Twiddles(const uint64_t* p) {
+        if constexpr (T == 2)
+            return _mm256_permute4x64_epi64(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))), 0x50);
+        else
+            return _mm256_permute4x64_epi64(Load(p), 0xD8);
+    }
+};
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+// 8 lanes; the high word of the 64-bit products is built from 32-bit ones
+struct VecAVX512 {
+    using Reg                       = __m512i;
+    static constexpr uint32_t kLanes = 8;
+
+    static inline Reg Load(const uint64_t* p) {
+        return _mm512_loadu_si512(p);
+    }
+    static inline void Store(uint64_t* p, Reg x) {
+        _mm512_storeu_si512(p, x);
+    }
+    static inline Reg Set1(uint64_t x) {
+        return _mm512_set1_epi64(static_cast<int64_t>(x));
+    }
+    static inline Reg Precon(Reg x) {
+        return x;
+    }
+    static inline Reg Add(Reg a, Reg b) {
+        return _mm512_add_epi64(a, b);
+    }
+    static inline Reg Sub(Reg a, Reg b) {
+        return _mm512_sub_epi64(a, b);
+    }
+    static inline Reg Reduce(Reg x, Reg m) {
+        // x - m wraps above x exactly when x < m
+        return _mm512_min_epu64(x, _mm512_sub_epi64(x, m));
+    }
+    static inline Reg MulHi(Reg a, Reg b) {
+        const Reg lo32 = _mm512_set1_epi64(0xFFFFFFFF);
+        Reg aHi        = _mm512_srli_epi64(a, 32);
+        Reg bHi        = _mm512_srli_epi64(b, 32);
+        Reg ll         = _mm512_mul_epu32(a, b);
+        Reg lh         = _mm512_mul_epu32(a, bHi);
+        Reg hl         = _mm512_mul_epu32(aHi, b);
+        Reg hh         = _mm512_mul_epu32(aHi, bHi);
+        Reg mid        = _mm512_add_epi64(_mm512_srli_epi64(ll, 32),
+                                          _mm512_add_epi64(_mm512_and_si512(lh, lo32), _mm512_and_si512(hl, lo32)));
+        return _mm512_add_epi64(_mm512_add_epi64(hh, _mm512_srli_epi64(mid, 32)),
+                                _mm512_add_epi64(_mm512_srli_epi64(lh, 32), _mm512_srli_epi64(hl, 32)));
+    }
+    static inline Reg MulLazy(Reg y, Reg w, Reg wPrecon, Reg q) {
+        return _mm512_sub_epi64(_mm512_mullo_epi64(y, w), _mm512_mullo_epi64(MulHi(y, wPrecon), q));
+    }
+    template <uint32_t T>
+    static inline void Split(Reg r0, Reg r1, Reg& x, Reg& y) {
+        if constexpr (T == 4) {
+            x = _mm512_permutex2var_epi64(r0, _mm512_setr_epi64(0, 1, 2, 3, 8, 9, 10, 11), r1);
+            y = _mm512_permutex2var_epi64(r0, _mm512_setr_epi64(4, 5, 6, 7, 12, 13, 14, 15), r1);
+        }
+        else if constexpr (T == 2) {
+            x = _mm512_permutex2var_epi64(r0, _mm512_setr_epi64(0, 1, 4, 5, 8, 9, 12, 13), r1);
+            y = _mm512_permutex2var_epi64(r0, _mm512_setr_epi64(2, 3, 6, 7, 10, 11, 14, 15), r1);
+        }
+        else {
+            x = _mm512_permutex2var_epi64(r0, _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14), r1);
+            y = _mm512_permutex2var_epi64(r0, _mm512_setr_epi64(1, 3, 5, 7, 9, 11, 13, 15), r1);
+        }
+    }
+    template <uint32_t T>
+    static inline void Merge(Reg x, Reg y, Reg& r0, Reg& r1) {
+        if constexpr (T == 4) {
+            r0 = _mm512_permutex2var_epi64(x, _mm512_setr_epi64(0, 1, 2, 3, 8, 9, 10, 11), y);
+            r1 = _mm512_permutex2var_epi64(x, _mm512_setr_epi64(4, 5, 6, 7, 12, 13, 14, 15), y);
+        }
+        else if constexpr (T == 2) {
+            r0 = _mm512_permutex2var_epi64(x, _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11), y);
+            r1 = _mm512_permutex2var_epi64(x, _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15), y);
+        }
+        else {
+            r0 = _mm512_permutex2var_epi64(x, _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11), y);
+            r1 = _mm512_permutex2var_epi64(x, _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15), y);
+        }
+    }
+    template <uint32_t T>
+    static inline Reg Twiddles(const uint64_t* p) {
+        if constexpr (T == 4)
+            return _mm512_permutexvar_epi64(_mm512_setr_epi64(0, 0, 0, 0, 1, 1, 1, 1),
+                                            _mm512_maskz_loadu_epi64(0x03, p));
+        else if constexpr (T == 2)
+            return _mm512_permutexvar_epi64(_mm512_setr_epi64(0, 0, 1, 1, 2, 2, 3, 3),
+                                            _mm512_maskz_loadu_epi64(0x0F, p));
+        else
+            return Load(p);
+    }
+};
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__) && defined(__AVX512IFMA__)
+// 8 lanes of 52-bit products: Shoup's product with 2^52 in place of 2^64, so every operand, 4q
+// included, stays below 2^52
+struct VecAVX512IFMA : VecAVX512 {
+    static inline Reg Precon(Reg x) {
+        // floor(w * 2^52 / q) = floor(floor(w * 2^64 / q) / 2^12)
+        return _mm512_srli_epi64(x, 12);
+    }
+    static inline Reg MulLazy(Reg y, Reg w, Reg wPrecon, Reg q) {
+        const Reg zero   = _mm512_setzero_si512();
+        const Reg mask52 = _mm512_set1_epi64((uint64_t(1) << 52) - 1);
+        Reg hi           = _mm512_madd52hi_epu64(zero, y, wPrecon);
+        // y * w - hi * q mod 2^52, as y * w + hi * (2^52 - q)
+        Reg r = _mm512_madd52lo_epu64(_mm512_madd52lo_epu64(zero, y, w), hi,
+                                      _mm512_sub_epi64(_mm512_set1_epi64(uint64_t(1) << 52), q));
+        return _mm512_and_si512(r, mask52);
+    }
+};
+#endif
+
+}  // namespace
+}  // namespace simd
+}  // namespace intnat
+
+#endif
@@ -0,0 +1,138 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+ This file contains the dispatch of the native NTT to the vector kernels of transformnat-avx2.cpp,
+ transformnat-avx512.cpp and transformnat-avx512ifma.cpp
+*/
+
+#include "math/hal/intnat/transformnat-simd.h"
+#include "math/hal/intnat/transformnat-simd-kernels.h"
+
+#include <atomic>
+
+namespace intnat {
+
+namespace {
+
+NTTSimdLevel DetectNTTSimdLevel() {
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+        if (__builtin_cpu_supports("avx512ifma") && simd::BuiltAVX512IFMA())
+            return NTTSimdLevel::AVX512IFMA;
+        if (simd::BuiltAVX512())
+            return NTTSimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && simd::BuiltAVX2())
+        return NTTSimdLevel::AVX2;
+#endif
+    return NTTSimdLevel::SCALAR;
+}
+
+std::atomic<NTTSimdLevel>& ActiveNTTSimdLevel() {
+    static std::atomic<NTTSimdLevel> level{GetNTTSimdLevelSupported()};
+    return level;
+}
+
+}  // namespace
+
+std::ostream& operator<<(std::ostream& os, NTTSimdLevel level) {
+    switch (level) {
+        case NTTSimdLevel::SCALAR:
+            return os << "SCALAR";
+        case NTTSimdLevel::AVX2:
+            return os << "AVX2";
+        case NTTSimdLevel::AVX512:
+            return os << "AVX512";
+        case NTTSimdLevel::AVX512IFMA:
+            return os << "AVX512IFMA";
+    }
+    return os << "UNKNOWN";
+}
+
+NTTSimdLevel GetNTTSimdLevelSupported() {
+    static const NTTSimdLevel supported = DetectNTTSimdLevel();
+    return supported;
+}
+
+NTTSimdLevel GetNTTSimdLevel() {
+    return ActiveNTTSimdLevel().load(std::memory_order_relaxed);
+}
+
+void SetNTTSimdLevel(NTTSimdLevel level) {
+    NTTSimdLevel supported = GetNTTSimdLevelSupported();
+    ActiveNTTSimdLevel().store(level > supported ? supported : level, std::memory_order_relaxed);
+}
+
+// each level falls back to the one below it when the modulus or the ring dimension is out of its range
+bool ForwardTransformToBitReverseSimd(uint64_t* element, const uint64_t* rootOfUnityTable,
+                                      const uint64_t* preconRootOfUnityTable, uint64_t modulus, uint32_t n) {
+    switch (GetNTTSimdLevel()) {
+        case NTTSimdLevel::AVX512IFMA:
+            if (simd::ForwardAVX512IFMA(element, rootOfUnityTable, preconRootOfUnityTable, modulus, n))
+                return true;
+            [[fallthrough]];
+        case NTTSimdLevel::AVX512:
+            if (simd::ForwardAVX512(element, rootOfUnityTable, preconRootOfUnityTable, modulus, n))
+                return true;
+            [[fallthrough]];
+        case NTTSimdLevel::AVX2:
+            return simd::ForwardAVX2(element, rootOfUnityTable, preconRootOfUnityTable, modulus, n);
+        default:
+            return false;
+    }
+}
+
+bool InverseTransformFromBitReverseSimd(uint64_t* element, const uint64_t* rootOfUnityInverseTable,
+                                        const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                        uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t n) {
+    switch (GetNTTSimdLevel()) {
+        case NTTSimdLevel::AVX512IFMA:
+            if (simd::InverseAVX512IFMA(element, rootOfUnityInverseTable, preconRootOfUnityInverseTable,
+                                        cycloOrderInv, preconCycloOrderInv, modulus, n))
+                return true;
+            [[fallthrough]];
+        case NTTSimdLevel::AVX512:
+            if (simd::InverseAVX512(element, rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv,
+                                    preconCycloOrderInv, modulus, n))
+                return true;
+            [[fallthrough]];
+        case NTTSimdLevel::AVX2:
+            return simd::InverseAVX2(element, rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv,
+                                     preconCycloOrderInv, modulus, n);
+        default:
+            return false;
+    }
+}
+
+}  // namespace intnat
@@ -47,6 +47,11 @@
 // #include <chrono>
 #include <cmath>
 // #include <sstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
 #include <vector>
 
 namespace lbcrypto {
@@ -284,4 +289,28 @@ void PrecomputeAutoMap(uint32_t n, uint32_t k, std::vector<uint32_t>* precomp) {
     }
 }
 
+const std::vector<uint32_t>& GetAutoMap(uint32_t n, uint32_t k) {
+    // the maps are never removed or modified, so the references handed out stay valid without the lock
+    static std::shared_mutex mutex;
+    static std::map<std::pair<uint32_t, uint32_t>, std::unique_ptr<const std::vector<uint32_t>>> maps;
+
+    // the map only depends on k modulo the cyclotomic order
+    const std::pair<uint32_t, uint32_t> key{n, k & ((n << 1) - 1)};
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = maps.find(key);
+        if (it != maps.end())
+            return *it->second;
+    }
+
+    auto map = std::make_unique<std::vector<uint32_t>>(n);
+    PrecomputeAutoMap(n, key.second, map.get());
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto& entry = maps[key];
+    if (!entry)
+        entry = std::move(map);
+    return *entry;
+}
+
 }  // namespace lbcrypto
@@ -0,0 +1,178 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Per-thread cache of the aligned blocks behind LimbSlabs
+ */
+
+#include "utils/scratchpool.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+namespace lbcrypto {
+
+namespace {
+
+// a few of the largest key switching temporaries per thread, and a bound for all the threads of a
+// large machine together
+std::atomic<size_t> cacheLimit{size_t(64) << 20};
+std::atomic<size_t> totalCacheLimit{size_t(512) << 20};
+
+std::atomic<uint64_t> statAllocations{0};
+std::atomic<uint64_t> statReuses{0};
+std::atomic<uint64_t> statReleases{0};
+std::atomic<uint64_t> statFrees{0};
+std::atomic<uint64_t> statBytesCached{0};
+
+// set once the cache of the thread is gone, for slabs destroyed later during thread or program exit
+thread_local bool cacheDestroyed{false};
+
+struct ThreadCache {
+    std::unordered_map<size_t, std::vector<void*>> blocks;
+    size_t bytes{0};
+
+    void Clear() noexcept {
+        for (auto& entry : blocks)
+            for (void* p : entry.second)
+                std::free(p);
+        blocks.clear();
+        statBytesCached -= bytes;
+        bytes = 0;
+    }
+
+    ~ThreadCache() {
+        Clear();
+        cacheDestroyed = true;
+    }
+};
+
+ThreadCache* GetThreadCache() {
+    if (cacheDestroyed)
+        return nullptr;
+    thread_local ThreadCache cache;
+    return &cache;
+}
+
+}  // namespace
+
+void* ScratchPool::Acquire(size_t bytes) {
+    bytes = RoundUp(bytes);
+    if (auto* cache = GetThreadCache()) {
+        auto it = cache->blocks.find(bytes);
+        if (it != cache->blocks.end() && !it->second.empty()) {
+            void* p = it->second.back();
+            it->second.pop_back();
+            cache->bytes -= bytes;
+            statBytesCached -= bytes;
+            statReuses.fetch_add(1, std::memory_order_relaxed);
+            return p;
+        }
+    }
+    void* p = std::aligned_alloc(Alignment, bytes);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    statAllocations.fetch_add(1, std::memory_order_relaxed);
+    return p;
+}
+
+void ScratchPool::Release(void* p, size_t bytes) noexcept {
+    if (p == nullptr)
+        return;
+    bytes       = RoundUp(bytes);
+    auto* cache = GetThreadCache();
+    if (!cache || cache->bytes + bytes > cacheLimit.load(std::memory_order_relaxed)) {
+        std::free(p);
+        statFrees.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    // the bytes are reserved before the check, so concurrent releases cannot overshoot the total
+    if (statBytesCached.fetch_add(bytes) + bytes > totalCacheLimit.load(std::memory_order_relaxed)) {
+        statBytesCached -= bytes;
+        std::free(p);
+        statFrees.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    try {
+        cache->blocks[bytes].push_back(p);
+    }
+    catch (...) {
+        statBytesCached -= bytes;
+        std::free(p);
+        statFrees.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    cache->bytes += bytes;
+    statReleases.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ScratchPool::Trim() noexcept {
+    if (auto* cache = GetThreadCache())
+        cache->Clear();
+}
+
+void ScratchPool::SetCacheLimit(size_t bytes) {
+    cacheLimit.store(bytes, std::memory_order_relaxed);
+}
+
+size_t ScratchPool::GetCacheLimit() {
+    return cacheLimit.load(std::memory_order_relaxed);
+}
+
+void ScratchPool::SetTotalCacheLimit(size_t bytes) {
+    totalCacheLimit.store(bytes, std::memory_order_relaxed);
+}
+
+size_t ScratchPool::GetTotalCacheLimit() {
+    return totalCacheLimit.load(std::memory_order_relaxed);
+}
+
+ScratchPoolStats ScratchPool::GetStats() {
+    ScratchPoolStats stats;
+    stats.allocations = statAllocations.load(std::memory_order_relaxed);
+    stats.reuses      = statReuses.load(std::memory_order_relaxed);
+    stats.releases    = statReleases.load(std::memory_order_relaxed);
+    stats.frees       = statFrees.load(std::memory_order_relaxed);
+    stats.bytesCached = statBytesCached.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ScratchPool::ResetStats() {
+    statAllocations = 0;
+    statReuses      = 0;
+    statReleases    = 0;
+    statFrees       = 0;
+}
+
+}  // namespace lbcrypto
@@ -593,6 +593,462 @@ TEST(UTDCRTPoly, DCRT_mod_ops_on_two_elements) {
     RUN_BIG_DCRTPOLYS(DCRT_mod_ops_on_two_elements, "DCRT DCRT_mod_ops_on_two_elements");
 }
 
+template <typename Element>
+void DCRT_contiguous_storage(const std::string& msg) {
+    usint order     = 16;
+    usint nBits     = 24;
+    usint towersize = 3;
+
+    std::shared_ptr<ILDCRTParams<typename Element::Integer>> ildcrtparams =
+        GenerateDCRTParams<typename Element::Integer>(order, towersize, nBits);
+    usint ringDim = ildcrtparams->GetRingDimension();
+
+    typename Element::DugType dug;
+
+    Element op1(dug, ildcrtparams);
+    Element op2(dug, ildcrtparams);
+    Element expected = op1 + op2;
+
+    EXPECT_FALSE(op1.IsContiguous()) << msg << " Failure: fresh towers reported as contiguous";
+    EXPECT_THROW(op1.GetRawView(), config_error) << msg;
+
+    op1.MakeContiguous();
+    EXPECT_TRUE(op1.IsContiguous()) << msg << " Failure: MakeContiguous";
+    DCRTRawView view = op1.GetRawView();
+    EXPECT_EQ(view.numTowers, towersize) << msg;
+    EXPECT_EQ(view.ringDim, ringDim) << msg;
+    for (usint i = 0; i < towersize; i++) {
+        EXPECT_EQ(view.moduli[i], op1.GetElementAtIndex(i).GetModulus().ConvertToInt()) << msg;
+        for (usint j = 0; j < ringDim; j++)
+            EXPECT_EQ(view.data[i * ringDim + j], op1.GetElementAtIndex(i).at(j).ConvertToInt())
+                << msg << " Failure: raw view tower " << i << " index " << j;
+    }
+
+    // in-place arithmetic stays in the slab and is visible through the view
+    op1 += op2;
+    EXPECT_TRUE(op1.IsContiguous()) << msg << " Failure: += moved a tower out of the slab";
+    EXPECT_EQ(op1, expected) << msg << " Failure: += on contiguous storage";
+    for (usint i = 0; i < towersize; i++)
+        for (usint j = 0; j < ringDim; j++)
+            EXPECT_EQ(view.data[i * ringDim + j], expected.GetElementAtIndex(i).at(j).ConvertToInt())
+                << msg << " Failure: write not visible through view, tower " << i << " index " << j;
+
+    // copies get their own storage
+    Element copy(op1);
+    EXPECT_FALSE(copy.IsContiguous()) << msg << " Failure: copy aliases the slab";
+    EXPECT_EQ(copy, op1) << msg;
+
+    // the view survives dropping towers since the remaining ones stay in place
+    op1.DropLastElement();
+    EXPECT_TRUE(op1.IsContiguous()) << msg << " Failure: DropLastElement";
+    EXPECT_EQ(op1.GetRawView().data, view.data) << msg;
+}
+
+TEST(UTDCRTPoly, DCRT_contiguous_storage) {
+    RUN_BIG_DCRTPOLYS(DCRT_contiguous_storage, "DCRT DCRT_contiguous_storage");
+}
+
+template <typename Element>
+void DCRT_slab_storage_policy(const std::string& msg) {
+    usint order     = 16;
+    usint nBits     = 24;
+    usint towersize = 3;
+
+    std::shared_ptr<ILDCRTParams<typename Element::Integer>> ildcrtparams =
+        GenerateDCRTParams<typename Element::Integer>(order, towersize, nBits);
+
+    typename Element::DugType dug;
+
+    // reference results with the default per-tower storage
+    Element op1(dug, ildcrtparams, Format::EVALUATION);
+    Element op2(dug, ildcrtparams, Format::EVALUATION);
+    Element sum        = op1 + op2;
+    Element difference = op1 - op2;
+    Element product    = op1 * op2;
+    EXPECT_EQ(Element::GetStoragePolicy(), TOWER_HEAP) << msg;
+
+    Element::SetStoragePolicy(LIMB_SLAB);
+
+    Element zero(ildcrtparams, Format::EVALUATION, true);
+    EXPECT_TRUE(zero.IsContiguous()) << msg << " Failure: constructor";
+    EXPECT_EQ(zero, Element(ildcrtparams, Format::EVALUATION, true)) << msg << " Failure: zero constructor";
+
+    Element copy(op1);
+    EXPECT_TRUE(copy.IsContiguous()) << msg << " Failure: copy constructor";
+    EXPECT_EQ(copy, op1) << msg;
+
+    Element assigned(ildcrtparams, Format::EVALUATION);
+    auto data = assigned.GetRawView().data;
+    assigned  = op2;
+    EXPECT_TRUE(assigned.IsContiguous()) << msg << " Failure: copy assignment";
+    EXPECT_EQ(assigned.GetRawView().data, data) << msg << " Failure: copy assignment reallocated the slab";
+    EXPECT_EQ(assigned, op2) << msg;
+
+    Element result = copy + op2;
+    EXPECT_TRUE(result.IsContiguous()) << msg << " Failure: Plus";
+    EXPECT_EQ(result, sum) << msg;
+    result = copy - op2;
+    EXPECT_TRUE(result.IsContiguous()) << msg << " Failure: Minus";
+    EXPECT_EQ(result, difference) << msg;
+    result = copy * op2;
+    EXPECT_TRUE(result.IsContiguous()) << msg << " Failure: Times";
+    EXPECT_EQ(result, product) << msg;
+
+    Element clone = copy.CloneTowers(0, towersize - 1);
+    EXPECT_TRUE(clone.IsContiguous()) << msg << " Failure: CloneTowers";
+    for (usint i = 0; i < towersize; i++)
+        EXPECT_EQ(clone.GetElementAtIndex(i), op1.GetElementAtIndex(i)) << msg << " Failure: CloneTowers " << i;
+
+    // replacing a tower copies it into its place in the slab
+    copy.SetElementAtIndex(1, op2.GetElementAtIndex(1));
+    EXPECT_TRUE(copy.IsContiguous()) << msg << " Failure: SetElementAtIndex";
+    EXPECT_EQ(copy.GetElementAtIndex(1), op2.GetElementAtIndex(1)) << msg;
+    EXPECT_EQ(copy.GetElementAtIndex(0), op1.GetElementAtIndex(0)) << msg;
+
+    copy.DropLastElement();
+    EXPECT_TRUE(copy.IsContiguous()) << msg << " Failure: DropLastElement";
+
+    Element::SetStoragePolicy(TOWER_HEAP);
+    Element heap(op1);
+    EXPECT_FALSE(heap.IsContiguous()) << msg << " Failure: policy not restored";
+}
+
+TEST(UTDCRTPoly, DCRT_slab_storage_policy) {
+    RUN_BIG_DCRTPOLYS(DCRT_slab_storage_policy, "DCRT DCRT_slab_storage_policy");
+}
+
+template <typename Element>
+void DCRT_storage_scope(const std::string& msg) {
+    usint order     = 16;
+    usint nBits     = 24;
+    usint towersize = 3;
+
+    std::shared_ptr<ILDCRTParams<typename Element::Integer>> ildcrtparams =
+        GenerateDCRTParams<typename Element::Integer>(order, towersize, nBits);
+
+    typename Element::DugType dug;
+    Element op1(dug, ildcrtparams, Format::EVALUATION);
+
+    {
+        typename Element::StorageScope scope(LIMB_SLAB);
+        EXPECT_EQ(Element::GetStoragePolicy(), LIMB_SLAB) << msg;
+        {
+            typename Element::StorageScope inner(TOWER_HEAP);
+            EXPECT_FALSE(Element(op1).IsContiguous()) << msg << " Failure: nested scope";
+        }
+
+        // a slab released on this thread is handed out again for the next temporary of its size
+        Element first(op1);
+        EXPECT_TRUE(first.IsContiguous()) << msg << " Failure: scoped copy";
+        uint64_t* data = first.GetRawView().data;
+        first          = Element();
+        ScratchPool::ResetStats();
+        Element second(op1);
+        EXPECT_TRUE(second.IsContiguous()) << msg;
+        EXPECT_EQ(second.GetRawView().data, data) << msg << " Failure: slab not recycled";
+        EXPECT_EQ(second, op1) << msg;
+        ScratchPoolStats stats = ScratchPool::GetStats();
+        EXPECT_EQ(stats.reuses, 1u) << msg;
+        EXPECT_EQ(stats.allocations, 0u) << msg;
+    }
+    EXPECT_EQ(Element::GetStoragePolicy(), TOWER_HEAP) << msg << " Failure: scope not restored";
+    EXPECT_FALSE(Element(op1).IsContiguous()) << msg;
+}
+
+TEST(UTDCRTPoly, DCRT_storage_scope) {
+    RUN_BIG_DCRTPOLYS(DCRT_storage_scope, "DCRT DCRT_storage_scope");
+}
+
+TEST(UTDCRTPoly, DCRT_scratch_pool_limits) {
+    const size_t totalLimit = ScratchPool::GetTotalCacheLimit();
+    const size_t bytes      = ScratchPool::RoundUp(1000);
+    ScratchPool::Trim();
+
+    // blocks past the total of all threads go back to the system
+    ScratchPool::SetTotalCacheLimit(ScratchPool::GetStats().bytesCached + bytes);
+    ScratchPool::ResetStats();
+    void* first  = ScratchPool::Acquire(bytes);
+    void* second = ScratchPool::Acquire(bytes);
+    ScratchPool::Release(first, bytes);
+    ScratchPool::Release(second, bytes);
+    ScratchPoolStats stats = ScratchPool::GetStats();
+    EXPECT_EQ(stats.releases, 1u);
+    EXPECT_EQ(stats.frees, 1u);
+
+    // Trim() gives back what the thread cached
+    const uint64_t cached = stats.bytesCached;
+    ScratchPool::Trim();
+    EXPECT_EQ(ScratchPool::GetStats().bytesCached, cached - bytes);
+
+    ScratchPool::SetTotalCacheLimit(totalLimit);
+}
+
+template <typename Element>
+void DCRT_format_cache(const std::string& msg) {
+    usint order     = 16;
+    usint nBits     = 24;
+    usint towersize = 3;
+
+    std::shared_ptr<ILDCRTParams<typename Element::Integer>> ildcrtparams =
+        GenerateDCRTParams<typename Element::Integer>(order, towersize, nBits);
+
+    typename Element::DugType dug;
+    Element op1(dug, ildcrtparams, Format::EVALUATION);
+    Element coeff(op1);
+    coeff.SwitchFormat();
+    Element sum(op1 + op1);
+    sum.SwitchFormat();
+
+    PolyFormatCache::SetEnabled(true);
+    PolyFormatCache::ResetStats();
+    Element x(op1);
+    x.SetFormat(Format::COEFFICIENT);
+    EXPECT_EQ(x, coeff) << msg;
+    x.SetFormat(Format::EVALUATION);
+    EXPECT_EQ(x, op1) << msg;
+    PolyFormatCacheStats stats = PolyFormatCache::GetStats();
+    EXPECT_EQ(stats.transforms, towersize) << msg;
+    EXPECT_EQ(stats.transformsAvoided, towersize) << msg << " Failure: round trip";
+
+    // a copy shares the recorded formats until its first write
+    Element y(x);
+    y.SwitchFormat();
+    EXPECT_EQ(y, coeff) << msg;
+    y.SwitchFormat();
+    y += op1;
+    y.SwitchFormat();
+    EXPECT_EQ(y, sum) << msg << " Failure: stale cached format";
+    stats = PolyFormatCache::GetStats();
+    EXPECT_EQ(stats.transforms, 2 * towersize) << msg;
+    EXPECT_EQ(stats.transformsAvoided, 3 * towersize) << msg;
+    EXPECT_EQ(stats.invalidations, towersize) << msg;
+    EXPECT_EQ(x, op1) << msg << " Failure: write leaked into a copy";
+
+    // towers moved into a slab keep the recorded formats and take the values in place
+    Element v(x);
+    v.MakeContiguous();
+    v.SetFormat(Format::COEFFICIENT);
+    EXPECT_TRUE(v.IsContiguous()) << msg;
+    EXPECT_EQ(v, coeff) << msg;
+    EXPECT_EQ(PolyFormatCache::GetStats().transforms, 2 * towersize) << msg << " Failure: slab round trip";
+
+    // the transform of a copy is recorded for the original as well
+    Element u(dug, ildcrtparams, Format::EVALUATION);
+    PolyFormatCache::ResetStats();
+    Element uc(u);
+    uc.SwitchFormat();
+    Element ud(u);
+    ud.SwitchFormat();
+    EXPECT_EQ(ud, uc) << msg;
+    stats = PolyFormatCache::GetStats();
+    EXPECT_EQ(stats.transforms, towersize) << msg;
+    EXPECT_EQ(stats.transformsAvoided, towersize) << msg << " Failure: original not recorded";
+
+    // an element write keeps the record, which the switch then finds stale
+    Element w(u);
+    w.GetAllElements()[0][0] = (w.GetElementAtIndex(0)[0] == 0) ? 1 : 0;
+    EXPECT_TRUE(w.GetElementAtIndex(0).HasFormatCache()) << msg;
+    w.SwitchFormat();
+    EXPECT_NE(w.GetElementAtIndex(0), uc.GetElementAtIndex(0)) << msg << " Failure: stale cached format";
+    EXPECT_EQ(w.GetElementAtIndex(1), uc.GetElementAtIndex(1)) << msg;
+    EXPECT_FALSE(w.GetElementAtIndex(0).HasFormatCache()) << msg << " Failure: stale record kept";
+    stats = PolyFormatCache::GetStats();
+    EXPECT_EQ(stats.transforms, towersize + 1) << msg;
+    EXPECT_EQ(stats.invalidations, 1U) << msg;
+
+    PolyFormatCache::SetEnabled(false);
+    Element z(dug, ildcrtparams, Format::EVALUATION);
+    Element zc(z);
+    zc.SwitchFormat();
+    EXPECT_FALSE(zc.GetElementAtIndex(0).HasFormatCache()) << msg << " Failure: cache not disabled";
+}
+
+TEST(UTDCRTPoly, DCRT_format_cache) {
+    RUN_BIG_DCRTPOLYS(DCRT_format_cache, "DCRT DCRT_format_cache");
+}
+
+template <typename Element>
+void DCRT_inner_product(const std::string& msg) {
+    usint order     = 16;
+    usint towersize = 3;
+
+    // 60-bit moduli with more digits than 128 bits hold products of, to go through the partial reductions
+    for (usint nBits : {24, 59}) {
+        for (usint numDigits : {1, 5, 1100}) {
+            auto params    = GenerateDCRTParams<typename Element::Integer>(order, towersize, nBits);
+            auto paramsExt = GenerateDCRTParams<typename Element::Integer>(order, towersize + 2, nBits);
+            // digits on towers 0, 3 and 4 of the keys, as the towers of Ql and P in hybrid key switching
+            std::vector<uint32_t> keyTowers{0, 3, 4};
+            std::vector<std::shared_ptr<ILNativeParams>> towers;
+            for (auto t : keyTowers)
+                towers.push_back(paramsExt->GetParams()[t]);
+            auto paramsSub = std::make_shared<ILDCRTParams<typename Element::Integer>>(order, towers);
+
+            typename Element::DugType dug;
+            std::vector<Element> digits, keys, digitsSub, keysExt;
+            Element expected(params, Format::EVALUATION, true);
+            Element expectedSub(paramsSub, Format::EVALUATION, true);
+            for (usint j = 0; j < numDigits; j++) {
+                digits.emplace_back(dug, params, Format::EVALUATION);
+                keys.emplace_back(dug, params, Format::EVALUATION);
+                expected += digits[j] * keys[j];
+
+                digitsSub.emplace_back(dug, paramsSub, Format::EVALUATION);
+                keysExt.emplace_back(dug, paramsExt, Format::EVALUATION);
+                Element k(paramsSub, Format::EVALUATION, true);
+                for (usint i = 0; i < towersize; i++)
+                    k.SetElementAtIndex(i, keysExt[j].GetElementAtIndex(keyTowers[i]));
+                expectedSub += digitsSub[j] * k;
+            }
+            std::string what = msg + " " + std::to_string(nBits) + " bits, " + std::to_string(numDigits) + " digits";
+            EXPECT_EQ(Element::InnerProduct(digits, keys), expected) << what;
+            EXPECT_EQ(Element::InnerProduct(digitsSub, keysExt, keyTowers), expectedSub)
+                << what << " Failure: keyTowers";
+
+            Element acc(expected);
+            acc.MultiplyAccumulate(digits[0], keys[0]);
+            EXPECT_EQ(acc, expected + digits[0] * keys[0]) << what << " Failure: MultiplyAccumulate";
+        }
+    }
+
+    auto params = GenerateDCRTParams<typename Element::Integer>(order, towersize, 24);
+    typename Element::DugType dug;
+    std::vector<Element> digits{Element(dug, params, Format::EVALUATION)};
+    std::vector<Element> coeffKeys{Element(dug, params, Format::COEFFICIENT)};
+    EXPECT_THROW(Element::InnerProduct(digits, coeffKeys), not_implemented_error) << msg;
+    EXPECT_THROW(Element::InnerProduct(digits, {}), math_error) << msg;
+}
+
+TEST(UTDCRTPoly, DCRT_inner_product) {
+    RUN_BIG_DCRTPOLYS(DCRT_inner_product, "DCRT DCRT_inner_product");
+}
+
+template <typename Element>
+void DCRT_shoup_precon(const std::string& msg) {
+    usint order     = 16;
+    usint towersize = 3;
+
+    for (usint nBits : {24, 59}) {
+        auto params = GenerateDCRTParams<typename Element::Integer>(order, towersize, nBits);
+        typename Element::DugType dug;
+        Element a(dug, params, Format::EVALUATION);
+        Element b(dug, params, Format::EVALUATION);
+        auto bPrecon     = b.ComputeShoupPrecon();
+        std::string what = msg + " " + std::to_string(nBits) + " bits";
+        ASSERT_EQ(bPrecon.size(), towersize) << what;
+
+        Element c(a);
+        c.TimesShoupEq(b, bPrecon);
+        EXPECT_EQ(c, a * b) << what;
+
+        // a level-reduced operand uses the leading towers of the precomputations
+        Element d(a);
+        d.DropLastElement();
+        Element expected(d);
+        expected *= b;
+        d.TimesShoupEq(b, bPrecon);
+        EXPECT_EQ(d, expected) << what << " Failure: fewer towers";
+
+        Element other(dug, GenerateDCRTParams<typename Element::Integer>(order, towersize, nBits - 1),
+                      Format::EVALUATION);
+        EXPECT_THROW(other.TimesShoupEq(b, bPrecon), math_error) << what;
+    }
+
+    auto params = GenerateDCRTParams<typename Element::Integer>(order, towersize, 24);
+    typename Element::DugType dug;
+    Element coeff(dug, params, Format::COEFFICIENT);
+    EXPECT_THROW(coeff.ComputeShoupPrecon(), not_implemented_error) << msg;
+}
+
+TEST(UTDCRTPoly, DCRT_shoup_precon) {
+    RUN_BIG_DCRTPOLYS(DCRT_shoup_precon, "DCRT DCRT_shoup_precon");
+}
+
+template <typename Element>
+void DCRT_seeded_uniform(const std::string& msg) {
+    usint order     = 1024;
+    usint towersize = 3;
+    auto params     = GenerateDCRTParams<typename Element::Integer>(order, towersize, 59);
+
+    PRNGSeed seed{};
+    seed[0] = 42;
+    Element a(seed, 0, params, Format::EVALUATION);
+    EXPECT_EQ(a.GetFormat(), Format::EVALUATION) << msg;
+    EXPECT_EQ(a, Element(seed, 0, params, Format::EVALUATION)) << msg << " not reproduced from its seed";
+    EXPECT_NE(a, Element(seed, 1, params, Format::EVALUATION)) << msg << " same values for another stream";
+    seed[0] = 43;
+    EXPECT_NE(a, Element(seed, 0, params, Format::EVALUATION)) << msg << " same values for another seed";
+
+    for (usint i = 0; i < towersize; ++i) {
+        const auto& values = a.GetElementAtIndex(i).GetValues();
+        EXPECT_EQ(values.GetLength(), order / 2) << msg;
+        for (usint k = 0; k < values.GetLength(); ++k)
+            ASSERT_LT(values[k], params->GetParams()[i]->GetModulus()) << msg << " tower " << i;
+        EXPECT_NE(a.GetElementAtIndex(i), a.GetElementAtIndex((i + 1) % towersize)) << msg << " towers repeat";
+    }
+}
+
+TEST(UTDCRTPoly, DCRT_seeded_uniform) {
+    RUN_BIG_DCRTPOLYS(DCRT_seeded_uniform, "DCRT DCRT_seeded_uniform");
+}
+
+#if defined(HAVE_INT128) && NATIVEINT == 64
+// the tiled basis conversion against the coefficient-major sum, at every SIMD level and with a partial tile
+TEST(UTDCRTPoly, DCRT_approx_switch_crt_basis) {
+    using intnat::NTTSimdLevel;
+    NTTSimdLevel supported = intnat::GetNTTSimdLevelSupported();
+    for (usint bits : {30, 50, 59}) {
+        for (usint order : {32, 2048}) {
+            auto paramsQ = GenerateDCRTParams<BigInteger>(order, 5, bits);
+            auto paramsP = GenerateDCRTParams<BigInteger>(order, 3, bits - 1);
+            usint sizeQ  = paramsQ->GetParams().size();
+            usint sizeP  = paramsP->GetParams().size();
+            usint n      = paramsQ->GetRingDimension();
+
+            DiscreteUniformGeneratorImpl<NativeVector> dug;
+            auto draw = [&dug](const NativeInteger& modulus) {
+                dug.SetModulus(modulus);
+                return dug.GenerateInteger();
+            };
+            std::vector<NativeInteger> scale(sizeQ), scalePrecon(sizeQ);
+            std::vector<std::vector<NativeInteger>> matrix(sizeQ, std::vector<NativeInteger>(sizeP));
+            std::vector<DoubleNativeInt> mu(sizeP);
+            for (usint j = 0; j < sizeP; j++)
+                mu[j] = ~DoubleNativeInt(0) / paramsP->GetParams()[j]->GetModulus().ConvertToInt();
+            for (usint i = 0; i < sizeQ; i++) {
+                const NativeInteger& qi = paramsQ->GetParams()[i]->GetModulus();
+                scale[i]                = draw(qi);
+                scalePrecon[i]          = scale[i].PrepModMulConst(qi);
+                for (usint j = 0; j < sizeP; j++)
+                    matrix[i][j] = draw(paramsP->GetParams()[j]->GetModulus());
+            }
+
+            DCRTPoly x(dug, paramsQ, Format::COEFFICIENT);
+            DCRTPoly expected(paramsP, Format::COEFFICIENT, true);
+            for (usint k = 0; k < n; k++) {
+                for (usint j = 0; j < sizeP; j++) {
+                    const NativeInteger& pj = paramsP->GetParams()[j]->GetModulus();
+                    DoubleNativeInt sum     = 0;
+                    for (usint i = 0; i < sizeQ; i++) {
+                        const NativeInteger& qi = paramsQ->GetParams()[i]->GetModulus();
+                        NativeInteger xi = x.GetElementAtIndex(i)[k].ModMulFastConst(scale[i], qi, scalePrecon[i]);
+                        sum += DoubleNativeInt(xi.ConvertToInt()) * matrix[i][j].ConvertToInt();
+                    }
+                    expected.GetAllElements()[j][k] = NativeInteger(uint64_t(sum % pj.ConvertToInt()));
+                }
+            }
+
+            for (int level = 0; level <= static_cast<int>(supported); ++level) {
+                intnat::SetNTTSimdLevel(static_cast<NTTSimdLevel>(level));
+                DCRTPoly result = x.ApproxSwitchCRTBasis(paramsQ, paramsP, scale, scalePrecon, matrix, mu);
+                EXPECT_EQ(result, expected) << static_cast<NTTSimdLevel>(level) << ", " << bits << " bits, n = " << n;
+            }
+        }
+    }
+    intnat::SetNTTSimdLevel(supported);
+}
+#endif
+
 // only need to try this with one
 void testDCRTPolyConstructorNegative(std::vector<NativePoly>& towers) {
     DCRTPoly expectException(towers);
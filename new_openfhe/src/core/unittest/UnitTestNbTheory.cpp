@@ -396,3 +396,17 @@ void test_nextQ(const std::string& msg) {
 TEST(UTNbTheory, test_nextQ) {
     RUN_ALL_BACKENDS_INT(test_nextQ, "test_nextQ")
 }
+
+TEST(UTNbTheory, auto_map_cache) {
+    const uint32_t n = 1 << 10;
+    for (uint32_t k : {3U, 5U, 2 * n - 1}) {
+        std::vector<uint32_t> expected(n);
+        PrecomputeAutoMap(n, k, &expected);
+        const std::vector<uint32_t>& map = GetAutoMap(n, k);
+        EXPECT_EQ(expected, map) << "k = " << k;
+        // the same map is returned for k and for indices congruent to it modulo 2n
+        EXPECT_EQ(&map, &GetAutoMap(n, k)) << "k = " << k;
+        EXPECT_EQ(&map, &GetAutoMap(n, k + 2 * n)) << "k = " << k;
+    }
+    EXPECT_NE(&GetAutoMap(n, 3), &GetAutoMap(n / 2, 3));
+}
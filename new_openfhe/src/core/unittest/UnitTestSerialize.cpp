@@ -143,6 +143,44 @@ void vector_of_bigint(const std::string& msg) {
     sfunc(testvec);
 }
 
+// binary archives bit-pack native vectors at the length of their largest value (version 2), and still read
+// the full words of version 1
+TEST(UTSer, native_vector_packed) {
+    NativeInteger q = FirstPrime<NativeInteger>(59, 2048);
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    for (usint bits : {0, 1, 17, 40, 59, 64}) {
+        for (usint n : {0, 1, 5, 1024, 1500}) {
+            std::stringstream msg;
+            msg << bits << " bits, " << n << " values";
+            NativeInteger mod = (bits == 0 || bits >= 59) ? q : NativeInteger(1) << bits;
+            NativeVector vec(n, mod);
+            if (n > 0 && bits > 0)
+                vec = dug.GenerateVector(n, mod);
+            if (n > 1 && bits == 64)
+                vec[1] = NativeInteger(~uint64_t(0));  // not reduced, the length is the one of the values
+
+            std::stringstream s;
+            Serial::Serialize(vec, s, SerType::BINARY);
+            if (n == 1500 && bits < 64)
+                EXPECT_LT(s.str().size(), n * bits / 8 + 512) << msg.str();
+            NativeVector deser;
+            Serial::Deserialize(deser, s, SerType::BINARY);
+            EXPECT_EQ(vec, deser) << msg.str() << ": packed ser/deser fails";
+            EXPECT_EQ(vec.GetModulus(), deser.GetModulus()) << msg.str();
+
+            std::stringstream v1;
+            {
+                cereal::PortableBinaryOutputArchive oarchive(v1);
+                vec.save(oarchive, 1);
+            }
+            NativeVector deser1;
+            cereal::PortableBinaryInputArchive iarchive(v1);
+            deser1.load(iarchive, 1);
+            EXPECT_EQ(vec, deser1) << msg.str() << ": version 1 ser/deser fails";
+        }
+    }
+}
+
 template <typename Element>
 void ilparams_test(const std::string& msg) {
     auto p = ElemParamFactory::GenElemParams<typename Element::Params>(1024);
@@ -34,6 +34,7 @@
  */
 
 #include <iostream>
+#include <thread>
 #include "gtest/gtest.h"
 
 #include "lattice/lat-hal.h"
@@ -378,3 +379,87 @@ void CRT_CHECK_very_big_ring_precomputed(const std::string& msg) {
 TEST(UTTransform, CRT_CHECK_very_big_ring_precomputed) {
     RUN_BIG_BACKENDS(CRT_CHECK_very_big_ring_precomputed, "CRT_CHECK_very_big_ring_precomputed")
 }
+
+// the vector kernels of the native NTT (math/hal/intnat/transformnat-simd.h) must give the words of the
+// scalar loop, on every level this machine supports and on both sides of the IFMA modulus bound
+TEST(UTTransform, CRT_FTT_simd_matches_scalar) {
+    using intnat::NTTSimdLevel;
+    NTTSimdLevel supported = intnat::GetNTTSimdLevelSupported();
+    for (usint bits : {29, 49, 50, 59}) {
+        for (usint n : {8, 16, 32, 1024}) {
+            usint cycloOrder      = 2 * n;
+            NativeInteger modulus = FirstPrime<NativeInteger>(bits, cycloOrder);
+            NativeInteger root    = RootOfUnity<NativeInteger>(cycloOrder, modulus);
+            DiscreteUniformGeneratorImpl<NativeVector> dug;
+            NativeVector input = dug.GenerateVector(n, modulus);
+
+            intnat::SetNTTSimdLevel(NTTSimdLevel::SCALAR);
+            NativeVector forward(n), inverse(n);
+            ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverse(input, root, cycloOrder,
+                                                                                      &forward);
+            ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverse(input, root, cycloOrder,
+                                                                                        &inverse);
+
+            for (int level = static_cast<int>(NTTSimdLevel::AVX2); level <= static_cast<int>(supported); ++level) {
+                intnat::SetNTTSimdLevel(static_cast<NTTSimdLevel>(level));
+                std::stringstream msg;
+                msg << static_cast<NTTSimdLevel>(level) << ", modulus " << modulus << ", n = " << n;
+                NativeVector result(n), roundTrip(n);
+                ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverse(input, root, cycloOrder,
+                                                                                          &result);
+                EXPECT_EQ(forward, result) << msg.str() << ": forward transform";
+                ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverse(input, root, cycloOrder,
+                                                                                            &result);
+                EXPECT_EQ(inverse, result) << msg.str() << ": inverse transform";
+                ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverse(forward, root,
+                                                                                            cycloOrder, &roundTrip);
+                EXPECT_EQ(input, roundTrip) << msg.str() << ": round trip";
+            }
+        }
+    }
+    intnat::SetNTTSimdLevel(supported);
+}
+
+// the registry of the native NTT tables gives one id per modulus and cyclotomic order, also to threads
+// registering concurrently, and the transforms by id are the transforms by root of unity
+TEST(UTTransform, CRT_FTT_tables_registry) {
+    using FTT          = ChineseRemainderTransformFTT<NativeVector>;
+    usint n            = 64;
+    usint cycloOrder   = 2 * n;
+    NativeInteger q    = FirstPrime<NativeInteger>(40, 2 * cycloOrder);
+    NativeInteger root = RootOfUnity<NativeInteger>(cycloOrder, q);
+
+    uint32_t id = FTT::RegisterTables(root, cycloOrder, q);
+    EXPECT_NE(id, 0u);
+    EXPECT_EQ(id, FTT::RegisterTables(root, cycloOrder, q));
+    EXPECT_EQ(FTT::GetTables(id).modulus, q);
+    EXPECT_NE(id, FTT::RegisterTables(RootOfUnity<NativeInteger>(2 * cycloOrder, q), 2 * cycloOrder, q));
+
+    ILNativeParams params(cycloOrder, q, root);
+    EXPECT_EQ(id, params.GetNTTTablesId());
+    EXPECT_EQ(id, ILNativeParams(params).GetNTTTablesId());
+
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    NativeVector input = dug.GenerateVector(n, q);
+    NativeVector expected(n), result(input);
+    FTT().ForwardTransformToBitReverse(input, root, cycloOrder, &expected);
+    FTT().ForwardTransformToBitReverseInPlace(id, &result);
+    EXPECT_EQ(expected, result) << "forward transform";
+    FTT().InverseTransformFromBitReverseInPlace(id, &result);
+    EXPECT_EQ(input, result) << "round trip";
+
+    NativeVector other(n, FirstPrime<NativeInteger>(41, cycloOrder));
+    EXPECT_THROW(FTT().ForwardTransformToBitReverseInPlace(id, &other), math_error);
+
+    NativeInteger q2 = PreviousPrime<NativeInteger>(FirstPrime<NativeInteger>(45, cycloOrder), cycloOrder);
+    NativeInteger r2 = RootOfUnity<NativeInteger>(cycloOrder, q2);
+    std::vector<uint32_t> ids(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < ids.size(); ++i)
+        threads.emplace_back([&, i] { ids[i] = FTT::RegisterTables(r2, cycloOrder, q2); });
+    for (auto& t : threads)
+        t.join();
+    for (auto i : ids)
+        EXPECT_EQ(ids[0], i);
+    EXPECT_NE(ids[0], 0u);
+}
@@ -104,6 +104,8 @@ void testNTT(int qbit, uint32_t L, int logN) {
         c.SetFormat(Format::COEFFICIENT);
     }
     c1->SetElements(cv);
+    // c1_raw is a view of c1, so keep a copy of the input for the comparison below
+    auto reference = c1->GetElements();
 
     auto c1_raw=GetRawCipherText(cc, c1);
     //std::cout << "Moving C1 to GPU" << std::endl;
@@ -142,6 +144,22 @@ void testNTT(int qbit, uint32_t L, int logN) {
 
     float avg_speedup = ( (float) (cpu_ntt_duration+cpu_intt_duration) ) / ((float) (gpu_ntt_duration+gpu_intt_duration));
     std::cout << "Average speedup: " << avg_speedup << "x" << std::endl;
+
+    // the GPU tables come from the same precomputation as SwitchFormat(), so the results must
+    // match the CPU bit for bit
+    MoveToHost(&c1_raw);
+    cv = reference;
+    bool identical = true;
+    for (size_t p = 0; p < 2; p++) {
+        cv[p].SetFormat(Format::EVALUATION);
+        uint64_t* gpu = p == 0 ? c1_raw.sub_0 : c1_raw.sub_1;
+        for (int r = 0; r < c1_raw.numRes; r++) {
+            for (int i = 0; i < c1_raw.N; i++) {
+                identical &= cv[p].GetElementAtIndex(r)[i].ConvertToInt() == gpu[r * c1_raw.N + i];
+            }
+        }
+    }
+    std::cout << "GPU NTT " << (identical ? "matches" : "DOES NOT match") << " SwitchFormat()" << std::endl;
 }
 
 int main() {
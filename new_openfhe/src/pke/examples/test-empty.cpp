@@ -129,7 +129,7 @@ int main() {
         int numOps=numVectors/2;
         for (int i = 0; i < numOps; ++i) {
             // Launch thread
-            threads.emplace_back(gpuEmptyKernel);
+            threads.emplace_back(launchEmptyKernel);
         }
 
         for (auto &thread : threads) {
@@ -150,5 +150,32 @@ int main() {
 
     }
 
+    // same launches spread over the streams of an execution context, waiting on the
+    // returned futures instead of synchronizing the device
+    ExecContext ctx;
+    for (int i=1; i<=16; i++) {
+        int numOps = std::pow(2, i) / 2;
+
+        start = std::chrono::high_resolution_clock::now();
+
+        std::vector<GpuFuture> futures;
+        for (int j = 0; j < ctx.NumComputeStreams(); ++j) {
+            hipStream_t stream = ctx.AcquireStream();
+            for (int k = j; k < numOps; k += ctx.NumComputeStreams()) {
+                gpuEmptyKernel(stream);
+            }
+            futures.push_back(ctx.Record(stream));
+        }
+        for (auto &f : futures) {
+            f.Wait();
+        }
+
+        end = std::chrono::high_resolution_clock::now();
+        duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+        std::cout << "Number of Kernels on " << ctx.NumComputeStreams() << " streams: " << numOps << std::endl;
+        std::cout << "total time " << duration << "us" << std::endl;
+    }
+
     return 0;
 }
@@ -0,0 +1,139 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Relinearized CKKS multiplication on raw ciphertexts, checked against CryptoContext::EvalMult
+ */
+
+#include "openfhe.h"
+#include "gpu_functions.h"
+#include "rawkeyswitch.h"
+
+using namespace lbcrypto;
+
+bool sameElements(const Ciphertext<DCRTPoly>& a, const Ciphertext<DCRTPoly>& b) {
+    return a->GetElements() == b->GetElements() && a->GetNoiseScaleDeg() == b->GetNoiseScaleDeg();
+}
+
+void testRelin(uint32_t multDepth, uint32_t numDigits, int logN) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetMultiplicativeDepth(multDepth);
+    parameters.SetScalingModSize(50);
+    parameters.SetBatchSize(8);
+    parameters.SetRingDim(1 << logN);
+    parameters.SetScalingTechnique(FIXEDMANUAL);
+    parameters.SetKeySwitchTechnique(HYBRID);
+    parameters.SetNumLargeDigits(numDigits);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    auto keys = cc->KeyGen();
+    cc->EvalMultKeyGen(keys.secretKey);
+    auto evalKey = cc->GetEvalMultKeyVector(keys.secretKey->GetKeyTag())[0];
+
+    RawKeySwitch<CPUKeySwitchBackend> ksCPU(cc);
+    RawKeySwitch<GPUKeySwitchBackend> ksGPU(cc);
+    RawEvalKey keyCPU = ksCPU.UploadEvalKey(evalKey);
+    RawEvalKey keyGPU = ksGPU.UploadEvalKey(evalKey);
+
+    std::vector<double> x1 = {1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<double> x2 = {0.5, 0.25, 2, 1, -1, 3, 0.125, 4};
+    auto c1 = cc->Encrypt(keys.publicKey, cc->MakeCKKSPackedPlaintext(x1));
+    auto c2 = cc->Encrypt(keys.publicKey, cc->MakeCKKSPackedPlaintext(x2));
+
+    std::cout << "Log N = " << logN << "  depth = " << multDepth << "  digits = " << numDigits << std::endl;
+    // every level down to a single limb, so that partial last digits are covered too
+    for (uint32_t level = 0; level <= multDepth; level++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        auto reference = cc->EvalMult(c1, c2);
+        auto end = std::chrono::high_resolution_clock::now();
+        auto cpu_duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+        // raw ciphertexts are views of their inputs, so work on clones
+        auto a = c1->Clone();
+        auto b = c2->Clone();
+        auto a_raw = GetRawCipherText(cc, a);
+        auto b_raw = GetRawCipherText(cc, b);
+        EvalMultCPU(&a_raw, &b_raw, ksCPU, keyCPU);
+        bool cpu_ok = sameElements(a, reference);
+
+        auto g = c1->Clone();
+        auto h = c2->Clone();
+        auto g_raw = GetRawCipherText(cc, g);
+        auto h_raw = GetRawCipherText(cc, h);
+        MoveToGPU(&g_raw);
+        MoveToGPU(&h_raw);
+        // warm up: uploads the tables of this level
+        EvalMultGPU(&g_raw, &h_raw, ksGPU, keyGPU).Wait();
+        MoveToHost(&g_raw);
+        MoveToHost(&h_raw);
+        bool gpu_ok = sameElements(g, reference);
+
+        g = c1->Clone();
+        h = c2->Clone();
+        g_raw = GetRawCipherText(cc, g);
+        h_raw = GetRawCipherText(cc, h);
+        MoveToGPU(&g_raw);
+        MoveToGPU(&h_raw);
+        g_raw.ready.Wait();
+        h_raw.ready.Wait();
+        start = std::chrono::high_resolution_clock::now();
+        EvalMultGPU(&g_raw, &h_raw, ksGPU, keyGPU).Wait();
+        end = std::chrono::high_resolution_clock::now();
+        auto gpu_duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        MoveToHost(&g_raw);
+        MoveToHost(&h_raw);
+
+        std::cout << "  limbs " << a_raw.numRes << ": CPU reference " << (cpu_ok ? "matches" : "DOES NOT match")
+                  << ", GPU " << (gpu_ok ? "matches" : "DOES NOT match") << " EvalMult, "
+                  << cpu_duration << "us on CPU, " << gpu_duration << "us on GPU" << std::endl;
+
+        if (level < multDepth) {
+            c1 = cc->Rescale(c1);
+            c2 = cc->Rescale(c2);
+        }
+    }
+
+    ksCPU.FreeEvalKey(keyCPU);
+    ksGPU.FreeEvalKey(keyGPU);
+}
+
+int main() {
+    // one digit per limb, a few limbs per digit, and a last digit shorter than the others
+    testRelin(3, 4, 12);
+    testRelin(5, 2, 13);
+    testRelin(4, 3, 12);
+    return 0;
+}
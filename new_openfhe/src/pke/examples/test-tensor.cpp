@@ -0,0 +1,127 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Batched ciphertext tensor product on raw ciphertexts, checked against CryptoContext::EvalMultNoRelin
+ */
+
+#include "openfhe.h"
+#include "gpu_functions.h"
+#include "rawciphertext.h"
+
+using namespace lbcrypto;
+
+// MoveToHost downloads d2 as the third element, so the result compares directly
+bool sameTensor(const Ciphertext<DCRTPoly>& ct, const Ciphertext<DCRTPoly>& reference) {
+    return ct->GetElements()==reference->GetElements();
+}
+
+int main() {
+    const int numPairs=10;
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetMultiplicativeDepth(4);
+    parameters.SetScalingModSize(50);
+    parameters.SetBatchSize(8);
+    parameters.SetRingDim(1 << 13);
+    parameters.SetScalingTechnique(FIXEDMANUAL);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(LEVELEDSHE);
+    auto keys = cc->KeyGen();
+
+    std::vector<Ciphertext<DCRTPoly>> c1s, c2s, references;
+    for (int i=0; i<numPairs; i++) {
+        std::vector<double> x1 = {1.0*i, 2, 3, 4};
+        std::vector<double> x2 = {0.5, -1.0*i, 2, 1};
+        c1s.push_back(cc->Encrypt(keys.publicKey, cc->MakeCKKSPackedPlaintext(x1)));
+        c2s.push_back(cc->Encrypt(keys.publicKey, cc->MakeCKKSPackedPlaintext(x2)));
+        references.push_back(cc->EvalMultNoRelin(c1s[i], c2s[i]));
+    }
+
+    // every pair into a fresh ciphertext, in one call (more pairs than TENSOR_MAX_BATCH)
+    std::vector<RawCipherText> a_raw, b_raw, d_raw;
+    for (int i=0; i<numPairs; i++) {
+        a_raw.push_back(GetRawCipherText(cc, c1s[i]->Clone()));
+        b_raw.push_back(GetRawCipherText(cc, c2s[i]->Clone()));
+    }
+    std::vector<RawCipherText*> as, bs, ds;
+    for (int i=0; i<numPairs; i++) {
+        MoveToGPU(&a_raw[i]);
+        MoveToGPU(&b_raw[i]);
+        d_raw.push_back(AllocateGPUCipherText(&a_raw[i]));
+    }
+    for (int i=0; i<numPairs; i++) {
+        as.push_back(&a_raw[i]);
+        bs.push_back(&b_raw[i]);
+        ds.push_back(&d_raw[i]);
+    }
+    EvalMultGPUNoRelinBatch(as, bs, ds).Wait();
+    auto start = std::chrono::high_resolution_clock::now();
+    EvalMultGPUNoRelinBatch(as, bs, ds).Wait();
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    bool ok=true;
+    for (int i=0; i<numPairs; i++) {
+        MoveToHost(&d_raw[i]);
+        MoveToHost(&a_raw[i]);
+        MoveToHost(&b_raw[i]);
+        ok&=sameTensor(GetOpenFHECipherText(d_raw[i]), references[i]);
+    }
+    std::cout << numPairs << " pairs into fresh ciphertexts " << (ok ? "match" : "DO NOT match")
+              << " EvalMultNoRelin, " << duration << "us" << std::endl;
+
+    // in place, the result replaces the first operand
+    auto a=c1s[0]->Clone();
+    auto b=c2s[0]->Clone();
+    auto a_in=GetRawCipherText(cc, a);
+    auto b_in=GetRawCipherText(cc, b);
+    MoveToGPU(&a_in);
+    MoveToGPU(&b_in);
+    EvalMultGPUNoRelin(&a_in, &b_in);
+    MoveToHost(&a_in);
+    MoveToHost(&b_in);
+    bool inPlaceOk=sameTensor(a, references[0]) && b->GetElements()==c2s[0]->GetElements();
+    std::cout << "in place " << (inPlaceOk ? "matches" : "DOES NOT match") << " EvalMultNoRelin" << std::endl;
+
+    // a downloaded tensor product goes back to the GPU with its d2, twice over
+    bool roundTripOk=true;
+    for (int i=0; i<2; i++) {
+        MoveToGPU(&a_in);
+        MoveToHost(&a_in);
+        roundTripOk&=sameTensor(GetOpenFHECipherText(a_in), references[0]);
+    }
+    std::cout << "round trips " << (roundTripOk ? "keep" : "DO NOT keep") << " d2" << std::endl;
+    return ok && inPlaceOk && roundTripOk ? 0 : 1;
+}
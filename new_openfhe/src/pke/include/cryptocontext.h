@@ -3215,6 +3215,25 @@ public:
         GetScheme()->EvalBootstrapSetup(*this, levelBudget, dim1, slots, correctionFactor);
     }
     /**
+   * Limits the memory used by the bootstrapping linear transforms. Supported in CKKS only.
+   * Has to be called before EvalBootstrapSetup. With a budget set, CoeffsToSlots and
+   * SlotsToCoeffs stream the hoisted baby-step rotations through a fixed number of
+   * extended ciphertexts instead of materializing all of them; the result is identical.
+   * The budget is a target, not a hard bound: it covers the hoisted digits, the rotations
+   * and partial sums kept alive, and an estimate of the temporaries of each rotation in
+   * flight, but a transform always keeps at least three extended ciphertexts, and the
+   * allocations inside key switching and the diagonals are not counted.
+   *
+   * @param memoryBudget target in bytes for the working set of one linear transform;
+   * 0 (default) keeps all the rotations resident
+   * @param compactDiagonals if true, the FFT-like encoding/decoding diagonals are stored as
+   * double-precision slot values and encoded on the fly, instead of as plaintexts in the
+   * extended basis
+   */
+    void EvalBootstrapSetMemoryBudget(uint64_t memoryBudget, bool compactDiagonals = false) {
+        GetScheme()->EvalBootstrapSetMemoryBudget(memoryBudget, compactDiagonals);
+    }
+    /**
    * Generates all automorphism keys for EvalBootstrap. Supported in CKKS only.
    * EvalBootstrapKeyGen uses the baby-step/giant-step strategy.
    *
@@ -3248,6 +3267,16 @@ public:
         }
     }
     /**
+   * Finds the rotation indices EvalBootstrapKeyGen generates keys for. Supported in CKKS only.
+   * Requires EvalBootstrapSetup to have been called for the given number of slots.
+   *
+   * @param slots number of slots to be bootstrapped
+   * @return the rotation indices
+   */
+    std::vector<int32_t> FindBootstrapRotationIndices(uint32_t slots) const {
+        return GetScheme()->FindBootstrapRotationIndices(slots, GetCyclotomicOrder());
+    }
+    /**
    * Defines the bootstrapping evaluation of ciphertext using either the
    * FFT-like method or the linear method
    *
@@ -3261,6 +3290,26 @@ public:
                                       uint32_t precision = 0) const {
         return GetScheme()->EvalBootstrap(ciphertext, numIterations, precision);
     }
+    /**
+   * Bootstraps several independent ciphertexts concurrently. Supported in CKKS only.
+   * The available threads are split into groups, each group refreshes one ciphertext at a
+   * time, and the operations inside a bootstrap only use the threads of their group.
+   * All groups share the bootstrapping precomputations and rotation keys of this context.
+   * The results are identical to calling EvalBootstrap on each ciphertext.
+   * Groups of more than one thread need nested OpenMP parallelism, which this call does not
+   * turn on: enable it once at startup with omp_set_max_active_levels(2) or
+   * OMP_MAX_ACTIVE_LEVELS=2. Otherwise fewer ciphertexts than threads are bootstrapped one
+   * after another, each with all the threads.
+   *
+   * @param ciphertexts the input ciphertexts.
+   * @param numIterations number of iterations to run iterative bootstrapping (Meta-BTS).
+   * @param precision precision of initial bootstrapping algorithm (see EvalBootstrap).
+   * @return the refreshed ciphertexts, in the order of the input.
+   */
+    std::vector<Ciphertext<Element>> EvalBootstrapBatch(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                        uint32_t numIterations = 1, uint32_t precision = 0) const {
+        return GetScheme()->EvalBootstrapBatch(ciphertexts, numIterations, precision);
+    }
 
     //------------------------------------------------------------------------------
     // Scheme switching Methods
@@ -72,6 +72,8 @@ protected:
     mutable Poly encodedVector;
     mutable NativePoly encodedNativeVector;
     mutable DCRTPoly encodedVectorDCRT;
+    // Shoup precomputations of encodedVectorDCRT in EVALUATION format, see ComputeShoupPrecon()
+    std::shared_ptr<const std::vector<NativeVector>> encodedVectorDCRTPrecon;
 
     static constexpr int intCTOR     = 0x01;
     static constexpr int vecintCTOR  = 0x02;
@@ -117,6 +119,7 @@ public:
           encodingParams(rhs.encodingParams),
           encodedVector(rhs.encodedVector),
           encodedVectorDCRT(rhs.encodedVectorDCRT),
+          encodedVectorDCRTPrecon(rhs.encodedVectorDCRTPrecon),
           scalingFactor(rhs.scalingFactor),
           scalingFactorInt(rhs.scalingFactorInt),
           level(rhs.level),
@@ -130,6 +133,7 @@ public:
           encodingParams(std::move(rhs.encodingParams)),
           encodedVector(std::move(rhs.encodedVector)),
           encodedVectorDCRT(std::move(rhs.encodedVectorDCRT)),
+          encodedVectorDCRTPrecon(std::move(rhs.encodedVectorDCRTPrecon)),
           scalingFactor(rhs.scalingFactor),
           scalingFactorInt(rhs.scalingFactorInt),
           level(rhs.level),
@@ -259,6 +263,35 @@ public:
         OPENFHE_THROW(not_implemented_error, "Generic GetElement() is not implemented");
     }
 
+    /**
+   * Precomputes the Shoup factors of the encoded DCRTPoly, so that the multiplications of ciphertexts by
+   * this plaintext (EvalMult, and EvalMultExt in CKKS) use one multiply-high per coefficient in place of
+   * a Barrett reduction. Worth it for plaintexts multiplied many times, as the diagonals of the linear
+   * transforms; it doubles the memory of the element. The factors are not updated with the element: call
+   * again after changing its values.
+   */
+    void ComputeShoupPrecon() {
+        if (typeFlag != IsDCRTPoly)
+            OPENFHE_THROW(not_implemented_error, "Shoup precomputations are only supported for DCRTPoly");
+        if (encodedVectorDCRT.GetFormat() == Format::EVALUATION) {
+            encodedVectorDCRTPrecon =
+                std::make_shared<const std::vector<NativeVector>>(encodedVectorDCRT.ComputeShoupPrecon());
+        }
+        else {
+            DCRTPoly element(encodedVectorDCRT);
+            element.SetFormat(Format::EVALUATION);
+            encodedVectorDCRTPrecon = std::make_shared<const std::vector<NativeVector>>(element.ComputeShoupPrecon());
+        }
+    }
+
+    /**
+   * GetShoupPrecon
+   * @return the factors of ComputeShoupPrecon() for the element in EVALUATION format, or nullptr
+   */
+    const std::shared_ptr<const std::vector<NativeVector>>& GetShoupPrecon() const {
+        return encodedVectorDCRTPrecon;
+    }
+
     /**
    * GetElementRingDimension
    * @return ring dimension on the underlying element
@@ -128,6 +128,18 @@ public:
         OPENFHE_THROW(not_implemented_error, "GetBVector operation not supported");
     }
 
+    /**
+   * Keeps the vectors A and B of a key that is loaded on demand in memory while the returned handle is
+   * held, so the references returned by GetAVector() and GetBVector() stay valid. Keys that are always in
+   * memory return an empty handle.
+   *
+   * @return handle to hold while the vectors are used
+   */
+
+    virtual std::shared_ptr<const void> Lease() const {
+        return nullptr;
+    }
+
     /**
    * Setter function to store key switch Element.
    * Throws exception, to be overridden by derived class.
@@ -35,9 +35,12 @@
 #include "key/evalkeyrelin-fwd.h"
 #include "key/evalkey.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 /**
@@ -68,7 +71,8 @@ public:
    *@param &rhs key to copy from
    */
     explicit EvalKeyRelinImpl(const EvalKeyRelinImpl<Element>& rhs) : EvalKeyImpl<Element>(rhs.GetCryptoContext()) {
-        m_rKey = rhs.m_rKey;
+        m_rKey  = rhs.m_rKey;
+        m_aSeed = rhs.m_aSeed;
     }
 
     /**
@@ -77,7 +81,8 @@ public:
    *@param &rhs key to move from
    */
     explicit EvalKeyRelinImpl(EvalKeyRelinImpl<Element>&& rhs) : EvalKeyImpl<Element>(rhs.GetCryptoContext()) {
-        m_rKey = std::move(rhs.m_rKey);
+        m_rKey  = std::move(rhs.m_rKey);
+        m_aSeed = std::move(rhs.m_aSeed);
     }
 
     operator bool() const {
@@ -92,6 +97,7 @@ public:
     const EvalKeyRelinImpl<Element>& operator=(const EvalKeyRelinImpl<Element>& rhs) {
         this->context = rhs.context;
         this->m_rKey  = rhs.m_rKey;
+        this->m_aSeed = rhs.m_aSeed;
         return *this;
     }
 
@@ -104,6 +110,7 @@ public:
         this->context = rhs.context;
         rhs.context   = 0;
         m_rKey        = std::move(rhs.m_rKey);
+        m_aSeed       = std::move(rhs.m_aSeed);
         return *this;
     }
 
@@ -115,6 +122,7 @@ public:
    */
     virtual void SetAVector(const std::vector<Element>& a) {
         m_rKey.insert(m_rKey.begin() + 0, a);
+        m_aSeed.clear();
     }
 
     /**
@@ -125,6 +133,7 @@ public:
    */
     virtual void SetAVector(std::vector<Element>&& a) {
         m_rKey.insert(m_rKey.begin() + 0, std::move(a));
+        m_aSeed.clear();
     }
 
     /**
@@ -234,6 +243,27 @@ public:
     virtual void ClearKeys() {
         m_rKey.clear();
         m_dcrtKeys.clear();
+        m_aSeed.clear();
+    }
+
+    /**
+   * Records that element i of the A vector is DCRTPoly(seed, i, params, Format::EVALUATION) with the
+   * parameters of element i of the B vector, so the serialization writes the seed instead of the A vector
+   * and regenerates it on load. Call it after SetAVector(), which forgets the seed.
+   *
+   * @param &seed the seed the A vector was expanded from
+   */
+    void SetASeed(const PRNGSeed& seed) {
+        m_aSeed.assign(seed.begin(), seed.end());
+    }
+
+    /**
+   * Gets the seed of the A vector
+   *
+   * @return the seed, empty if the A vector was not expanded from one
+   */
+    const std::vector<PRNG::result_type>& GetASeed() const {
+        return m_aSeed;
     }
 
     bool key_compare(const EvalKeyImpl<Element>& other) const {
@@ -258,7 +288,17 @@ public:
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
-        ar(::cereal::make_nvp("k", m_rKey));
+        if (version < 2) {
+            ar(::cereal::make_nvp("k", m_rKey));
+            return;
+        }
+        // a seeded A vector is written as its seed
+        const bool seeded{IsASeeded()};
+        ar(::cereal::make_nvp("s", seeded ? m_aSeed : std::vector<PRNG::result_type>()));
+        if (seeded)
+            ar(::cereal::make_nvp("b", m_rKey[1]));
+        else
+            ar(::cereal::make_nvp("k", m_rKey));
     }
 
     template <class Archive>
@@ -268,13 +308,57 @@ public:
                                                  " is from a later version of the library");
         }
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
-        ar(::cereal::make_nvp("k", m_rKey));
+        m_rKey.clear();
+        m_aSeed.clear();
+        if (version >= 2)
+            ar(::cereal::make_nvp("s", m_aSeed));
+        if (m_aSeed.empty()) {
+            ar(::cereal::make_nvp("k", m_rKey));
+            return;
+        }
+
+        if (m_aSeed.size() != std::tuple_size<PRNGSeed>::value)
+            OPENFHE_THROW(deserialize_error, "invalid seed of the A vector");
+        std::vector<Element> b;
+        ar(::cereal::make_nvp("b", b));
+        if constexpr (std::is_same_v<Element, DCRTPoly>) {
+            PRNGSeed seed;
+            std::copy(m_aSeed.begin(), m_aSeed.end(), seed.begin());
+            std::vector<Element> a;
+            a.reserve(b.size());
+            for (size_t i = 0; i < b.size(); ++i)
+                a.emplace_back(seed, static_cast<uint32_t>(i), b[i].GetParams(), Format::EVALUATION);
+            m_rKey.push_back(std::move(a));
+            m_rKey.push_back(std::move(b));
+        }
+        else {
+            OPENFHE_THROW(deserialize_error, "seeded A vectors are only supported for DCRTPoly");
+        }
     }
     std::string SerializedObjectName() const {
         return "EvalKeyRelin";
     }
+    // version 2 writes the seed of a seeded A vector instead of its values
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
+    }
+
+    /**
+   * Checks whether the recorded seed still describes the A vector, which is then regenerated from it as
+   * SetASeed() describes
+   *
+   * @return true if the A vector can be written as its seed
+   */
+    bool IsASeeded() const {
+        if (m_aSeed.size() != std::tuple_size<PRNGSeed>::value || m_rKey.size() != 2 ||
+            m_rKey[0].size() != m_rKey[1].size())
+            return false;
+        for (size_t i = 0; i < m_rKey[0].size(); ++i) {
+            const auto& a{m_rKey[0][i]};
+            if (a.GetFormat() != Format::EVALUATION || *a.GetParams() != *m_rKey[1][i].GetParams())
+                return false;
+        }
+        return true;
     }
 
 private:
@@ -283,6 +367,9 @@ private:
 
     // Used for hybrid key switching
     std::vector<DCRTPoly> m_dcrtKeys;
+
+    // seed the A vector was expanded from, empty if it was not
+    std::vector<PRNG::result_type> m_aSeed;
 };
 
 }  // namespace lbcrypto
@@ -0,0 +1,188 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  On-disk store of evaluation keys that are loaded on first use
+ */
+
+#ifndef LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+#define LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+
+#include "cryptocontext-fwd.h"
+#include "key/evalkeyrelin.h"
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace lbcrypto
+ * The namespace of lbcrypto
+ */
+namespace lbcrypto {
+
+/**
+ * @brief File-backed store of the relinearization and automorphism keys of a crypto context.
+ *
+ * Write() saves the keys into one file: the compact serialization of every key, followed by an index of
+ * the keys. Open() maps the file into memory and installs placeholder keys into the static key maps of
+ * the crypto context, so EvalMult, EvalRotate and EvalBootstrap find them as usual. A placeholder
+ * deserializes its key from the mapped file the first time the key is used, and at most maxResident keys
+ * stay deserialized at once: the least recently used one is released when the bound is exceeded. Processes
+ * that open the same file share its pages through the page cache; the deserialized keys are private to
+ * each process.
+ *
+ * The placeholder keys can be used from several threads. GetAVector() and GetBVector() throw unless the key
+ * is leased, and the returned reference stays valid while the caller holds the handle returned by Lease(), as
+ * key switching does. A
+ * key with a lease on it is never released and counts towards maxResident, so the bound is exceeded only
+ * while more than maxResident keys are leased at once; the excess keys are released when the next key is
+ * loaded after their leases are gone. The placeholder keys cannot be serialized; serialize the keys the
+ * store was written from instead.
+ */
+class EvalKeyStore : public std::enable_shared_from_this<EvalKeyStore> {
+public:
+    ~EvalKeyStore();
+
+    EvalKeyStore(const EvalKeyStore&)            = delete;
+    EvalKeyStore& operator=(const EvalKeyStore&) = delete;
+
+    /**
+   * Writes the relinearization and automorphism keys of a crypto context to a key store file
+   *
+   * @param filename file to write
+   * @param cc crypto context the keys were generated with
+   * @param keyTag tag of the keys to write; empty std::string means all keys of the context
+   */
+    static void Write(const std::string& filename, const CryptoContext<DCRTPoly>& cc, const std::string& keyTag = "");
+
+    /**
+   * Opens a key store file and installs its keys into the static key maps of the crypto context,
+   * replacing the keys stored there under the same tags
+   *
+   * @param filename file to open
+   * @param cc crypto context the keys were generated with
+   * @param maxResident maximum number of keys kept deserialized; 0 means no bound
+   * @return the store
+   */
+    static std::shared_ptr<EvalKeyStore> Open(const std::string& filename, const CryptoContext<DCRTPoly>& cc,
+                                              size_t maxResident = 0);
+
+    /**
+   * Deserializes the automorphism keys for the given automorphism indices ahead of their use. When the
+   * indices exceed the resident bound, the keys past the bound are only read ahead into the page cache.
+   *
+   * @param autoIndices automorphism indices in the order they will be used
+   * @param keyTag tag of the keys
+   */
+    void Preload(const std::vector<uint32_t>& autoIndices, const std::string& keyTag);
+
+    /**
+   * Preloads the automorphism keys EvalBootstrap uses. Requires EvalBootstrapSetup to have been called for
+   * the given number of slots.
+   *
+   * @param slots number of slots to be bootstrapped
+   * @param keyTag tag of the keys
+   */
+    void PreloadBootstrap(uint32_t slots, const std::string& keyTag);
+
+    /**
+   * @return the number of keys in the store
+   */
+    size_t GetKeyCount() const {
+        return m_entries.size();
+    }
+
+    /**
+   * @return the number of keys currently deserialized
+   */
+    size_t GetResidentCount() const {
+        return m_resident.load();
+    }
+
+    /**
+   * @return the maximum number of keys kept deserialized; 0 means no bound
+   */
+    size_t GetMaxResident() const {
+        return m_maxResident.load();
+    }
+
+    /**
+   * Sets the maximum number of keys kept deserialized and releases keys down to it
+   *
+   * @param maxResident the new bound; 0 means no bound
+   */
+    void SetMaxResident(size_t maxResident);
+
+private:
+    class StoredKey;
+    struct Entry;
+
+    EvalKeyStore(const std::string& filename, const CryptoContext<DCRTPoly>& cc, size_t maxResident);
+
+    // returns the deserialized key of the entry, which stays resident while the returned handle is held
+    std::shared_ptr<const std::vector<std::vector<DCRTPoly>>> Fetch(Entry& entry);
+
+    // returns the deserialized key of an entry that is leased; throws otherwise
+    const std::vector<std::vector<DCRTPoly>>& Leased(Entry& entry);
+
+    std::shared_ptr<const std::vector<std::vector<DCRTPoly>>> Materialize(Entry& entry);
+
+    // drops the least recently used keys other than keep that are not leased until the bound holds;
+    // called with m_mutex held, the dropped keys are returned to be freed after it is unlocked
+    std::vector<std::shared_ptr<const std::vector<std::vector<DCRTPoly>>>> Evict(const Entry* keep);
+
+    // copies bytes of the file
+    std::string ReadBytes(uint64_t offset, uint64_t size);
+
+    CryptoContext<DCRTPoly> m_cc;
+    std::vector<std::unique_ptr<Entry>> m_entries;
+
+    std::atomic<size_t> m_maxResident;
+    std::atomic<size_t> m_resident{0};
+    uint64_t m_tick{0};
+    // guards the keys of the entries, their use ticks and m_tick
+    std::mutex m_mutex;
+
+    // the mapped file, or the file stream where memory mapping is not available
+    const char* m_map{nullptr};
+    size_t m_mapSize{0};
+    std::ifstream m_file;
+    std::mutex m_fileMutex;
+};
+
+}  // namespace lbcrypto
+
+#endif
@@ -44,6 +44,7 @@
 #include "key/privatekey.h"
 #include "key/evalkey.h"
 #include "key/evalkeyrelin.h"
+#include "key/evalkeystore.h"
 
 #include "cryptoobject.h"
 
@@ -1,3 +1,10 @@
+#ifndef __RAW_CIPHERTEXT__
+#define __RAW_CIPHERTEXT__
+
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
 #include "openfhe.h"
 #include "gpu_functions.h"
 
@@ -14,30 +21,20 @@ struct RawCipherText {
   uint64_t* sub_1; // pointer to sub-ciphertext 1
   uint64_t* sub_2; // pointer to sub-ciphertext 1
   uint64_t* moduli; // moduli for each limb
+  uint64_t* host_0=nullptr; // storage of sub-ciphertext 0 inside originalCipherText when sub_0 is a view of it
+  uint64_t* host_1=nullptr; // storage of sub-ciphertext 1 inside originalCipherText when sub_1 is a view of it
+  uint64_t* host_2=nullptr; // storage of d2 inside originalCipherText after MoveToHost of a tensor product
+  bool has_2=false; // sub_2 holds d2 of a tensor product (EvalMultGPUNoRelin) that was not relinearized yet
   int numRes; // number of residues of ciphertext, length of moduli array and first dimension of sub-ciphertexts
   int N; // length of each polynomial
   Format format; // current format of ciphertext, either coefficient or evaluation
+  GpuFuture ready; // completes when all enqueued work touching this ciphertext has finished
 };
 
-/**
-* parameter structure for doing the NTT on the GPU in RNS format
-*/
-struct NTT_params {
-    int N;
-    int L;
-    int qbit;
-    int logN;
-    uint64_t* moduli;
-    uint64_t* mus;
-    uint64_t* psi_arrays;
-    uint64_t* inv_psi_arrays;
-};
-
-
 /**
 * Converts a vector of polynomial limbs to a single flattened array 
 */
-uint64_t* GetRawArray(std::vector<lbcrypto::PolyImpl<lbcrypto::NativeVector>> polys) {
+uint64_t* GetRawArray(const std::vector<lbcrypto::PolyImpl<lbcrypto::NativeVector>>& polys) {
     // total size is r * N
     int numRes=polys.size();
     int numElements=(*polys[0].m_values).GetLength();
@@ -57,7 +54,7 @@ uint64_t* GetRawArray(std::vector<lbcrypto::PolyImpl<lbcrypto::NativeVector>> po
 /**
 * Gets the moduli from a vector of polynomial limbs and returns a single array
 */
-uint64_t* GetModuli(std::vector<lbcrypto::PolyImpl<lbcrypto::NativeVector>> polys) {
+uint64_t* GetModuli(const std::vector<lbcrypto::PolyImpl<lbcrypto::NativeVector>>& polys) {
     int numRes=polys.size();
     uint64_t* moduli=new uint64_t[numRes];
     for (int r=0;r < numRes;r++) {
@@ -68,38 +65,74 @@ uint64_t* GetModuli(std::vector<lbcrypto::PolyImpl<lbcrypto::NativeVector>> poly
 
 /**
 * Converts a ciphertext from openFHE into the RawCiphertext format
+* Nothing is copied: the elements of ct are put in limb-major slabs (free if they already are)
+* and sub_0/sub_1 point into them, so MoveToHost writes the results straight back into ct.
+* ct must not be modified on the CPU while the RawCipherText is in use.
 */
 RawCipherText GetRawCipherText(CryptoContext<DCRTPoly> cc, Ciphertext<DCRTPoly> ct) {
+    auto& elements=ct->GetElements();
+    elements[0].MakeContiguous();
+    elements[1].MakeContiguous();
+    DCRTRawView view_0=elements[0].GetRawView();
+    DCRTRawView view_1=elements[1].GetRawView();
+
     RawCipherText result;
     result.cc=cc;
     result.originalCipherText=ct;
-    result.numRes=ct->GetElements()[0].GetAllElements().size();
-    result.N=(*(ct->GetElements()[0].GetAllElements())[0].m_values).GetLength();
-    result.sub_0 = GetRawArray(ct->GetElements()[0].GetAllElements());
-    result.sub_1 = GetRawArray(ct->GetElements()[1].GetAllElements());
-    result.moduli = GetModuli(ct->GetElements()[0].GetAllElements());
-    result.format= ct->GetElements()[0].GetFormat();
+    result.numRes=view_0.numTowers;
+    result.N=view_0.ringDim;
+    result.sub_0=view_0.data;
+    result.sub_1=view_1.data;
+    result.sub_2=nullptr;
+    result.host_0=view_0.data;
+    result.host_1=view_1.data;
+    result.moduli=new uint64_t[result.numRes];
+    std::memcpy(result.moduli, view_0.moduli.data(), result.numRes*sizeof(uint64_t));
+    result.format=elements[0].GetFormat();
 
     return result;
 };
 
+/**
+* Sets the format of a DCRTPoly and all its towers without transforming the data
+*/
+void OverrideFormat(DCRTPoly& poly, Format format) {
+    poly.OverrideFormat(format);
+    for (auto& tower : poly.GetAllElements())
+        tower.OverrideFormat(format);
+};
+
 /**
 * Converts a ciphertext from the RawCiphertext format back to the OpenFHE ciphertext format*/
 Ciphertext<DCRTPoly> GetOpenFHECipherText(RawCipherText ct) {
     auto result = ct.originalCipherText;
+    // MoveToHost already wrote into the ciphertext
+    if (ct.host_0 != nullptr && ct.host_1 != nullptr)
+        return result;
     auto sub_0=result->GetElements()[0];
     auto sub_1=result->GetElements()[1];
+    auto sub_2=sub_0.CloneEmpty();
     auto dcrt_0=sub_0.GetAllElements();
     auto dcrt_1=sub_1.GetAllElements();
+    auto dcrt_2=dcrt_0;
     for (int r=0;r<ct.numRes;r++) {
+        dcrt_0[r].DropFormatCache();
+        dcrt_1[r].DropFormatCache();
+        dcrt_2[r].DropFormatCache();
         for (int i=0; i<ct.N; i++) {
             (*dcrt_0[r].m_values)[i].SetValue(ct.sub_0[r*ct.N + i]);
             (*dcrt_1[r].m_values)[i].SetValue(ct.sub_1[r*ct.N + i]);
+            if (ct.has_2)
+                (*dcrt_2[r].m_values)[i].SetValue(ct.sub_2[r*ct.N + i]);
         }
     }
     sub_0.m_vectors=dcrt_0;
     sub_1.m_vectors=dcrt_1;
     std::vector<lbcrypto::DCRTPoly> ct_new= { sub_0, sub_1};
+    if (ct.has_2) {
+        sub_2.m_vectors=dcrt_2;
+        ct_new.push_back(sub_2);
+    }
     result->SetElements(ct_new);
 
     return result;
@@ -107,93 +140,443 @@ Ciphertext<DCRTPoly> GetOpenFHECipherText(RawCipherText ct) {
 
 /** 
 * Moves a ciphertext to the GPU for computations
+* Device blocks come from gpuMemoryPool() and the host arrays are freed. sub_2 is only uploaded
+* when it holds d2 of a tensor product (has_2), e.g. after a MoveToHost of one; otherwise it stays
+* empty until EvalMultGPUNoRelin needs it. The copies run on the upload stream of ctx
+* and the returned future (also stored in ct->ready) completes when they have landed.
 */
-void MoveToGPU(RawCipherText* ct) {
-    int numElems=ct->N * ct->numRes;
-    ct->sub_0=moveArrayToGPU(ct->sub_0, numElems);
-    ct->sub_1=moveArrayToGPU(ct->sub_1, numElems);
-    ct->sub_2=moveArrayToGPU(ct->sub_1, numElems);
-    ct->moduli=moveArrayToGPU(ct->moduli, ct->numRes);
+GpuFuture MoveToGPU(RawCipherText* ct, ExecContext& ctx = ExecContext::Default()) {
+    auto& pool = gpuMemoryPool();
+    size_t numElems=ct->N * ct->numRes;
+    hipStream_t stream=ctx.UploadStream();
+    std::vector<std::pair<uint64_t*, size_t>> staging;
+
+    auto upload=[&](uint64_t* host, size_t n, bool owned) {
+        uint64_t* pinned=pool.AcquireStaging(n);
+        std::memcpy(pinned, host, n*sizeof(uint64_t));
+        if (owned)
+            delete[] host;
+        staging.push_back({pinned, n});
+        uint64_t* dev=pool.Acquire(n);
+        copyToGPUAsync(dev, pinned, n, stream);
+        return dev;
+    };
+    ct->sub_0=upload(ct->sub_0, numElems, ct->sub_0 != ct->host_0);
+    ct->sub_1=upload(ct->sub_1, numElems, ct->sub_1 != ct->host_1);
+    ct->sub_2=ct->has_2 ? upload(ct->sub_2, numElems, ct->sub_2 != ct->host_2) : nullptr;
+    ct->moduli=upload(ct->moduli, ct->numRes, true);
+
+    ct->ready=ctx.Record(stream);
+    // staging buffers go back to the pool once the copies are done
+    ctx.Defer(ct->ready, [staging, &pool]() {
+        for (auto& s : staging)
+            pool.ReleaseStaging(s.first, s.second);
+    });
+    return ct->ready;
 };
 
 /**
 * Moves a ciphertext back to main CPU memory
+* Waits for the work pending on ct, then returns the device blocks to gpuMemoryPool() for the
+* next ciphertext of the same shape. If sub_0/sub_1 are views (GetRawCipherText) the results
+* land directly in originalCipherText, which takes on ct->format. If ct holds the d2 of a tensor
+* product (has_2), it is downloaded as well and becomes the third element of originalCipherText,
+* as after CryptoContext::EvalMultNoRelin; otherwise sub_2 is released without a copy.
 */
-void MoveToHost(RawCipherText* ct) {
-    int numElems=ct->N * ct->numRes;
-    ct->sub_0=moveArrayToHost(ct->sub_0, numElems);
-    ct->sub_1=moveArrayToHost(ct->sub_1, numElems);
-    ct->sub_2=moveArrayToHost(ct->sub_2, numElems);
-    ct->moduli=moveArrayToHost(ct->moduli, ct->numRes);
+void MoveToHost(RawCipherText* ct, ExecContext& ctx = ExecContext::Default()) {
+    auto& pool = gpuMemoryPool();
+    size_t numElems=ct->N * ct->numRes;
+    hipStream_t stream=ctx.DownloadStream();
+    ctx.DependsOn(stream, ct->ready);
+
+    uint64_t* pinned_0=pool.AcquireStaging(numElems);
+    uint64_t* pinned_1=pool.AcquireStaging(numElems);
+    uint64_t* pinned_2=ct->has_2 ? pool.AcquireStaging(numElems) : nullptr;
+    uint64_t* pinned_moduli=pool.AcquireStaging(ct->numRes);
+    copyToHostAsync(pinned_0, ct->sub_0, numElems, stream);
+    copyToHostAsync(pinned_1, ct->sub_1, numElems, stream);
+    if (ct->has_2)
+        copyToHostAsync(pinned_2, ct->sub_2, numElems, stream);
+    copyToHostAsync(pinned_moduli, ct->moduli, ct->numRes, stream);
+    ctx.Record(stream).Wait();
+
+    uint64_t* host_0=ct->host_0 ? ct->host_0 : new uint64_t[numElems];
+    uint64_t* host_1=ct->host_1 ? ct->host_1 : new uint64_t[numElems];
+    uint64_t* host_moduli=new uint64_t[ct->numRes];
+    std::memcpy(host_0, pinned_0, numElems*sizeof(uint64_t));
+    std::memcpy(host_1, pinned_1, numElems*sizeof(uint64_t));
+    std::memcpy(host_moduli, pinned_moduli, ct->numRes*sizeof(uint64_t));
+    pool.ReleaseStaging(pinned_0, numElems);
+    pool.ReleaseStaging(pinned_1, numElems);
+    pool.ReleaseStaging(pinned_moduli, ct->numRes);
+
+    pool.Release(ct->sub_0, numElems);
+    pool.Release(ct->sub_1, numElems);
+    pool.Release(ct->sub_2, numElems);
+    pool.Release(ct->moduli, ct->numRes);
+    ct->sub_0=host_0;
+    ct->sub_1=host_1;
+    ct->sub_2=nullptr;
+    ct->moduli=host_moduli;
+    ct->ready=GpuFuture();
+    ct->host_2=nullptr;
+    if (ct->host_0 && ct->host_1) {
+        auto& elements=ct->originalCipherText->GetElements();
+        OverrideFormat(elements[0], ct->format);
+        OverrideFormat(elements[1], ct->format);
+        // drops the d2 of an earlier download, which a relinearization on the GPU has folded in
+        elements.resize(2);
+        if (ct->has_2) {
+            elements.emplace_back(elements[0].GetParams(), ct->format, true);
+            // growing the vector may have copied the first two slabs, refresh the views
+            for (auto& element : elements)
+                element.MakeContiguous();
+            ct->sub_0=ct->host_0=elements[0].GetRawView().data;
+            ct->sub_1=ct->host_1=elements[1].GetRawView().data;
+            ct->sub_2=ct->host_2=elements[2].GetRawView().data;
+            std::memcpy(ct->host_2, pinned_2, numElems*sizeof(uint64_t));
+        }
+    }
+    else if (ct->has_2) {
+        ct->sub_2=new uint64_t[numElems];
+        std::memcpy(ct->sub_2, pinned_2, numElems*sizeof(uint64_t));
+    }
+    if (ct->has_2)
+        pool.ReleaseStaging(pinned_2, numElems);
 };
 
+/**
+* Picks a compute stream for an operation on ct1 and ct2 and makes it wait for both.
+* Operations on unrelated ciphertexts land on different streams and overlap.
+*/
+hipStream_t BeginGPUOp(RawCipherText* ct1, RawCipherText* ct2, ExecContext& ctx) {
+    hipStream_t stream=ctx.AcquireStream();
+    ctx.DependsOn(stream, ct1->ready);
+    if (ct2 != ct1)
+        ctx.DependsOn(stream, ct2->ready);
+    return stream;
+}
+
+/**
+* Publishes the completion of an operation to both operands. Inputs are tracked as well as
+* outputs so that a later write cannot overtake a pending read.
+*/
+GpuFuture EndGPUOp(RawCipherText* ct1, RawCipherText* ct2, hipStream_t stream, ExecContext& ctx) {
+    ct1->ready=ctx.Record(stream);
+    ct2->ready=ct1->ready;
+    return ct1->ready;
+}
+
 /**
 * Evaluates homomorphic addition on the GPU
 */
-void EvalAddGPU(RawCipherText* ct1, RawCipherText* ct2) {
-    gpuAdd(ct1->sub_0, ct2->sub_0, ct1->sub_0, ct1->N, ct1->numRes, ct1->moduli);
-    gpuAdd(ct1->sub_1, ct2->sub_1, ct1->sub_1, ct1->N, ct1->numRes, ct1->moduli);
-    //hipSync();
+GpuFuture EvalAddGPU(RawCipherText* ct1, RawCipherText* ct2, ExecContext& ctx = ExecContext::Default()) {
+    hipStream_t stream=BeginGPUOp(ct1, ct2, ctx);
+    gpuAdd(ct1->sub_0, ct2->sub_0, ct1->sub_0, ct1->N, ct1->numRes, ct1->moduli, stream);
+    gpuAdd(ct1->sub_1, ct2->sub_1, ct1->sub_1, ct1->N, ct1->numRes, ct1->moduli, stream);
+    return EndGPUOp(ct1, ct2, stream, ctx);
 };
 
 
-void EvalMultGPUNoRelin(RawCipherText* ct1, RawCipherText* ct2) {
+/**
+* Device copy of the NTT tables of one RNS limb
+*/
+struct GPUTwiddleTable {
+    uint64_t* psi; // bit-reversed powers of the root of unity, N words
+    uint64_t* psi_precon; // Shoup precomputations of psi
+    uint64_t* inv_psi; // bit-reversed powers of the inverse root of unity
+    uint64_t* inv_psi_precon;
+    uint64_t modulus;
+    uint64_t mu; // Barrett constant for the GPU butterflies
+    int qbit; // bit length of modulus
+};
 
-    gpuMult(ct1->sub_0, ct2->sub_1, ct1->sub_2, ct1->N, ct1->numRes, ct1->moduli);
-    gpuMult(ct1->sub_1, ct2->sub_0, ct2->sub_2, ct1->N, ct1->numRes, ct1->moduli);
+/**
+* Process-wide cache of device twiddle tables keyed by (modulus, ring dimension, root).
+*
+* The tables are copied from the ones ChineseRemainderTransformFTT precomputes for
+* DCRTPoly::SwitchFormat(), so GPU_NTT/GPU_INTT use the same root of unity as the CPU and produce
+* bit-identical results. Each limb is uploaded once per process, and the contiguous NTT_params
+* of a moduli chain are assembled on the device once per chain.
+*/
+class GPUTwiddleCache {
+public:
+    static GPUTwiddleCache& Instance() {
+        // intentionally leaked, see gpuMemoryPool()
+        static GPUTwiddleCache* cache = new GPUTwiddleCache();
+        return *cache;
+    }
 
-    gpuMult(ct1->sub_0, ct2->sub_0, ct1->sub_0, ct1->N, ct1->numRes, ct1->moduli);
-    gpuMult(ct1->sub_1, ct2->sub_1, ct1->sub_2, ct1->N, ct1->numRes, ct1->moduli);
+    const GPUTwiddleTable& GetTable(const NativeInteger& modulus, usint ringDim, const NativeInteger& root) {
+        std::lock_guard<std::mutex> lock(mtx);
+        return GetTableLocked(modulus, ringDim, root);
+    }
 
-    gpuAdd(ct1->sub_2,ct2->sub_2, ct1->sub_1,ct1->N,ct1->numRes,ct1->moduli);
-    // hipSync();
-}
+    /**
+    * NTT_params for every tower of params, in tower order. The returned pointers are owned by the
+    * cache and stay valid until Clear().
+    */
+    NTT_params GetNTTParams(const std::shared_ptr<DCRTPoly::Params>& params) {
+        std::lock_guard<std::mutex> lock(mtx);
+        usint ringDim=params->GetRingDimension();
+        std::vector<uint64_t> chainKey={ringDim};
+        for (const auto& p : params->GetParams()) {
+            chainKey.push_back(p->GetModulus().ConvertToInt());
+            chainKey.push_back(p->GetRootOfUnity().ConvertToInt());
+        }
+        auto it=chains.find(chainKey);
+        if (it!=chains.end())
+            return it->second;
+
+        NTT_params result;
+        result.N=ringDim;
+        result.L=params->GetParams().size();
+        result.logN=GetMSB(ringDim)-1;
+        result.qbit=0;
+
+        auto& pool=gpuMemoryPool();
+        size_t tableSize=(size_t)result.N*result.L;
+        result.psi_arrays=pool.Acquire(tableSize);
+        result.psi_precon_arrays=pool.Acquire(tableSize);
+        result.inv_psi_arrays=pool.Acquire(tableSize);
+        result.inv_psi_precon_arrays=pool.Acquire(tableSize);
+
+        std::vector<uint64_t> moduli(result.L), mus(result.L);
+        // padded to whole words for the upload
+        std::vector<uint64_t> qbits((result.L+1)/2, 0);
+        hipStream_t stream=ExecContext::Default().UploadStream();
+        for (int i=0; i<result.L; i++) {
+            const auto& p=params->GetParams()[i];
+            const GPUTwiddleTable& t=GetTableLocked(p->GetModulus(), ringDim, p->GetRootOfUnity());
+            size_t offset=(size_t)i*result.N;
+            copyOnGPUAsync(result.psi_arrays+offset, t.psi, result.N, stream);
+            copyOnGPUAsync(result.psi_precon_arrays+offset, t.psi_precon, result.N, stream);
+            copyOnGPUAsync(result.inv_psi_arrays+offset, t.inv_psi, result.N, stream);
+            copyOnGPUAsync(result.inv_psi_precon_arrays+offset, t.inv_psi_precon, result.N, stream);
+            moduli[i]=t.modulus;
+            mus[i]=t.mu;
+            ((int*)qbits.data())[i]=t.qbit;
+        }
+        result.moduli=pool.Upload(moduli.data(), result.L);
+        result.mus=pool.Upload(mus.data(), result.L);
+        result.qbits=(int*)pool.Upload(qbits.data(), qbits.size());
+        ExecContext::Default().Record(stream).Wait();
+        pool.Synchronize();
+
+        chains[chainKey]=result;
+        return result;
+    }
 
-NTT_params get_NTT_params(RawCipherText* ct1, int logN, int qbit) {
-    NTT_params params;
-    params.N=ct1->N;
-    params.L=ct1->numRes;
-    params.qbit = qbit;
-    params.logN = logN;
-    params.moduli=moveArrayToGPU(ct1->moduli, params.L);
-
-    params.mus= (uint64_t*)malloc(sizeof(uint64_t)*params.L);
-    params.psi_arrays = (uint64_t*)malloc(sizeof(uint64_t) * params.N * params.L);
-    params.inv_psi_arrays = (uint64_t*)malloc(sizeof(uint64_t) * params.N * params.L);
-
-    uint64_t psi;
-    for (int i=0; i<params.L; i++) {
-        params.mus[i]=((__uint128_t)1<<(2*params.qbit)+1) / ct1->moduli[i];
-        psi = gen_primitive_root(2*params.N, ct1->moduli[i]);
-        generate_psi_array(params.psi_arrays+ i * params.N, psi, ct1->moduli[i], logN);
-        generate_invpsi_array(params.inv_psi_arrays + i * params.N, psi, ct1->moduli[i], logN);
+    // releases every cached table back to gpuMemoryPool()
+    void Clear() {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto& pool=gpuMemoryPool();
+        for (auto& kv : chains) {
+            const NTT_params& p=kv.second;
+            size_t tableSize=(size_t)p.N*p.L;
+            pool.Release(p.psi_arrays, tableSize);
+            pool.Release(p.psi_precon_arrays, tableSize);
+            pool.Release(p.inv_psi_arrays, tableSize);
+            pool.Release(p.inv_psi_precon_arrays, tableSize);
+            pool.Release(p.moduli, p.L);
+            pool.Release(p.mus, p.L);
+            pool.Release((uint64_t*)p.qbits, (p.L+1)/2);
+        }
+        for (auto& kv : tables) {
+            size_t n=std::get<1>(kv.first);
+            pool.Release(kv.second.psi, n);
+            pool.Release(kv.second.psi_precon, n);
+            pool.Release(kv.second.inv_psi, n);
+            pool.Release(kv.second.inv_psi_precon, n);
+        }
+        chains.clear();
+        tables.clear();
     }
-    
-    params.mus= moveArrayToGPU(params.mus, params.L);
-    params.psi_arrays = moveArrayToGPU(params.psi_arrays, params.N * params.L);
-    params.inv_psi_arrays = moveArrayToGPU(params.inv_psi_arrays, params.N * params.L);
 
+private:
+    using Key=std::tuple<uint64_t, usint, uint64_t>;
+
+    const GPUTwiddleTable& GetTableLocked(const NativeInteger& modulus, usint ringDim, const NativeInteger& root) {
+        Key key{modulus.ConvertToInt(), ringDim, root.ConvertToInt()};
+        auto it=tables.find(key);
+        if (it!=tables.end())
+            return it->second;
+
+        // the tables SwitchFormat() uses, registered here if no transform ran yet
+        using FTT=ChineseRemainderTransformFTT<NativeVector>;
+        const auto& ntt=FTT::GetTables(FTT::RegisterTables(root, 2*ringDim, modulus));
+        static_assert(sizeof(NativeInteger)==sizeof(uint64_t), "NativeVector must be a plain array of words");
+        auto words=[](const NativeVector& v) { return reinterpret_cast<const uint64_t*>(&v[0]); };
+        auto& pool=gpuMemoryPool();
+        GPUTwiddleTable t;
+        t.psi=pool.Upload(words(ntt.rootOfUnityReverse), ringDim);
+        t.psi_precon=pool.Upload(words(ntt.rootOfUnityPreconReverse), ringDim);
+        t.inv_psi=pool.Upload(words(ntt.rootOfUnityInverseReverse), ringDim);
+        t.inv_psi_precon=pool.Upload(words(ntt.rootOfUnityInversePreconReverse), ringDim);
+        pool.Synchronize();
+        t.modulus=modulus.ConvertToInt();
+        t.qbit=modulus.GetMSB();
+        t.mu=((__uint128_t)1<<(2*t.qbit+1)) / t.modulus;
+        return tables.emplace(key, t).first->second;
+    }
+
+    std::mutex mtx;
+    std::map<Key, GPUTwiddleTable> tables;
+    std::map<std::vector<uint64_t>, NTT_params> chains;
+};
+
+/**
+* Device tables for GPU_NTT/GPU_INTT of ct1, served by GPUTwiddleCache. The moduli and roots are
+* read from the OpenFHE parameters, so this works whether or not ct1 has already been moved to
+* the GPU. logN and qbit are only checked/kept for reference.
+*/
+NTT_params get_NTT_params(RawCipherText* ct1, int logN, int qbit) {
+    NTT_params params=GPUTwiddleCache::Instance().GetNTTParams(ct1->originalCipherText->GetElements()[0].GetParams());
+    if (params.logN!=logN)
+        std::cout << "get_NTT_params: ring dimension is 2^" << params.logN << ", not 2^" << logN << std::endl;
+    params.qbit=qbit;
     return params;
 }
 
-void GPU_NTT(RawCipherText* ct1, NTT_params params) {
+/**
+* (i)NTT of a batch of ciphertexts sharing params: both sub-ciphertexts, all limbs, in one
+* pair of kernel launches per NTT_MAX_BATCH polynomials
+*/
+GpuFuture GPU_NTT_Batch(const std::vector<RawCipherText*>& cts, NTT_params params, bool inverse, ExecContext& ctx = ExecContext::Default()) {
+    Format target = inverse ? COEFFICIENT : EVALUATION;
+    hipStream_t stream=ctx.AcquireStream();
+    std::vector<uint64_t*> polys;
+    std::vector<RawCipherText*> touched;
+    for (auto ct : cts) {
+        if (ct->format==target)
+            continue;
+        ctx.DependsOn(stream, ct->ready);
+        polys.push_back(ct->sub_0);
+        polys.push_back(ct->sub_1);
+        touched.push_back(ct);
+    }
+    if (inverse)
+        gpuINTT(polys.data(), polys.size(), params, stream);
+    else
+        gpuNTT(polys.data(), polys.size(), params, stream);
+
+    GpuFuture done=ctx.Record(stream);
+    for (auto ct : touched) {
+        ct->format=target;
+        ct->ready=done;
+    }
+    return done;
+}
+
+GpuFuture GPU_NTT(RawCipherText* ct1, NTT_params params, ExecContext& ctx = ExecContext::Default()) {
     if (ct1->format==EVALUATION) {
         std::cout << "Already in Evaluation Format" << std::endl;
-        return;
+        return ct1->ready;
     }
-    gpuNTT(ct1->sub_0, params.psi_arrays, params.logN, params.N, params.L, params.moduli, params.mus, params.qbit);
-    gpuNTT(ct1->sub_1, params.psi_arrays, params.logN, params.N, params.L, params.moduli, params.mus, params.qbit);
-    ct1->format = EVALUATION;
+    return GPU_NTT_Batch({ct1}, params, false, ctx);
 }
 
-void GPU_INTT(RawCipherText* ct1, NTT_params params) {
+GpuFuture GPU_INTT(RawCipherText* ct1, NTT_params params, ExecContext& ctx = ExecContext::Default()) {
     if (ct1->format==COEFFICIENT) {
         std::cout << "Already in Coefficient Format" << std::endl;
-        return;
+        return ct1->ready;
+    }
+    return GPU_NTT_Batch({ct1}, params, true, ctx);
+}
+
+/**
+* Allocates a ciphertext of the shape of ct on the GPU to receive results; nothing is uploaded.
+* Its OpenFHE ciphertext has the metadata of ct's and zero elements that MoveToHost fills in.
+*/
+RawCipherText AllocateGPUCipherText(const RawCipherText* ct, ExecContext& ctx = ExecContext::Default()) {
+    auto& pool = gpuMemoryPool();
+    size_t numElems=ct->N * ct->numRes;
+    auto original=ct->originalCipherText;
+    auto params=original->GetElements()[0].GetParams();
+    Ciphertext<DCRTPoly> fresh=original->CloneZero();
+    fresh->SetElements({DCRTPoly(params, ct->format, true), DCRTPoly(params, ct->format, true)});
+
+    RawCipherText result;
+    result.cc=ct->cc;
+    result.originalCipherText=fresh;
+    result.numRes=ct->numRes;
+    result.N=ct->N;
+    result.format=ct->format;
+    auto& elements=fresh->GetElements();
+    elements[0].MakeContiguous();
+    elements[1].MakeContiguous();
+    result.host_0=elements[0].GetRawView().data;
+    result.host_1=elements[1].GetRawView().data;
+
+    hipStream_t stream=ctx.AcquireStream();
+    ctx.DependsOn(stream, ct->ready);
+    result.sub_0=pool.Acquire(numElems);
+    result.sub_1=pool.Acquire(numElems);
+    result.sub_2=nullptr;
+    result.moduli=pool.Acquire(ct->numRes);
+    copyOnGPUAsync(result.moduli, ct->moduli, ct->numRes, stream);
+    result.ready=ctx.Record(stream);
+    return result;
+}
+
+/**
+* Tensor products of a batch of ciphertext pairs on the GPU, without relinearization and rescaling:
+* results[i] gets (d0, d1, d2) = (a0*b0, a0*b1 + a1*b0, a1*b1) of ct1s[i] and ct2s[i] in sub_0,
+* sub_1 and sub_2. Every input limb is read once by a single fused kernel, one launch per
+* TENSOR_MAX_BATCH pairs. The pairs must be in evaluation format and at the same level; results
+* are on the GPU already (MoveToGPU, AllocateGPUCipherText), results[i] may be ct1s[i] or ct2s[i].
+* ct2s are not modified unless they are results.
+*/
+GpuFuture EvalMultGPUNoRelinBatch(const std::vector<RawCipherText*>& ct1s, const std::vector<RawCipherText*>& ct2s,
+                                  const std::vector<RawCipherText*>& results, ExecContext& ctx = ExecContext::Default()) {
+    if (ct1s.size()!=ct2s.size() || ct1s.size()!=results.size())
+        OPENFHE_THROW(config_error, "EvalMultGPUNoRelinBatch: operand and result counts differ");
+    if (ct1s.empty())
+        return GpuFuture();
+    int numRes=ct1s[0]->numRes;
+    hipStream_t stream=ctx.AcquireStream();
+    std::vector<const uint64_t*> in;
+    std::vector<uint64_t*> out;
+    for (size_t i=0; i<ct1s.size(); i++) {
+        if (ct1s[i]->numRes!=numRes || ct2s[i]->numRes!=numRes || results[i]->numRes!=numRes)
+            OPENFHE_THROW(config_error, "EvalMultGPUNoRelinBatch: all ciphertexts must be at the same level");
+        ctx.DependsOn(stream, ct1s[i]->ready);
+        ctx.DependsOn(stream, ct2s[i]->ready);
+        ctx.DependsOn(stream, results[i]->ready);
+        // d2 gets its block on first use, the pool blocks are stream-ordered
+        if (results[i]->sub_2==nullptr)
+            results[i]->sub_2=gpuMemoryPool().Acquire((size_t)results[i]->N*numRes);
+        in.insert(in.end(), {ct1s[i]->sub_0, ct1s[i]->sub_1, ct2s[i]->sub_0, ct2s[i]->sub_1});
+        out.insert(out.end(), {results[i]->sub_0, results[i]->sub_1, results[i]->sub_2});
+    }
+    // the Barrett constants of the NTT tables of the chain
+    NTT_params params=GPUTwiddleCache::Instance().GetNTTParams(ct1s[0]->originalCipherText->GetElements()[0].GetParams());
+    gpuTensorProduct(in.data(), out.data(), ct1s.size(), ct1s[0]->N, numRes, params.moduli, params.mus,
+                     params.qbits, stream);
+
+    GpuFuture done=ctx.Record(stream);
+    for (size_t i=0; i<ct1s.size(); i++) {
+        results[i]->format=ct1s[i]->format;
+        results[i]->has_2=true;
+        ct1s[i]->ready=done;
+        ct2s[i]->ready=done;
+        results[i]->ready=done;
     }
-    gpuINTT(ct1->sub_0, params.inv_psi_arrays, params.logN, params.N, params.L, params.moduli, params.mus, params.qbit);
-    gpuINTT(ct1->sub_1, params.inv_psi_arrays, params.logN, params.N, params.L, params.moduli, params.mus, params.qbit);
-    ct1->format = COEFFICIENT;
+    return done;
+}
+
+/**
+* Tensor product of ct1 and ct2 into result, see EvalMultGPUNoRelinBatch
+*/
+GpuFuture EvalMultGPUNoRelin(RawCipherText* ct1, RawCipherText* ct2, RawCipherText* result, ExecContext& ctx = ExecContext::Default()) {
+    return EvalMultGPUNoRelinBatch({ct1}, {ct2}, {result}, ctx);
+}
+
+/**
+* Tensor product of ct1 and ct2 in place: the result replaces ct1, with d2 in ct1->sub_2
+*/
+GpuFuture EvalMultGPUNoRelin(RawCipherText* ct1, RawCipherText* ct2, ExecContext& ctx = ExecContext::Default()) {
+    return EvalMultGPUNoRelinBatch({ct1}, {ct2}, {ct1}, ctx);
 }
 /**
 * Evaluates homomorphic multiplication on the GPU
@@ -371,4 +754,4 @@ void GPU_INTT(RawCipherText* ct1, NTT_params params) {
 //     }
 // }
 
-
+#endif
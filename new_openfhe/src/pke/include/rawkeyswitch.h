@@ -0,0 +1,539 @@
+#ifndef __RAW_KEY_SWITCH__
+#define __RAW_KEY_SWITCH__
+
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "rawciphertext.h"
+
+/*
+* Hybrid key switching (KeySwitchHYBRID) on raw limb-major arrays.
+*
+* The three steps of KeySwitchHYBRID::KeySwitchCore are reproduced on N x limbs arrays:
+*   EvalKeySwitchPrecomputeCore : digit decomposition, INTT + ApproxSwitchCRTBasis + NTT per digit
+*   EvalFastKeySwitchCoreExt    : inner product of the digits with the eval key over QlP
+*   ApproxModDown               : back from QlP to Ql, folded into the addition to c0/c1
+* RawKeySwitch is written against a backend so the same code runs on the GPU (GPUKeySwitchBackend)
+* and on the CPU (CPUKeySwitchBackend, a plain reference used to test the former). All tables come
+* from the CryptoParametersRNS of the context, so both produce the same words as OpenFHE.
+*/
+
+/**
+* Eval key of RawKeySwitch in backend memory: numDigits x sizeQP limbs of N words for each half
+*/
+struct RawEvalKey {
+    uint64_t* a=nullptr;
+    uint64_t* b=nullptr;
+    int numDigits=0;
+    int sizeQP=0;
+    int N=0;
+};
+
+/**
+* Words of a vector of native integers
+*/
+std::vector<uint64_t> GetWords(const std::vector<NativeInteger>& v) {
+    std::vector<uint64_t> words(v.size());
+    for (size_t i=0; i<v.size(); i++)
+        words[i]=v[i].ConvertToInt();
+    return words;
+}
+
+/**
+* Appends floor(2^128 / q) as two words, low word first, the format of SwitchBasis_params::outMu
+*/
+void AppendBarrettMu128(std::vector<uint64_t>& mus, uint64_t q) {
+    __uint128_t mu=~(__uint128_t)0 / q;
+    mus.push_back((uint64_t)mu);
+    mus.push_back((uint64_t)(mu >> 64));
+}
+
+/**
+* Params of towers [start, start+size) of params
+*/
+std::shared_ptr<DCRTPoly::Params> GetSubParams(const std::shared_ptr<DCRTPoly::Params>& params, size_t start, size_t size) {
+    std::vector<NativeInteger> moduli(size);
+    std::vector<NativeInteger> roots(size);
+    for (size_t i=0; i<size; i++) {
+        moduli[i]=params->GetParams()[start+i]->GetModulus();
+        roots[i]=params->GetParams()[start+i]->GetRootOfUnity();
+    }
+    return std::make_shared<DCRTPoly::Params>(params->GetCyclotomicOrder(), moduli, roots);
+}
+
+/**
+* Reference backend: host arrays, one tower at a time through OpenFHE's own NTT, and modular
+* arithmetic done the slow obvious way. Meant for checking GPUKeySwitchBackend, not for speed.
+*/
+class CPUKeySwitchBackend {
+public:
+    struct Stream {};
+    using Chain=std::shared_ptr<DCRTPoly::Params>;
+
+    Chain GetChain(const std::shared_ptr<DCRTPoly::Params>& params) { return params; }
+
+    uint64_t* Upload(const uint64_t* src, size_t n) {
+        uint64_t* dst=new uint64_t[n];
+        std::memcpy(dst, src, n*sizeof(uint64_t));
+        return dst;
+    }
+    void FreeTable(uint64_t* p, size_t n) { delete[] p; }
+
+    uint64_t* Acquire(size_t n) { return new uint64_t[n]; }
+    void Release(const std::vector<std::pair<uint64_t*, size_t>>& blocks, Stream s) {
+        for (auto& b : blocks)
+            delete[] b.first;
+    }
+
+    void Copy(uint64_t* dst, const uint64_t* src, size_t n, Stream s) {
+        std::memcpy(dst, src, n*sizeof(uint64_t));
+    }
+
+    void NTT(uint64_t* poly, const Chain& chain, Stream s) { Transform(poly, chain, false); }
+    void INTT(uint64_t* poly, const Chain& chain, Stream s) { Transform(poly, chain, true); }
+
+    void SwitchBasis(const uint64_t* in, uint64_t* out, int N, const SwitchBasis_params& t, Stream s) {
+        for (int j=0; j<t.sizeOut; j++) {
+            for (int ri=0; ri<N; ri++) {
+                __uint128_t sum=0;
+                for (int i=0; i<t.sizeIn; i++) {
+                    uint64_t x=(uint64_t)((__uint128_t)in[(size_t)i*N+ri] * t.hatInv[i] % t.inModuli[i]);
+                    sum+=(__uint128_t)x * t.hatModOut[i*t.sizeOut+j];
+                }
+                out[(size_t)j*N+ri]=(uint64_t)(sum % t.outModuli[j]);
+            }
+        }
+    }
+
+    void InnerProduct(const uint64_t* digits, int numDigits, const uint64_t* keyA, const uint64_t* keyB,
+                      uint64_t* out0, uint64_t* out1, int N, int sizeQl, int sizeQlP, int sizeQ, int sizeQP,
+                      const uint64_t* moduli, const uint64_t* mus, Stream s) {
+        for (int i=0; i<sizeQlP; i++) {
+            int k=i < sizeQl ? i : sizeQ + (i - sizeQl);
+            uint64_t q=moduli[i];
+            for (int ri=0; ri<N; ri++) {
+                __uint128_t s0=0, s1=0;
+                for (int d=0; d<numDigits; d++) {
+                    uint64_t c=digits[((size_t)d*sizeQlP + i)*N + ri];
+                    size_t kidx=((size_t)d*sizeQP + k)*N + ri;
+                    s0=(s0 + (__uint128_t)c * keyB[kidx]) % q;
+                    s1=(s1 + (__uint128_t)c * keyA[kidx]) % q;
+                }
+                out0[(size_t)i*N+ri]=(uint64_t)s0;
+                out1[(size_t)i*N+ri]=(uint64_t)s1;
+            }
+        }
+    }
+
+    void ModDownAdd(uint64_t* acc, const uint64_t* c, const uint64_t* sw, int N, int L, const uint64_t* moduli,
+                    const uint64_t* PInvModq, const uint64_t* PInvModqPrecon, Stream s) {
+        for (int i=0; i<L; i++) {
+            uint64_t q=moduli[i];
+            for (int ri=0; ri<N; ri++) {
+                size_t idx=(size_t)i*N+ri;
+                uint64_t diff=(c[idx] + q - sw[idx]) % q;
+                acc[idx]=(uint64_t)((acc[idx] + (__uint128_t)diff * PInvModq[i]) % q);
+            }
+        }
+    }
+
+    void MultScalar(uint64_t* a, int N, int L, const uint64_t* moduli, const uint64_t* scalars,
+                    const uint64_t* precons, Stream s) {
+        for (int i=0; i<L; i++)
+            for (int ri=0; ri<N; ri++)
+                a[(size_t)i*N+ri]=(uint64_t)((__uint128_t)a[(size_t)i*N+ri] * scalars[i] % moduli[i]);
+    }
+
+private:
+    void Transform(uint64_t* poly, const Chain& chain, bool inverse) {
+        usint N=chain->GetRingDimension();
+        usint m=chain->GetCyclotomicOrder();
+        for (size_t i=0; i<chain->GetParams().size(); i++) {
+            const auto& p=chain->GetParams()[i];
+            NativeVector v(N, p->GetModulus());
+            uint64_t* words=reinterpret_cast<uint64_t*>(&v[0]);
+            std::memcpy(words, poly + (size_t)i*N, N*sizeof(uint64_t));
+            if (inverse)
+                ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(p->GetRootOfUnity(), m, &v);
+            else
+                ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(p->GetRootOfUnity(), m, &v);
+            std::memcpy(poly + (size_t)i*N, words, N*sizeof(uint64_t));
+        }
+    }
+};
+
+/**
+* Device backend: kernels of gpu_functions.h on a stream, scratch blocks from gpuMemoryPool() and
+* NTT tables from GPUTwiddleCache. Nothing blocks the host except the one-time table uploads.
+*/
+class GPUKeySwitchBackend {
+public:
+    struct Stream {
+        hipStream_t stream;
+        ExecContext* ctx;
+    };
+    using Chain=NTT_params;
+
+    Chain GetChain(const std::shared_ptr<DCRTPoly::Params>& params) {
+        return GPUTwiddleCache::Instance().GetNTTParams(params);
+    }
+
+    uint64_t* Upload(const uint64_t* src, size_t n) {
+        auto& pool=gpuMemoryPool();
+        uint64_t* dev=pool.Upload(src, n);
+        pool.Synchronize();
+        return dev;
+    }
+    void FreeTable(uint64_t* p, size_t n) { gpuMemoryPool().Release(p, n); }
+
+    uint64_t* Acquire(size_t n) { return gpuMemoryPool().Acquire(n); }
+    // the blocks go back to the pool once the work enqueued on s so far has finished
+    void Release(const std::vector<std::pair<uint64_t*, size_t>>& blocks, Stream s) {
+        s.ctx->Defer(s.ctx->Record(s.stream), [blocks]() {
+            for (auto& b : blocks)
+                gpuMemoryPool().Release(b.first, b.second);
+        });
+    }
+
+    void Copy(uint64_t* dst, const uint64_t* src, size_t n, Stream s) {
+        if (n > 0)
+            copyOnGPUAsync(dst, src, n, s.stream);
+    }
+
+    void NTT(uint64_t* poly, const Chain& chain, Stream s) { gpuNTT(&poly, 1, chain, s.stream); }
+    void INTT(uint64_t* poly, const Chain& chain, Stream s) { gpuINTT(&poly, 1, chain, s.stream); }
+
+    void SwitchBasis(const uint64_t* in, uint64_t* out, int N, const SwitchBasis_params& t, Stream s) {
+        gpuSwitchBasis(in, out, N, t, s.stream);
+    }
+
+    void InnerProduct(const uint64_t* digits, int numDigits, const uint64_t* keyA, const uint64_t* keyB,
+                      uint64_t* out0, uint64_t* out1, int N, int sizeQl, int sizeQlP, int sizeQ, int sizeQP,
+                      const uint64_t* moduli, const uint64_t* mus, Stream s) {
+        gpuKeySwitchInnerProduct(digits, numDigits, keyA, keyB, out0, out1, N, sizeQl, sizeQlP, sizeQ, sizeQP,
+                                 moduli, mus, s.stream);
+    }
+
+    void ModDownAdd(uint64_t* acc, const uint64_t* c, const uint64_t* sw, int N, int L, const uint64_t* moduli,
+                    const uint64_t* PInvModq, const uint64_t* PInvModqPrecon, Stream s) {
+        gpuModDownAdd(acc, c, sw, N, L, moduli, PInvModq, PInvModqPrecon, s.stream);
+    }
+
+    void MultScalar(uint64_t* a, int N, int L, const uint64_t* moduli, const uint64_t* scalars,
+                    const uint64_t* precons, Stream s) {
+        gpuMultScalar(a, N, L, moduli, scalars, precons, s.stream);
+    }
+};
+
+/**
+* Hybrid key switching of raw ciphertexts for one crypto context.
+*
+* The tables of each level (number of Ql limbs) are uploaded to the backend on first use and
+* kept until destruction. Eval keys are uploaded once with UploadEvalKey.
+*/
+template <class Backend>
+class RawKeySwitch {
+public:
+    using Stream=typename Backend::Stream;
+    using Chain=typename Backend::Chain;
+
+    explicit RawKeySwitch(const CryptoContext<DCRTPoly>& cc, Backend backend=Backend())
+        : backend(backend) {
+        cryptoParams=std::dynamic_pointer_cast<CryptoParametersRNS>(cc->GetCryptoParameters());
+        if (cryptoParams==nullptr || cryptoParams->GetKeySwitchTechnique()!=HYBRID)
+            OPENFHE_THROW(config_error, "RawKeySwitch needs an RNS scheme with HYBRID key switching");
+    }
+
+    ~RawKeySwitch() {
+        for (auto& t : tables)
+            backend.FreeTable(t.first, t.second);
+    }
+    RawKeySwitch(const RawKeySwitch&)=delete;
+    RawKeySwitch& operator=(const RawKeySwitch&)=delete;
+
+    Backend& GetBackend() { return backend; }
+
+    /**
+    * Copies both halves of evalKey to the backend, in evaluation format over QP
+    */
+    RawEvalKey UploadEvalKey(const EvalKey<DCRTPoly>& evalKey) {
+        const auto lease=evalKey->Lease();
+        const std::vector<DCRTPoly>& av=evalKey->GetAVector();
+        const std::vector<DCRTPoly>& bv=evalKey->GetBVector();
+        RawEvalKey key;
+        key.numDigits=av.size();
+        key.sizeQP=av[0].GetNumOfElements();
+        key.N=av[0].GetRingDimension();
+        size_t limbs=(size_t)key.numDigits*key.sizeQP;
+        std::vector<uint64_t> flatA(limbs*key.N), flatB(limbs*key.N);
+        for (int d=0; d<key.numDigits; d++) {
+            for (int i=0; i<key.sizeQP; i++) {
+                size_t offset=((size_t)d*key.sizeQP + i)*key.N;
+                const NativeVector& va=av[d].GetElementAtIndex(i).GetValues();
+                const NativeVector& vb=bv[d].GetElementAtIndex(i).GetValues();
+                std::memcpy(&flatA[offset], &va[0], key.N*sizeof(uint64_t));
+                std::memcpy(&flatB[offset], &vb[0], key.N*sizeof(uint64_t));
+            }
+        }
+        key.a=backend.Upload(flatA.data(), flatA.size());
+        key.b=backend.Upload(flatB.data(), flatB.size());
+        return key;
+    }
+
+    void FreeEvalKey(RawEvalKey& key) {
+        size_t n=(size_t)key.numDigits*key.sizeQP*key.N;
+        backend.FreeTable(key.a, n);
+        backend.FreeTable(key.b, n);
+        key.a=key.b=nullptr;
+    }
+
+    /**
+    * c0 += KeySwitchCore(d2)[0], c1 += KeySwitchCore(d2)[1] for sizeQl limbs of N words in
+    * evaluation format. d2 is not modified.
+    */
+    void KeySwitchAdd(const uint64_t* d2, uint64_t* c0, uint64_t* c1, int sizeQl, const RawEvalKey& key, Stream s) {
+        const Level& lv=GetLevel(sizeQl);
+        int N=key.N;
+        size_t extSize=(size_t)lv.sizeQlP*N;
+
+        uint64_t* digits=backend.Acquire(lv.digits.size()*extSize);
+        uint64_t* out0=backend.Acquire(extSize);
+        uint64_t* out1=backend.Acquire(extSize);
+        uint64_t* tmp=backend.Acquire(extSize);
+
+        // EvalKeySwitchPrecomputeCore: digit k is its own limbs of d2 plus their switch to the complement
+        for (size_t k=0; k<lv.digits.size(); k++) {
+            const Digit& g=lv.digits[k];
+            uint64_t* digit=digits + k*extSize;
+            uint64_t* own=digit + (size_t)g.start*N;
+            uint64_t* part=out0;
+            uint64_t* complement=out1;
+            backend.Copy(own, d2 + (size_t)g.start*N, (size_t)g.size*N, s);
+            backend.Copy(part, own, (size_t)g.size*N, s);
+            backend.INTT(part, g.partChain, s);
+            backend.SwitchBasis(part, complement, N, g.toCompl, s);
+            backend.NTT(complement, g.complChain, s);
+            backend.Copy(digit, complement, (size_t)g.start*N, s);
+            backend.Copy(own + (size_t)g.size*N, complement + (size_t)g.start*N,
+                         (size_t)(lv.sizeQlP - g.start - g.size)*N, s);
+        }
+
+        // EvalFastKeySwitchCoreExt
+        backend.InnerProduct(digits, lv.digits.size(), key.a, key.b, out0, out1, N, lv.sizeQl, lv.sizeQlP,
+                             key.sizeQP - lv.sizeP, key.sizeQP, lv.moduli, lv.mus, s);
+
+        // ApproxModDown of both halves
+        ModDownAdd(lv, c0, out0, tmp, N, s);
+        ModDownAdd(lv, c1, out1, tmp, N, s);
+
+        backend.Release({{digits, lv.digits.size()*extSize}, {out0, extSize}, {out1, extSize}, {tmp, extSize}}, s);
+    }
+
+private:
+    struct Digit {
+        int start; // first limb of Ql in the digit
+        int size; // number of limbs of Ql in the digit
+        Chain partChain; // NTT tables of the limbs of the digit
+        Chain complChain; // NTT tables of the complement of the digit in QlP
+        SwitchBasis_params toCompl;
+    };
+
+    struct Level {
+        int sizeQl;
+        int sizeP;
+        int sizeQlP;
+        std::vector<Digit> digits;
+        Chain QlChain;
+        Chain PChain;
+        uint64_t* moduli; // the sizeQlP moduli of QlP
+        uint64_t* mus; // two words per modulus, see AppendBarrettMu128
+        SwitchBasis_params PToQl;
+        uint64_t* PInvModq;
+        uint64_t* PInvModqPrecon;
+        // t = plaintext modulus when the noise scale is not 1 (BGV), otherwise null
+        uint64_t* tInvModp=nullptr;
+        uint64_t* tInvModpPrecon=nullptr;
+        uint64_t* tModq=nullptr;
+        uint64_t* tModqPrecon=nullptr;
+    };
+
+    // ext (QlP) -> (ext_Ql - Ql(ext_P)) * P^-1 added to acc, ext is used as scratch
+    void ModDownAdd(const Level& lv, uint64_t* acc, uint64_t* ext, uint64_t* tmp, int N, Stream s) {
+        uint64_t* partP=ext + (size_t)lv.sizeQl*N;
+        const uint64_t* PModuli=lv.moduli + lv.sizeQl;
+        backend.INTT(partP, lv.PChain, s);
+        if (lv.tInvModp)
+            backend.MultScalar(partP, N, lv.sizeP, PModuli, lv.tInvModp, lv.tInvModpPrecon, s);
+        backend.SwitchBasis(partP, tmp, N, lv.PToQl, s);
+        if (lv.tModq)
+            backend.MultScalar(tmp, N, lv.sizeQl, lv.moduli, lv.tModq, lv.tModqPrecon, s);
+        backend.NTT(tmp, lv.QlChain, s);
+        backend.ModDownAdd(acc, ext, tmp, N, lv.sizeQl, lv.moduli, lv.PInvModq, lv.PInvModqPrecon, s);
+    }
+
+    uint64_t* Upload(const std::vector<uint64_t>& v) {
+        uint64_t* p=backend.Upload(v.data(), v.size());
+        tables.push_back({p, v.size()});
+        return p;
+    }
+
+    // Shoup precomputations floor(x * 2^64 / q) of x[i] mod moduli[i]
+    static std::vector<uint64_t> Precon(const std::vector<uint64_t>& x, const std::vector<uint64_t>& moduli) {
+        std::vector<uint64_t> result(x.size());
+        for (size_t i=0; i<x.size(); i++)
+            result[i]=(uint64_t)(((__uint128_t)x[i] << 64) / moduli[i]);
+        return result;
+    }
+
+    SwitchBasis_params UploadSwitchBasis(const std::vector<uint64_t>& inModuli, const std::vector<uint64_t>& hatInv,
+                                         const std::vector<std::vector<NativeInteger>>& hatModOut,
+                                         const std::vector<uint64_t>& outModuli) {
+        SwitchBasis_params t;
+        t.sizeIn=inModuli.size();
+        t.sizeOut=outModuli.size();
+        std::vector<uint64_t> matrix, mus;
+        for (int i=0; i<t.sizeIn; i++)
+            for (int j=0; j<t.sizeOut; j++)
+                matrix.push_back(hatModOut[i][j].ConvertToInt());
+        for (auto q : outModuli)
+            AppendBarrettMu128(mus, q);
+        t.inModuli=Upload(inModuli);
+        t.hatInv=Upload(hatInv);
+        t.hatInvPrecon=Upload(Precon(hatInv, inModuli));
+        t.hatModOut=Upload(matrix);
+        t.outModuli=Upload(outModuli);
+        t.outMu=Upload(mus);
+        return t;
+    }
+
+    static std::vector<uint64_t> GetModuli(const std::shared_ptr<DCRTPoly::Params>& params) {
+        std::vector<uint64_t> moduli;
+        for (const auto& p : params->GetParams())
+            moduli.push_back(p->GetModulus().ConvertToInt());
+        return moduli;
+    }
+
+    const Level& GetLevel(int sizeQl) {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it=levels.find(sizeQl);
+        if (it!=levels.end())
+            return it->second;
+
+        auto paramsQ=cryptoParams->GetElementParams();
+        auto paramsP=cryptoParams->GetParamsP();
+        auto paramsQl=GetSubParams(paramsQ, 0, sizeQl);
+        Level lv;
+        lv.sizeQl=sizeQl;
+        lv.sizeP=paramsP->GetParams().size();
+        lv.sizeQlP=sizeQl + lv.sizeP;
+        lv.QlChain=backend.GetChain(paramsQl);
+        lv.PChain=backend.GetChain(paramsP);
+
+        std::vector<uint64_t> QlModuli=GetModuli(paramsQl);
+        std::vector<uint64_t> PModuli=GetModuli(paramsP);
+        std::vector<uint64_t> QlPModuli=QlModuli;
+        QlPModuli.insert(QlPModuli.end(), PModuli.begin(), PModuli.end());
+        std::vector<uint64_t> mus;
+        for (auto q : QlPModuli)
+            AppendBarrettMu128(mus, q);
+        lv.moduli=Upload(QlPModuli);
+        lv.mus=Upload(mus);
+
+        // same split as KeySwitchHYBRID::EvalKeySwitchPrecomputeCore
+        uint32_t alpha=cryptoParams->GetNumPerPartQ();
+        uint32_t numPartQl=ceil((static_cast<double>(sizeQl)) / alpha);
+        if (numPartQl > cryptoParams->GetNumberOfQPartitions())
+            numPartQl=cryptoParams->GetNumberOfQPartitions();
+        for (uint32_t part=0; part<numPartQl; part++) {
+            Digit g;
+            g.start=alpha*part;
+            g.size=(part==numPartQl-1) ? sizeQl - g.start : cryptoParams->GetParamsPartQ(part)->GetParams().size();
+            auto paramsPart=GetSubParams(cryptoParams->GetParamsPartQ(part), 0, g.size);
+            auto paramsCompl=cryptoParams->GetParamsComplPartQ(sizeQl-1, part);
+            g.partChain=backend.GetChain(paramsPart);
+            g.complChain=backend.GetChain(paramsCompl);
+            g.toCompl=UploadSwitchBasis(GetModuli(paramsPart), GetWords(cryptoParams->GetPartQlHatInvModq(part, g.size-1)),
+                                        cryptoParams->GetPartQlHatModp(sizeQl-1, part), GetModuli(paramsCompl));
+            lv.digits.push_back(g);
+        }
+
+        // same tables as KeySwitchHYBRID::EvalFastKeySwitchCore passes to ApproxModDown
+        lv.PToQl=UploadSwitchBasis(PModuli, GetWords(cryptoParams->GetPHatInvModp()), cryptoParams->GetPHatModq(), QlModuli);
+        std::vector<uint64_t> PInvModq=GetWords(cryptoParams->GetPInvModq());
+        PInvModq.resize(sizeQl);
+        lv.PInvModq=Upload(PInvModq);
+        lv.PInvModqPrecon=Upload(Precon(PInvModq, QlModuli));
+
+        PlaintextModulus t=(cryptoParams->GetNoiseScale()==1) ? 0 : cryptoParams->GetPlaintextModulus();
+        if (t > 0) {
+            std::vector<uint64_t> tInvModp=GetWords(cryptoParams->GettInvModp());
+            std::vector<uint64_t> tModq(sizeQl);
+            for (int i=0; i<sizeQl; i++)
+                tModq[i]=t % QlModuli[i];
+            lv.tInvModp=Upload(tInvModp);
+            lv.tInvModpPrecon=Upload(Precon(tInvModp, PModuli));
+            lv.tModq=Upload(tModq);
+            lv.tModqPrecon=Upload(Precon(tModq, QlModuli));
+        }
+        return levels.emplace(sizeQl, lv).first->second;
+    }
+
+    Backend backend;
+    std::shared_ptr<CryptoParametersRNS> cryptoParams;
+    std::mutex mtx;
+    std::map<int, Level> levels;
+    std::vector<std::pair<uint64_t*, size_t>> tables;
+};
+
+/**
+* Sets the metadata of the OpenFHE ciphertext behind ct1 to that of the product ct1 * ct2,
+* as LeveledSHEBase::EvalMultCore does
+*/
+void SetMultMetadata(RawCipherText* ct1, RawCipherText* ct2) {
+    auto result=ct1->originalCipherText;
+    auto other=ct2->originalCipherText;
+    const auto plainMod=result->GetCryptoParameters()->GetPlaintextModulus();
+    result->SetScalingFactorInt(result->GetScalingFactorInt().ModMul(other->GetScalingFactorInt(), plainMod));
+    result->SetScalingFactor(result->GetScalingFactor() * other->GetScalingFactor());
+    result->SetNoiseScaleDeg(result->GetNoiseScaleDeg() + other->GetNoiseScaleDeg());
+}
+
+/**
+* Evaluates homomorphic multiplication with relinearization on the GPU, the device counterpart of
+* CryptoContext::EvalMult(ct1, ct2) for HYBRID key switching. The result replaces ct1; both
+* ciphertexts must be on the GPU, in evaluation format and at the same level, and key is the
+* uploaded EvalMult key. Rescaling is left to the caller.
+*/
+GpuFuture EvalMultGPU(RawCipherText* ct1, RawCipherText* ct2, RawKeySwitch<GPUKeySwitchBackend>& ks,
+                      const RawEvalKey& key, ExecContext& ctx = ExecContext::Default()) {
+    EvalMultGPUNoRelin(ct1, ct2, ctx);
+    hipStream_t stream=BeginGPUOp(ct1, ct2, ctx);
+    ks.KeySwitchAdd(ct1->sub_2, ct1->sub_0, ct1->sub_1, ct1->numRes, key, {stream, &ctx});
+    // d2 is folded into sub_0/sub_1, MoveToHost does not need to download it
+    ct1->has_2=false;
+    SetMultMetadata(ct1, ct2);
+    return EndGPUOp(ct1, ct2, stream, ctx);
+}
+
+/**
+* EvalMultGPU on ciphertexts held on the host, with the reference backend
+*/
+void EvalMultCPU(RawCipherText* ct1, RawCipherText* ct2, RawKeySwitch<CPUKeySwitchBackend>& ks, const RawEvalKey& key) {
+    size_t N=ct1->N;
+    std::vector<uint64_t> d2((size_t)ct1->numRes*N);
+    for (int r=0; r<ct1->numRes; r++) {
+        uint64_t q=ct1->moduli[r];
+        for (size_t i=r*N; i<(r+1)*N; i++) {
+            uint64_t a0=ct1->sub_0[i], a1=ct1->sub_1[i], b0=ct2->sub_0[i], b1=ct2->sub_1[i];
+            uint64_t d1=(uint64_t)(((__uint128_t)a0*b1 + (__uint128_t)a1*b0) % q);
+            ct1->sub_0[i]=(uint64_t)((__uint128_t)a0*b0 % q);
+            ct1->sub_1[i]=d1;
+            d2[i]=(uint64_t)((__uint128_t)a1*b1 % q);
+        }
+    }
+    ks.KeySwitchAdd(d2.data(), ct1->sub_0, ct1->sub_1, ct1->numRes, key, {});
+    SetMultMetadata(ct1, ct2);
+}
+
+#endif
@@ -39,6 +39,7 @@
 #include "utils/caller_info.h"
 #include "math/hal/basicint.h"
 
+#include <complex>
 #include <map>
 #include <memory>
 #include <string>
@@ -51,6 +52,14 @@
  */
 namespace lbcrypto {
 
+// diagonal of a bootstrapping linear transform kept as slot values; it is encoded
+// in the extended basis described by params only when it is multiplied in
+struct CKKSCompactDiagonal {
+    std::vector<std::complex<double>> values;
+    std::shared_ptr<ILDCRTParams<BigInteger>> params;
+    uint32_t level = 0;
+};
+
 class CKKSBootstrapPrecom {
 public:
     CKKSBootstrapPrecom() {}
@@ -64,6 +73,9 @@ public:
         m_U0hatTPre    = rhs.m_U0hatTPre;
         m_U0PreFFT     = rhs.m_U0PreFFT;
         m_U0hatTPreFFT = rhs.m_U0hatTPreFFT;
+
+        m_U0PreFFTCompact     = rhs.m_U0PreFFTCompact;
+        m_U0hatTPreFFTCompact = rhs.m_U0hatTPreFFTCompact;
     }
 
     CKKSBootstrapPrecom(CKKSBootstrapPrecom&& rhs) {
@@ -75,6 +87,9 @@ public:
         m_U0hatTPre    = std::move(rhs.m_U0hatTPre);
         m_U0PreFFT     = std::move(rhs.m_U0PreFFT);
         m_U0hatTPreFFT = std::move(rhs.m_U0hatTPreFFT);
+
+        m_U0PreFFTCompact     = std::move(rhs.m_U0PreFFTCompact);
+        m_U0hatTPreFFTCompact = std::move(rhs.m_U0hatTPreFFTCompact);
     }
 
     virtual ~CKKSBootstrapPrecom() {}
@@ -111,6 +126,12 @@ public:
 
     // coefficients corresponding to conj(U0^T); used in encoding
     std::vector<std::vector<ConstPlaintext>> m_U0hatTPreFFT;
+
+    // compact form of m_U0PreFFT; filled instead of it when compact diagonals are enabled
+    std::vector<std::vector<CKKSCompactDiagonal>> m_U0PreFFTCompact;
+
+    // compact form of m_U0hatTPreFFT; filled instead of it when compact diagonals are enabled
+    std::vector<std::vector<CKKSCompactDiagonal>> m_U0hatTPreFFTCompact;
 };
 
 class FHECKKSRNS : public FHERNS {
@@ -129,17 +150,22 @@ public:
     void EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::vector<uint32_t> levelBudget,
                             std::vector<uint32_t> dim1, uint32_t slots, uint32_t correctionFactor) override;
 
+    void EvalBootstrapSetMemoryBudget(uint64_t memoryBudget, bool compactDiagonals) override;
+
     std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> EvalBootstrapKeyGen(const PrivateKey<DCRTPoly> privateKey,
                                                                             uint32_t slots) override;
 
     Ciphertext<DCRTPoly> EvalBootstrap(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numIterations,
                                        uint32_t precision) const override;
 
+    std::vector<Ciphertext<DCRTPoly>> EvalBootstrapBatch(const std::vector<Ciphertext<DCRTPoly>>& ciphertexts,
+                                                         uint32_t numIterations, uint32_t precision) const override;
+
     //------------------------------------------------------------------------------
     // Find Rotation Indices
     //------------------------------------------------------------------------------
 
-    std::vector<int32_t> FindBootstrapRotationIndices(uint32_t slots, uint32_t M);
+    std::vector<int32_t> FindBootstrapRotationIndices(uint32_t slots, uint32_t M) override;
 
     std::vector<int32_t> FindLinearTransformRotationIndices(uint32_t slots, uint32_t M);
 
@@ -185,6 +211,12 @@ public:
     Ciphertext<DCRTPoly> EvalSlotsToCoeffs(const std::vector<std::vector<ConstPlaintext>>& A,
                                            ConstCiphertext<DCRTPoly> ctxt) const;
 
+    Ciphertext<DCRTPoly> EvalCoeffsToSlots(const std::vector<std::vector<CKKSCompactDiagonal>>& A,
+                                           ConstCiphertext<DCRTPoly> ctxt) const;
+
+    Ciphertext<DCRTPoly> EvalSlotsToCoeffs(const std::vector<std::vector<CKKSCompactDiagonal>>& A,
+                                           ConstCiphertext<DCRTPoly> ctxt) const;
+
     //------------------------------------------------------------------------------
     // SERIALIZATION
     //------------------------------------------------------------------------------
@@ -225,6 +257,43 @@ private:
                                const std::vector<std::complex<double>>& value, size_t noiseScaleDeg, uint32_t level,
                                usint slots) const;
 
+    std::vector<std::vector<CKKSCompactDiagonal>> EvalCoeffsToSlotsDiagonals(
+        const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
+        const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const;
+
+    std::vector<std::vector<CKKSCompactDiagonal>> EvalSlotsToCoeffsDiagonals(
+        const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
+        const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const;
+
+    std::vector<std::vector<ConstPlaintext>> EncodeDiagonals(
+        const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::vector<CKKSCompactDiagonal>>& diagonals) const;
+
+    ConstPlaintext GetDiagonal(const CryptoContextImpl<DCRTPoly>& cc, const ConstPlaintext& diagonal) const {
+        return diagonal;
+    }
+
+    ConstPlaintext GetDiagonal(const CryptoContextImpl<DCRTPoly>& cc, const CKKSCompactDiagonal& diagonal) const {
+        return MakeAuxPlaintext(cc, diagonal.params, diagonal.values, 1, diagonal.level, diagonal.values.size());
+    }
+
+    /**
+   * Hoisted baby-step giant-step evaluation of sum_i rot_{rotOut[i]}(sum_j A[g*i+j] * rot_{rotIn[j]}(ct)),
+   * g = rotIn.size(). Diagonals with index >= A.size() are skipped. If a memory budget is set,
+   * the baby-step rotations are streamed in tiles so that at most the budgeted number of
+   * extended ciphertexts is alive at once.
+   */
+    template <typename Diagonal>
+    Ciphertext<DCRTPoly> EvalBSGSHoisted(ConstCiphertext<DCRTPoly> ct, const std::vector<Diagonal>& A,
+                                         const std::vector<int32_t>& rotIn, const std::vector<int32_t>& rotOut) const;
+
+    template <typename Diagonal>
+    Ciphertext<DCRTPoly> EvalCoeffsToSlotsInternal(const std::vector<std::vector<Diagonal>>& A,
+                                                   ConstCiphertext<DCRTPoly> ctxt) const;
+
+    template <typename Diagonal>
+    Ciphertext<DCRTPoly> EvalSlotsToCoeffsInternal(const std::vector<std::vector<Diagonal>>& A,
+                                                   ConstCiphertext<DCRTPoly> ctxt) const;
+
     Ciphertext<DCRTPoly> EvalMultExt(ConstCiphertext<DCRTPoly> ciphertext, ConstPlaintext plaintext) const;
 
     void EvalAddExtInPlace(Ciphertext<DCRTPoly>& ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2) const;
@@ -265,6 +334,8 @@ private:
     static const uint32_t R_SPARSE =
         3;  // number of double-angle iterations in CKKS bootstrapping. Must be static because it is used in a static function.
     uint32_t m_correctionFactor = 0;  // correction factor, which we scale the message by to improve precision
+    uint64_t m_ltMemoryBudget   = 0;  // target working set of the bootstrapping linear transforms in bytes; 0 means no limit
+    bool m_compactDiagonals     = false;  // store CoeffsToSlots/SlotsToCoeffs diagonals as slot values
 
     // Chebyshev series coefficients for the SPARSE case
     static const inline std::vector<double> g_coefficientsSparse{
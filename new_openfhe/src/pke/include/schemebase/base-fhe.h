@@ -85,6 +85,19 @@ public:
         OPENFHE_THROW(not_implemented_error, "Not supported");
     }
 
+    /**
+   * Limits the working set of the bootstrapping linear transforms. Has to be called
+   * before EvalBootstrapSetup.
+   *
+   * @param memoryBudget - target in bytes for the hoisted digits, rotations and partial
+   * sums kept alive by CoeffsToSlots/SlotsToCoeffs, see CryptoContextImpl; 0 means no limit
+   * @param compactDiagonals - if true, the linear transform diagonals are stored as
+   * double-precision slot values and encoded when they are used
+   */
+    virtual void EvalBootstrapSetMemoryBudget(uint64_t memoryBudget, bool compactDiagonals) {
+        OPENFHE_THROW(not_implemented_error, "EvalBootstrapSetMemoryBudget is not implemented for this scheme");
+    }
+
     /**
    * Virtual function to define the generation of all automorphism keys for EvalBT (with FFT evaluation).
    * EvalBTKeyGen uses the baby-step/giant-step strategy.
@@ -118,6 +131,30 @@ public:
         OPENFHE_THROW(not_implemented_error, "EvalBootstrap is not implemented for this scheme");
     }
 
+    /**
+   * Bootstraps several independent ciphertexts concurrently
+   *
+   * @param ciphertexts the input ciphertexts.
+   * @param numIterations number of iterations to run iterative bootstrapping (Meta-BTS).
+   * @param precision precision of initial bootstrapping algorithm.
+   * @return the refreshed ciphertexts, in the order of the input.
+   */
+    virtual std::vector<Ciphertext<Element>> EvalBootstrapBatch(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                                uint32_t numIterations, uint32_t precision) const {
+        OPENFHE_THROW(not_implemented_error, "EvalBootstrapBatch is not implemented for this scheme");
+    }
+
+    /**
+   * Finds the rotation indices EvalBootstrapKeyGen generates keys for
+   *
+   * @param slots number of slots to be bootstrapped
+   * @param M cyclotomic order
+   * @return the rotation indices
+   */
+    virtual std::vector<int32_t> FindBootstrapRotationIndices(uint32_t slots, uint32_t M) {
+        OPENFHE_THROW(not_implemented_error, "FindBootstrapRotationIndices is not implemented for this scheme");
+    }
+
     /**
    * Sets all parameters for switching from CKKS to FHEW
    *
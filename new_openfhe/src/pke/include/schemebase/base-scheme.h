@@ -1346,6 +1346,11 @@ public:
         return;
     }
 
+    void EvalBootstrapSetMemoryBudget(uint64_t memoryBudget, bool compactDiagonals) {
+        VerifyFHEEnabled(__func__);
+        m_FHE->EvalBootstrapSetMemoryBudget(memoryBudget, compactDiagonals);
+    }
+
     std::shared_ptr<std::map<usint, EvalKey<Element>>> EvalBootstrapKeyGen(const PrivateKey<Element> privateKey,
                                                                            uint32_t slots) {
         VerifyFHEEnabled(__func__);
@@ -1358,6 +1363,17 @@ public:
         return m_FHE->EvalBootstrap(ciphertext, numIterations, precision);
     }
 
+    std::vector<Ciphertext<Element>> EvalBootstrapBatch(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                        uint32_t numIterations = 1, uint32_t precision = 0) const {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->EvalBootstrapBatch(ciphertexts, numIterations, precision);
+    }
+
+    std::vector<int32_t> FindBootstrapRotationIndices(uint32_t slots, uint32_t M) {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->FindBootstrapRotationIndices(slots, M);
+    }
+
     // SCHEMESWITCHING methods
 
     std::pair<BinFHEContext, LWEPrivateKey> EvalCKKStoFHEWSetup(const CryptoContextImpl<Element>& cc,
@@ -0,0 +1,468 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+#include "key/evalkeystore.h"
+#include "cryptocontext.h"
+#include "key/key-ser.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define OPENFHE_EVALKEYSTORE_MMAP
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <streambuf>
+#include <utility>
+
+namespace lbcrypto {
+
+namespace {
+
+constexpr char STORE_MAGIC[8] = {'O', 'F', 'H', 'E', 'K', 'S', '0', '1'};
+// the file ends with the index offset followed by the magic
+constexpr size_t FOOTER_SIZE = sizeof(uint64_t) + sizeof(STORE_MAGIC);
+
+enum EntryKind : uint32_t { MULT_KEY = 0, AUTOMORPHISM_KEY = 1 };
+
+struct IndexEntry {
+    std::string tag;
+    uint32_t kind;
+    uint32_t index;
+    uint64_t offset;
+    uint64_t size;
+
+    template <class Archive>
+    void serialize(Archive& ar) {
+        ar(tag, kind, index, offset, size);
+    }
+};
+
+struct StoreIndex {
+    uint32_t ringDim;
+    uint32_t towers;
+    uint64_t q0;
+    std::vector<IndexEntry> entries;
+
+    template <class Archive>
+    void serialize(Archive& ar) {
+        ar(ringDim, towers, q0, entries);
+    }
+};
+
+// read-only stream buffer over bytes that are not copied
+class MemoryBuffer : public std::streambuf {
+public:
+    MemoryBuffer(const char* data, size_t size) {
+        char* p = const_cast<char*>(data);
+        setg(p, p, p + size);
+    }
+};
+
+StoreIndex ContextIndex(const CryptoContext<DCRTPoly>& cc) {
+    const auto elementParams = cc->GetCryptoParameters()->GetElementParams();
+    StoreIndex index;
+    index.ringDim = elementParams->GetRingDimension();
+    index.towers  = static_cast<uint32_t>(elementParams->GetParams().size());
+    index.q0      = elementParams->GetParams()[0]->GetModulus().ConvertToInt<uint64_t>();
+    return index;
+}
+
+void WriteKey(std::ostream& os, const EvalKey<DCRTPoly>& evalKey) {
+    const auto key = std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(evalKey);
+    if (key == nullptr)
+        OPENFHE_THROW(config_error, "only relinearization keys can be written to a key store");
+
+    // a seeded A vector is written as its seed, as the key serialization does
+    const auto lease = key->Lease();
+    cereal::PortableBinaryOutputArchive ar(os);
+    const bool seeded{key->IsASeeded()};
+    ar(seeded ? key->GetASeed() : std::vector<PRNG::result_type>());
+    if (!seeded)
+        ar(key->GetAVector());
+    ar(key->GetBVector());
+}
+
+}  // namespace
+
+struct EvalKeyStore::Entry {
+    std::string tag;
+    uint32_t kind;
+    uint32_t index;
+    uint64_t offset;
+    uint64_t size;
+
+    std::mutex loadMutex;
+    // the deserialized key, shared with the leases on it; guarded by the mutex of the store
+    std::shared_ptr<const std::vector<std::vector<DCRTPoly>>> data;
+    uint64_t lastUse{0};
+};
+
+/**
+ * Placeholder key that deserializes its vectors from the store on first use
+ */
+class EvalKeyStore::StoredKey final : public EvalKeyRelinImpl<DCRTPoly> {
+public:
+    StoredKey(const CryptoContext<DCRTPoly>& cc, std::shared_ptr<EvalKeyStore> store, Entry& entry)
+        : EvalKeyRelinImpl<DCRTPoly>(cc), m_store(std::move(store)), m_entry(entry) {
+        this->SetKeyTag(entry.tag);
+    }
+
+    const std::vector<DCRTPoly>& GetAVector() const override {
+        return m_store->Leased(m_entry)[0];
+    }
+
+    const std::vector<DCRTPoly>& GetBVector() const override {
+        return m_store->Leased(m_entry)[1];
+    }
+
+    std::shared_ptr<const void> Lease() const override {
+        return m_store->Fetch(m_entry);
+    }
+
+private:
+    std::shared_ptr<EvalKeyStore> m_store;
+    Entry& m_entry;
+};
+
+EvalKeyStore::EvalKeyStore(const std::string& filename, const CryptoContext<DCRTPoly>& cc, size_t maxResident)
+    : m_cc(cc), m_maxResident(maxResident) {
+#ifdef OPENFHE_EVALKEYSTORE_MMAP
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        OPENFHE_THROW(config_error, "cannot open key store " + filename);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        OPENFHE_THROW(config_error, "cannot read key store " + filename);
+    }
+    void* map = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    // the mapping stays valid after the descriptor is closed
+    close(fd);
+    if (map == MAP_FAILED)
+        OPENFHE_THROW(config_error, "cannot map key store " + filename);
+    // keys are fetched in the order of use, not of the file
+    madvise(map, static_cast<size_t>(st.st_size), MADV_RANDOM);
+    m_map     = static_cast<const char*>(map);
+    m_mapSize = static_cast<size_t>(st.st_size);
+#else
+    m_file.open(filename, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!m_file.is_open())
+        OPENFHE_THROW(config_error, "cannot open key store " + filename);
+    m_mapSize = static_cast<size_t>(m_file.tellg());
+#endif
+}
+
+EvalKeyStore::~EvalKeyStore() {
+#ifdef OPENFHE_EVALKEYSTORE_MMAP
+    if (m_map != nullptr)
+        munmap(const_cast<char*>(m_map), m_mapSize);
+#endif
+}
+
+void EvalKeyStore::Write(const std::string& filename, const CryptoContext<DCRTPoly>& cc, const std::string& keyTag) {
+    StoreIndex index = ContextIndex(cc);
+
+    std::ofstream os(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!os.is_open())
+        OPENFHE_THROW(config_error, "cannot open key store " + filename + " for writing");
+    os.write(STORE_MAGIC, sizeof(STORE_MAGIC));
+
+    auto add = [&](const EvalKey<DCRTPoly>& key, const std::string& tag, uint32_t kind, uint32_t i) {
+        const uint64_t offset = static_cast<uint64_t>(os.tellp());
+        WriteKey(os, key);
+        index.entries.push_back({tag, kind, i, offset, static_cast<uint64_t>(os.tellp()) - offset});
+    };
+
+    for (const auto& [tag, keys] : CryptoContextImpl<DCRTPoly>::GetAllEvalMultKeys()) {
+        if ((!keyTag.empty() && tag != keyTag) || keys.empty() || keys[0]->GetCryptoContext() != cc)
+            continue;
+        for (size_t i = 0; i < keys.size(); ++i)
+            add(keys[i], tag, MULT_KEY, static_cast<uint32_t>(i));
+    }
+    for (const auto& [tag, keys] : CryptoContextImpl<DCRTPoly>::GetAllEvalAutomorphismKeys()) {
+        if ((!keyTag.empty() && tag != keyTag) || keys == nullptr || keys->empty() ||
+            keys->begin()->second->GetCryptoContext() != cc)
+            continue;
+        for (const auto& [autoIndex, key] : *keys)
+            add(key, tag, AUTOMORPHISM_KEY, autoIndex);
+    }
+    if (index.entries.empty())
+        OPENFHE_THROW(config_error, "no evaluation keys to write for key tag \"" + keyTag + "\"");
+
+    const uint64_t indexOffset = static_cast<uint64_t>(os.tellp());
+    {
+        cereal::PortableBinaryOutputArchive ar(os);
+        ar(index);
+    }
+    // the footer is little-endian regardless of the host
+    char footer[FOOTER_SIZE];
+    for (size_t i = 0; i < sizeof(uint64_t); ++i)
+        footer[i] = static_cast<char>((indexOffset >> (8 * i)) & 0xff);
+    std::memcpy(footer + sizeof(uint64_t), STORE_MAGIC, sizeof(STORE_MAGIC));
+    os.write(footer, FOOTER_SIZE);
+    if (!os.good())
+        OPENFHE_THROW(config_error, "cannot write key store " + filename);
+}
+
+std::shared_ptr<EvalKeyStore> EvalKeyStore::Open(const std::string& filename, const CryptoContext<DCRTPoly>& cc,
+                                                 size_t maxResident) {
+    std::shared_ptr<EvalKeyStore> store(new EvalKeyStore(filename, cc, maxResident));
+
+    if (store->m_mapSize < sizeof(STORE_MAGIC) + FOOTER_SIZE)
+        OPENFHE_THROW(deserialize_error, filename + " is not a key store");
+    const std::string head{store->ReadBytes(0, sizeof(STORE_MAGIC))};
+    const std::string footer{store->ReadBytes(store->m_mapSize - FOOTER_SIZE, FOOTER_SIZE)};
+    if (std::memcmp(head.data(), STORE_MAGIC, sizeof(STORE_MAGIC)) != 0 ||
+        std::memcmp(footer.data() + sizeof(uint64_t), STORE_MAGIC, sizeof(STORE_MAGIC)) != 0)
+        OPENFHE_THROW(deserialize_error, filename + " is not a key store");
+
+    uint64_t indexOffset = 0;
+    for (size_t i = 0; i < sizeof(uint64_t); ++i)
+        indexOffset |= static_cast<uint64_t>(static_cast<unsigned char>(footer[i])) << (8 * i);
+    if (indexOffset < sizeof(STORE_MAGIC) || indexOffset > store->m_mapSize - FOOTER_SIZE)
+        OPENFHE_THROW(deserialize_error, "invalid index offset in key store " + filename);
+
+    StoreIndex index;
+    {
+        const std::string bytes{store->ReadBytes(indexOffset, store->m_mapSize - FOOTER_SIZE - indexOffset)};
+        MemoryBuffer buffer(bytes.data(), bytes.size());
+        std::istream is(&buffer);
+        cereal::PortableBinaryInputArchive ar(is);
+        ar(index);
+    }
+
+    const StoreIndex expected = ContextIndex(cc);
+    if (index.ringDim != expected.ringDim || index.towers != expected.towers || index.q0 != expected.q0)
+        OPENFHE_THROW(config_error, "key store " + filename + " was not written for this crypto context");
+
+    std::map<std::string, std::vector<EvalKey<DCRTPoly>>> multKeys;
+    std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>>> automorphismKeys;
+    store->m_entries.reserve(index.entries.size());
+    for (const auto& e : index.entries) {
+        if (e.offset < sizeof(STORE_MAGIC) || e.offset > indexOffset || e.size > indexOffset - e.offset)
+            OPENFHE_THROW(deserialize_error, "invalid key offset in key store " + filename);
+        auto entry    = std::make_unique<Entry>();
+        entry->tag    = e.tag;
+        entry->kind   = e.kind;
+        entry->index  = e.index;
+        entry->offset = e.offset;
+        entry->size   = e.size;
+
+        auto key = std::make_shared<StoredKey>(cc, store, *entry);
+        if (e.kind == MULT_KEY) {
+            auto& keys = multKeys[e.tag];
+            if (keys.size() <= e.index)
+                keys.resize(e.index + 1);
+            keys[e.index] = key;
+        }
+        else {
+            auto& keys = automorphismKeys[e.tag];
+            if (keys == nullptr)
+                keys = std::make_shared<std::map<usint, EvalKey<DCRTPoly>>>();
+            (*keys)[e.index] = key;
+        }
+        store->m_entries.push_back(std::move(entry));
+    }
+
+    for (const auto& [tag, keys] : multKeys) {
+        if (std::any_of(keys.begin(), keys.end(), [](const EvalKey<DCRTPoly>& k) { return k == nullptr; }))
+            OPENFHE_THROW(deserialize_error, "missing relinearization key in key store " + filename);
+        CryptoContextImpl<DCRTPoly>::InsertEvalMultKey(keys);
+    }
+    for (const auto& [tag, keys] : automorphismKeys)
+        CryptoContextImpl<DCRTPoly>::InsertEvalAutomorphismKey(keys);
+
+    return store;
+}
+
+std::string EvalKeyStore::ReadBytes(uint64_t offset, uint64_t size) {
+    if (m_map != nullptr)
+        return std::string(m_map + offset, size);
+
+    std::string bytes(size, '\0');
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    m_file.seekg(static_cast<std::streamoff>(offset));
+    m_file.read(&bytes[0], static_cast<std::streamsize>(size));
+    if (!m_file.good())
+        OPENFHE_THROW(deserialize_error, "cannot read key store");
+    return bytes;
+}
+
+std::shared_ptr<const std::vector<std::vector<DCRTPoly>>> EvalKeyStore::Materialize(Entry& entry) {
+    // without a mapping the bytes are read into a private buffer
+    std::string bytes;
+    const char* data;
+    if (m_map != nullptr) {
+        data = m_map + entry.offset;
+    }
+    else {
+        bytes = ReadBytes(entry.offset, entry.size);
+        data  = bytes.data();
+    }
+    MemoryBuffer buffer(data, entry.size);
+    std::istream is(&buffer);
+    cereal::PortableBinaryInputArchive ar(is);
+
+    std::vector<PRNG::result_type> aSeed;
+    ar(aSeed);
+    std::vector<std::vector<DCRTPoly>> key(2);
+    if (aSeed.empty()) {
+        ar(key[0]);
+        ar(key[1]);
+    }
+    else {
+        if (aSeed.size() != std::tuple_size<PRNGSeed>::value)
+            OPENFHE_THROW(deserialize_error, "invalid seed of the A vector in key store");
+        ar(key[1]);
+        PRNGSeed seed;
+        std::copy(aSeed.begin(), aSeed.end(), seed.begin());
+        key[0].reserve(key[1].size());
+        for (size_t i = 0; i < key[1].size(); ++i)
+            key[0].emplace_back(seed, static_cast<uint32_t>(i), key[1][i].GetParams(), Format::EVALUATION);
+    }
+    return std::make_shared<const std::vector<std::vector<DCRTPoly>>>(std::move(key));
+}
+
+std::shared_ptr<const std::vector<std::vector<DCRTPoly>>> EvalKeyStore::Fetch(Entry& entry) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (entry.data != nullptr) {
+            entry.lastUse = ++m_tick;
+            return entry.data;
+        }
+    }
+
+    // the key is deserialized outside the lock of the store, once per entry
+    std::lock_guard<std::mutex> load(entry.loadMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (entry.data != nullptr) {
+            entry.lastUse = ++m_tick;
+            return entry.data;
+        }
+    }
+    auto data = Materialize(entry);
+
+    std::vector<std::shared_ptr<const std::vector<std::vector<DCRTPoly>>>> released;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        entry.data    = data;
+        entry.lastUse = ++m_tick;
+        ++m_resident;
+        released = Evict(&entry);
+    }
+    return data;
+}
+
+const std::vector<std::vector<DCRTPoly>>& EvalKeyStore::Leased(Entry& entry) {
+    // without a lease the key could be released while the caller still uses the returned reference
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (entry.data == nullptr || entry.data.use_count() < 2)
+        OPENFHE_THROW(config_error, "the vectors of a stored key require a lease, see EvalKeyImpl::Lease()");
+    return *entry.data;
+}
+
+std::vector<std::shared_ptr<const std::vector<std::vector<DCRTPoly>>>> EvalKeyStore::Evict(const Entry* keep) {
+    std::vector<std::shared_ptr<const std::vector<std::vector<DCRTPoly>>>> released;
+    const size_t maxResident = m_maxResident.load();
+    if (maxResident == 0)
+        return released;
+    while (m_resident.load() > maxResident) {
+        // a key is held by a lease when the entry does not own it alone; the leases are only copied under
+        // the lock, so such a key stays resident and counts towards the bound until its leases are gone
+        Entry* oldest = nullptr;
+        for (const auto& e : m_entries) {
+            if (e.get() == keep || e->data == nullptr || e->data.use_count() > 1)
+                continue;
+            if (oldest == nullptr || e->lastUse < oldest->lastUse)
+                oldest = e.get();
+        }
+        if (oldest == nullptr)
+            break;
+        released.push_back(std::move(oldest->data));
+        oldest->data = nullptr;
+        --m_resident;
+    }
+    return released;
+}
+
+void EvalKeyStore::SetMaxResident(size_t maxResident) {
+    std::vector<std::shared_ptr<const std::vector<std::vector<DCRTPoly>>>> released;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxResident = maxResident;
+    released = Evict(nullptr);
+}
+
+void EvalKeyStore::Preload(const std::vector<uint32_t>& autoIndices, const std::string& keyTag) {
+    std::map<uint32_t, Entry*> byIndex;
+    for (const auto& e : m_entries) {
+        if (e->kind == AUTOMORPHISM_KEY && e->tag == keyTag)
+            byIndex[e->index] = e.get();
+    }
+
+    std::vector<Entry*> entries;
+    entries.reserve(autoIndices.size());
+    for (uint32_t i : autoIndices) {
+        auto it = byIndex.find(i);
+        if (it != byIndex.end() && std::find(entries.begin(), entries.end(), it->second) == entries.end())
+            entries.push_back(it->second);
+    }
+
+    const size_t maxResident = m_maxResident.load();
+    const size_t count = maxResident == 0 ? entries.size() : std::min(entries.size(), maxResident);
+#ifdef OPENFHE_EVALKEYSTORE_MMAP
+    // read ahead the keys that do not fit under the bound
+    const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    for (size_t i = count; i < entries.size(); ++i) {
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(m_map + entries[i]->offset) & ~(page - 1);
+        const uintptr_t end   = reinterpret_cast<uintptr_t>(m_map + entries[i]->offset + entries[i]->size);
+        madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+    }
+#endif
+    for (size_t i = 0; i < count; ++i)
+        Fetch(*entries[i]);
+}
+
+void EvalKeyStore::PreloadBootstrap(uint32_t slots, const std::string& keyTag) {
+    std::vector<uint32_t> autoIndices;
+    for (int32_t index : m_cc->FindBootstrapRotationIndices(slots))
+        autoIndices.push_back(m_cc->FindAutomorphismIndex(static_cast<usint>(index)));
+    // EvalBootstrapKeyGen also generates the conjugation key
+    autoIndices.push_back(m_cc->GetCyclotomicOrder() - 1);
+    Preload(autoIndices, keyTag);
+}
+
+}  // namespace lbcrypto
@@ -60,7 +60,10 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
 
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
-    DugType dug;
+    // the uniform parts are expanded from a seed, which the key serialization writes in their place
+    PRNGSeed seed;
+    for (auto& w : seed)
+        w = PseudoRandomNumberGenerator::GetPRNG()();
 
     usint digitSize = cryptoParams->GetDigitSize();
 
@@ -93,7 +96,7 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
                 DCRTPoly filtered(elementParams, Format::EVALUATION, true);
                 filtered.SetElementAtIndex(i, sOldDecomposed[k]);
 
-                DCRTPoly a(dug, elementParams, Format::EVALUATION);
+                DCRTPoly a(seed, k + arrWindows[i], elementParams, Format::EVALUATION);
                 DCRTPoly e(dgg, elementParams, Format::EVALUATION);
 
                 av[k + arrWindows[i]] = a;
@@ -106,7 +109,7 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
             DCRTPoly filtered(elementParams, Format::EVALUATION, true);
             filtered.SetElementAtIndex(i, sOld.GetElementAtIndex(i));
 
-            DCRTPoly a(dug, elementParams, Format::EVALUATION);
+            DCRTPoly a(seed, i, elementParams, Format::EVALUATION);
             DCRTPoly e(dgg, elementParams, Format::EVALUATION);
 
             av[i] = a;
@@ -116,6 +119,7 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
 
     ek->SetAVector(std::move(av));
     ek->SetBVector(std::move(bv));
+    ek->SetASeed(seed);
     ek->SetKeyTag(newKey->GetKeyTag());
 
     return ek;
@@ -135,7 +139,10 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
 
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
-    DugType dug;
+    // the uniform parts are expanded from a seed, which the key serialization writes in their place
+    PRNGSeed seed;
+    for (auto& w : seed)
+        w = PseudoRandomNumberGenerator::GetPRNG()();
 
     usint digitSize = cryptoParams->GetDigitSize();
 
@@ -160,6 +167,7 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
     std::vector<DCRTPoly> av(nWindows);
     std::vector<DCRTPoly> bv(nWindows);
 
+    const auto lease = (ek == nullptr) ? nullptr : ek->Lease();
     if (digitSize > 0) {
         for (usint i = 0; i < sizeSOld; i++) {
             std::vector<DCRTPoly::PolyType> sOldDecomposed = sOld.GetElementAtIndex(i).PowersOfBase(digitSize);
@@ -170,7 +178,7 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
 
                 if (ek == nullptr) {  // single-key HE
                     // Generate a_i vectors
-                    DCRTPoly a(dug, elementParams, Format::EVALUATION);
+                    DCRTPoly a(seed, k + arrWindows[i], elementParams, Format::EVALUATION);
                     av[k + arrWindows[i]] = a;
                 }
                 else {  // threshold HE
@@ -189,7 +197,7 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
 
             if (ek == nullptr) {  // single-key HE
                 // Generate a_i vectors
-                DCRTPoly a(dug, elementParams, Format::EVALUATION);
+                DCRTPoly a(seed, i, elementParams, Format::EVALUATION);
                 av[i] = a;
             }
             else {  // threshold HE
@@ -203,6 +211,8 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
 
     evalKey->SetAVector(std::move(av));
     evalKey->SetBVector(std::move(bv));
+    if (ek == nullptr)
+        evalKey->SetASeed(seed);
     evalKey->SetKeyTag(newKey->GetKeyTag());
 
     return evalKey;
@@ -314,25 +324,10 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchBV::EvalKeySwitchPrecomputeCore(
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchBV::EvalFastKeySwitchCore(
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
-    std::vector<DCRTPoly> bv(evalKey->GetBVector());
-    std::vector<DCRTPoly> av(evalKey->GetAVector());
-
-    auto sizeQ    = bv[0].GetParams()->GetParams().size();
-    auto sizeQl   = paramsQl->GetParams().size();
-    size_t diffQl = sizeQ - sizeQl;
-
-    for (size_t k = 0; k < bv.size(); k++) {
-        av[k].DropLastElements(diffQl);
-        bv[k].DropLastElements(diffQl);
-    }
-
-    DCRTPoly ct1 = (av[0] *= (*digits)[0]);
-    DCRTPoly ct0 = (bv[0] *= (*digits)[0]);
-
-    for (usint i = 1; i < (*digits).size(); ++i) {
-        ct0 += (bv[i] *= (*digits)[i]);
-        ct1 += (av[i] *= (*digits)[i]);
-    }
+    // the keys keep all the towers of Q, of which the inner products read the first ones of Ql
+    const auto lease = evalKey->Lease();
+    DCRTPoly ct0 = DCRTPoly::InnerProduct(*digits, evalKey->GetBVector());
+    DCRTPoly ct1 = DCRTPoly::InnerProduct(*digits, evalKey->GetAVector());
 
     return std::make_shared<std::vector<DCRTPoly>>(std::initializer_list<DCRTPoly>{std::move(ct0), std::move(ct1)});
 }
@@ -89,7 +89,10 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
 
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
-    DugType dug;
+    // the uniform parts are expanded from a seed, which the key serialization writes in their place
+    PRNGSeed seed;
+    for (auto& w : seed)
+        w = PseudoRandomNumberGenerator::GetPRNG()();
 
     size_t numPartQ = cryptoParams->GetNumPartQ();
 
@@ -99,9 +102,10 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
     std::vector<NativeInteger> PModq = cryptoParams->GetPModq();
     size_t numPerPartQ               = cryptoParams->GetNumPerPartQ();
 
+    const auto lease = (ekPrev == nullptr) ? nullptr : ekPrev->Lease();
     for (size_t part = 0; part < numPartQ; ++part) {
-        DCRTPoly a = (ekPrev == nullptr) ? DCRTPoly(dug, paramsQP, Format::EVALUATION) :  // single-key HE
-                                           ekPrev->GetAVector()[part];                                      // threshold HE
+        DCRTPoly a = (ekPrev == nullptr) ? DCRTPoly(seed, part, paramsQP, Format::EVALUATION) :  // single-key HE
+                                           ekPrev->GetAVector()[part];  // threshold HE
         DCRTPoly e(dgg, paramsQP, Format::EVALUATION);
         DCRTPoly b(paramsQP, Format::EVALUATION, true);
 
@@ -130,6 +134,8 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
 
     ek->SetAVector(std::move(av));
     ek->SetBVector(std::move(bv));
+    if (ekPrev == nullptr)
+        ek->SetASeed(seed);
     ek->SetKeyTag(newKey->GetKeyTag());
     return ek;
 }
@@ -331,6 +337,9 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalKeySwitchPrecomputeC
     const DCRTPoly& c, std::shared_ptr<CryptoParametersBase<DCRTPoly>> cryptoParamsBase) const {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cryptoParamsBase);
 
+    // the digits and their temporaries take whole slabs from the per-thread ScratchPool
+    DCRTPoly::StorageScope scratch(LIMB_SLAB);
+
     const std::shared_ptr<ParmType> paramsQl  = c.GetParams();
     const std::shared_ptr<ParmType> paramsP   = cryptoParams->GetParamsP();
     const std::shared_ptr<ParmType> paramsQlP = c.GetExtendedCRTBasis(paramsP);
@@ -418,6 +427,8 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCore(
     const std::shared_ptr<ParmType> paramsQl) const {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
 
+    DCRTPoly::StorageScope scratch(LIMB_SLAB);
+
     std::shared_ptr<std::vector<DCRTPoly>> cTilda = EvalFastKeySwitchCoreExt(digits, evalKey, paramsQl);
 
     PlaintextModulus t = (cryptoParams->GetNoiseScale() == 1) ? 0 : cryptoParams->GetPlaintextModulus();
@@ -441,6 +452,7 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
     const auto cryptoParams         = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
+    const auto lease                = evalKey->Lease();
     const std::vector<DCRTPoly>& bv = evalKey->GetBVector();
     const std::vector<DCRTPoly>& av = evalKey->GetAVector();
 
@@ -451,31 +463,17 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt
     size_t sizeQlP = paramsQlP->GetParams().size();
     size_t sizeQ   = cryptoParams->GetElementParams()->GetParams().size();
 
-    DCRTPoly cTilda0(paramsQlP, Format::EVALUATION, true);
-    DCRTPoly cTilda1(paramsQlP, Format::EVALUATION, true);
-
-    for (uint32_t j = 0; j < digits->size(); j++) {
-        const DCRTPoly& cj = (*digits)[j];
-        const DCRTPoly& bj = bv[j];
-        const DCRTPoly& aj = av[j];
+    DCRTPoly::StorageScope scratch(LIMB_SLAB);
 
-        for (usint i = 0; i < sizeQl; i++) {
-            const auto& cji = cj.GetElementAtIndex(i);
-            const auto& aji = aj.GetElementAtIndex(i);
-            const auto& bji = bj.GetElementAtIndex(i);
+    // the towers of P come after all of Q in the key, but right after Ql in the digits
+    std::vector<uint32_t> keyTowers(sizeQlP);
+    for (usint i = 0; i < sizeQl; i++)
+        keyTowers[i] = i;
+    for (usint i = sizeQl, idx = sizeQ; i < sizeQlP; i++, idx++)
+        keyTowers[i] = idx;
 
-            cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-            cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
-        }
-        for (usint i = sizeQl, idx = sizeQ; i < sizeQlP; i++, idx++) {
-            const auto& cji = cj.GetElementAtIndex(i);
-            const auto& aji = aj.GetElementAtIndex(idx);
-            const auto& bji = bj.GetElementAtIndex(idx);
-
-            cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-            cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
-        }
-    }
+    DCRTPoly cTilda0 = DCRTPoly::InnerProduct(*digits, bv, keyTowers);
+    DCRTPoly cTilda1 = DCRTPoly::InnerProduct(*digits, av, keyTowers);
 
     return std::make_shared<std::vector<DCRTPoly>>(
         std::initializer_list<DCRTPoly>{std::move(cTilda0), std::move(cTilda1)});
@@ -740,8 +740,7 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalAutomorphism(ConstCiphertext<DCRTPoly
 
     usint N = cv[0].GetRingDimension();
 
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, i, &vec);
+    const std::vector<usint>& vec = GetAutoMap(N, i);
 
     auto algo = ciphertext->GetCryptoContext()->GetScheme();
 
@@ -823,8 +822,7 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalFastRotation(ConstCiphertext<DCRTPoly
     }
 
     usint N = cryptoParams->GetElementParams()->GetRingDimension();
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, autoIndex, &vec);
+    const std::vector<usint>& vec = GetAutoMap(N, autoIndex);
 
     (*ba)[0] += cv[0];
 
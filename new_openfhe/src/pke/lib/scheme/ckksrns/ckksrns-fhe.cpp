@@ -49,7 +49,9 @@
 #include "utils/utilities.h"
 #include "scheme/ckksrns/ckksrns-utils.h"
 
+#include <algorithm>
 #include <cmath>
+#include <exception>
 #include <memory>
 #include <vector>
 
@@ -203,12 +205,21 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
             precom->m_U0Pre     = EvalLinearTransformPrecompute(cc, U0, U1, 1, scaleDec, lDec);
         }
     }
+    else if (m_compactDiagonals) {
+        precom->m_U0hatTPreFFTCompact = EvalCoeffsToSlotsDiagonals(cc, ksiPows, rotGroup, false, scaleEnc, lEnc);
+        precom->m_U0PreFFTCompact     = EvalSlotsToCoeffsDiagonals(cc, ksiPows, rotGroup, false, scaleDec, lDec);
+    }
     else {
         precom->m_U0hatTPreFFT = EvalCoeffsToSlotsPrecompute(cc, ksiPows, rotGroup, false, scaleEnc, lEnc);
         precom->m_U0PreFFT     = EvalSlotsToCoeffsPrecompute(cc, ksiPows, rotGroup, false, scaleDec, lDec);
     }
 }
 
+void FHECKKSRNS::EvalBootstrapSetMemoryBudget(uint64_t memoryBudget, bool compactDiagonals) {
+    m_ltMemoryBudget   = memoryBudget;
+    m_compactDiagonals = compactDiagonals;
+}
+
 std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> FHECKKSRNS::EvalBootstrapKeyGen(
     const PrivateKey<DCRTPoly> privateKey, uint32_t slots) {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(privateKey->GetCryptoParameters());
@@ -442,8 +453,9 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         algo->ModReduceInternalInPlace(raised, BASE_NUM_LEVELS_TO_DROP);
 
         // only one linear transform is needed as the other one can be derived
-        auto ctxtEnc = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
-                                         EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
+        auto ctxtEnc = (isLTBootstrap)                          ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
+                       (precom->m_U0hatTPreFFTCompact.empty()) ? EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised) :
+                                                                 EvalCoeffsToSlots(precom->m_U0hatTPreFFTCompact, raised);
 
         auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtEnc->GetKeyTag());
         auto conj       = Conjugate(ctxtEnc, evalKeyMap);
@@ -515,8 +527,9 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         }
 
         // Only one linear transform is needed
-        ctxtDec = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc) :
-                                    EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc);
+        ctxtDec = (isLTBootstrap)                      ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc) :
+                  (precom->m_U0PreFFTCompact.empty()) ? EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc) :
+                                                        EvalSlotsToCoeffs(precom->m_U0PreFFTCompact, ctxtEnc);
     }
     else {
         //------------------------------------------------------------------------------
@@ -542,8 +555,9 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
 
         algo->ModReduceInternalInPlace(raised, BASE_NUM_LEVELS_TO_DROP);
 
-        auto ctxtEnc = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
-                                         EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
+        auto ctxtEnc = (isLTBootstrap)                          ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
+                       (precom->m_U0hatTPreFFTCompact.empty()) ? EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised) :
+                                                                 EvalCoeffsToSlots(precom->m_U0hatTPreFFTCompact, raised);
 
         auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtEnc->GetKeyTag());
         auto conj       = Conjugate(ctxtEnc, evalKeyMap);
@@ -615,8 +629,9 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         }
 
         // linear transform for decoding
-        ctxtDec = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc) :
-                                    EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc);
+        ctxtDec = (isLTBootstrap)                      ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc) :
+                  (precom->m_U0PreFFTCompact.empty()) ? EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc) :
+                                                        EvalSlotsToCoeffs(precom->m_U0PreFFTCompact, ctxtEnc);
 
         cc->EvalAddInPlace(ctxtDec, cc->EvalRotate(ctxtDec, slots));
     }
@@ -643,6 +658,50 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     return ctxtDec;
 }
 
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalBootstrapBatch(const std::vector<Ciphertext<DCRTPoly>>& ciphertexts,
+                                                                 uint32_t numIterations, uint32_t precision) const {
+    size_t n = ciphertexts.size();
+    std::vector<Ciphertext<DCRTPoly>> result(n);
+    // exceptions may not leave the parallel region; the first one is rethrown after it
+    std::vector<std::exception_ptr> errors(n);
+
+#ifdef PARALLEL
+    // one group of threads per ciphertext in flight; the nested parallel loops inside
+    // EvalBootstrap (and the DCRTPoly loops bounded by GetThreadLimit) use the group size.
+    // max-active-levels is process-wide, so it is left as the application set it; without
+    // nested parallelism the groups are single threads, and with fewer ciphertexts than
+    // threads they are bootstrapped one after another with all the threads instead
+    int threads      = omp_get_max_threads();
+    int groups       = std::min<int>(std::max<size_t>(n, 1), threads);
+    int groupThreads = std::max(threads / groups, 1);
+    if (groupThreads > 1 && omp_get_max_active_levels() < omp_get_active_level() + 2) {
+        groups       = 1;
+        groupThreads = threads;
+    }
+
+    #pragma omp parallel for num_threads(groups) schedule(dynamic, 1) if (groups > 1)
+#endif
+    for (size_t i = 0; i < n; i++) {
+#ifdef PARALLEL
+        // nthreads-var belongs to the implicit task, so this does not leak out of the region
+        if (groups > 1)
+            omp_set_num_threads(groupThreads);
+#endif
+        try {
+            result[i] = EvalBootstrap(ciphertexts[i], numIterations, precision);
+        }
+        catch (...) {
+            errors[i] = std::current_exception();
+        }
+    }
+
+    for (const auto& error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+    return result;
+}
+
 //------------------------------------------------------------------------------
 // Find Rotation Indices
 //------------------------------------------------------------------------------
@@ -1086,6 +1145,12 @@ std::vector<ConstPlaintext> FHECKKSRNS::EvalLinearTransformPrecompute(
 }
 
 std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute(
+    const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
+    const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
+    return EncodeDiagonals(cc, EvalCoeffsToSlotsDiagonals(cc, A, rotGroup, flag_i, scale, L));
+}
+
+std::vector<std::vector<CKKSCompactDiagonal>> FHECKKSRNS::EvalCoeffsToSlotsDiagonals(
     const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
     const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
     uint32_t slots = rotGroup.size();
@@ -1120,14 +1185,14 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
     }
 
     // result is the rotated plaintext version of the coefficients
-    std::vector<std::vector<ConstPlaintext>> result(levelBudget);
+    std::vector<std::vector<CKKSCompactDiagonal>> result(levelBudget);
     for (uint32_t i = 0; i < uint32_t(levelBudget); i++) {
         if (flagRem == 1 && i == 0) {
             // remainder corresponds to index 0 in encoding and to last index in decoding
-            result[i] = std::vector<ConstPlaintext>(numRotationsRem);
+            result[i] = std::vector<CKKSCompactDiagonal>(numRotationsRem);
         }
         else {
-            result[i] = std::vector<ConstPlaintext>(numRotations);
+            result[i] = std::vector<CKKSCompactDiagonal>(numRotations);
         }
     }
 
@@ -1201,7 +1266,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
                         auto rotateTemp = Rotate(coeff[s][g * i + j], rot);
 
                         result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s - stop], rotateTemp, 1, level0 - s, rotateTemp.size());
+                            CKKSCompactDiagonal{std::move(rotateTemp), paramsVector[s - stop], level0 - s};
                     }
                 }
             }
@@ -1219,7 +1284,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
 
                         auto rotateTemp = Rotate(coeff[stop][gRem * i + j], rot);
                         result[stop][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[0], rotateTemp, 1, level0, rotateTemp.size());
+                            CKKSCompactDiagonal{std::move(rotateTemp), paramsVector[0], level0};
                     }
                 }
             }
@@ -1255,7 +1320,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
 
                         auto rotateTemp = Rotate(clearTemp, rot);
                         result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s - stop], rotateTemp, 1, level0 - s, rotateTemp.size());
+                            CKKSCompactDiagonal{std::move(rotateTemp), paramsVector[s - stop], level0 - s};
                     }
                 }
             }
@@ -1277,7 +1342,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
 
                         auto rotateTemp = Rotate(clearTemp, rot);
                         result[stop][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[0], rotateTemp, 1, level0, rotateTemp.size());
+                            CKKSCompactDiagonal{std::move(rotateTemp), paramsVector[0], level0};
                     }
                 }
             }
@@ -1287,6 +1352,12 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
 }
 
 std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute(
+    const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
+    const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
+    return EncodeDiagonals(cc, EvalSlotsToCoeffsDiagonals(cc, A, rotGroup, flag_i, scale, L));
+}
+
+std::vector<std::vector<CKKSCompactDiagonal>> FHECKKSRNS::EvalSlotsToCoeffsDiagonals(
     const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
     const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
     uint32_t slots = rotGroup.size();
@@ -1319,14 +1390,14 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
     }
 
     // result is the rotated plaintext version of coeff
-    std::vector<std::vector<ConstPlaintext>> result(levelBudget);
+    std::vector<std::vector<CKKSCompactDiagonal>> result(levelBudget);
     for (uint32_t i = 0; i < uint32_t(levelBudget); i++) {
         if (flagRem == 1 && i == uint32_t(levelBudget - 1)) {
             // remainder corresponds to index 0 in encoding and to last index in decoding
-            result[i] = std::vector<ConstPlaintext>(numRotationsRem);
+            result[i] = std::vector<CKKSCompactDiagonal>(numRotationsRem);
         }
         else {
-            result[i] = std::vector<ConstPlaintext>(numRotations);
+            result[i] = std::vector<CKKSCompactDiagonal>(numRotations);
         }
     }
 
@@ -1393,7 +1464,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
 
                         auto rotateTemp = Rotate(coeff[s][g * i + j], rot);
                         result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                            CKKSCompactDiagonal{std::move(rotateTemp), paramsVector[s], level0 + s};
                     }
                 }
             }
@@ -1412,7 +1483,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
 
                         auto rotateTemp = Rotate(coeff[s][gRem * i + j], rot);
                         result[s][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                            CKKSCompactDiagonal{std::move(rotateTemp), paramsVector[s], level0 + s};
                     }
                 }
             }
@@ -1445,7 +1516,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
 
                         auto rotateTemp = Rotate(clearTemp, rot);
                         result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                            CKKSCompactDiagonal{std::move(rotateTemp), paramsVector[s], level0 + s};
                     }
                 }
             }
@@ -1468,7 +1539,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
 
                         auto rotateTemp = Rotate(clearTemp, rot);
                         result[s][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                            CKKSCompactDiagonal{std::move(rotateTemp), paramsVector[s], level0 + s};
                     }
                 }
             }
@@ -1477,10 +1548,139 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
     return result;
 }
 
+std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EncodeDiagonals(
+    const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::vector<CKKSCompactDiagonal>>& diagonals) const {
+    std::vector<std::vector<ConstPlaintext>> result(diagonals.size());
+    for (size_t s = 0; s < diagonals.size(); s++) {
+        result[s] = std::vector<ConstPlaintext>(diagonals[s].size());
+#pragma omp parallel for
+        for (size_t i = 0; i < diagonals[s].size(); i++) {
+            // entries skipped by the baby-step giant-step layout stay empty
+            if (diagonals[s][i].params != nullptr)
+                result[s][i] = GetDiagonal(cc, diagonals[s][i]);
+        }
+    }
+    return result;
+}
+
 //------------------------------------------------------------------------------
 // EVALUATION: CoeffsToSlots and SlotsToCoeffs
 //------------------------------------------------------------------------------
 
+template <typename Diagonal>
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalBSGSHoisted(ConstCiphertext<DCRTPoly> ct, const std::vector<Diagonal>& A,
+                                                 const std::vector<int32_t>& rotIn,
+                                                 const std::vector<int32_t>& rotOut) const {
+    auto cc    = ct->GetCryptoContext();
+    uint32_t M = cc->GetCyclotomicOrder();
+    uint32_t N = cc->GetRingDimension();
+
+    int32_t g = rotIn.size();
+    int32_t b = rotOut.size();
+
+    // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
+    auto digits = cc->EvalFastRotationPrecompute(ct);
+
+    // number of hoisted rotations and of partial sums alive at once
+    int32_t babyTile  = g;
+    int32_t giantTile = 1;
+    if (m_ltMemoryBudget != 0) {
+        uint64_t polyBytes = (*digits)[0].GetNumOfElements() * uint64_t(N) * sizeof(NativeInteger);
+        uint64_t ctBytes   = 2 * polyBytes;
+        // the digits stay alive for the whole transform (one polynomial over QlP per digit), and
+        // every rotation in flight needs about one more extended ciphertext of temporaries
+        uint64_t fixedBytes = digits->size() * polyBytes + OpenFHEParallelControls.GetThreadLimit(g) * ctBytes;
+        uint64_t available  = (m_ltMemoryBudget > fixedBytes) ? m_ltMemoryBudget - fixedBytes : 0;
+        // the outer sum, one partial sum and one rotation are the least we can work with
+        int64_t width = std::max<int64_t>(available / ctBytes, 3);
+        if (width < g + 2) {
+            if (width >= b + 2) {
+                // keep all partial sums so that every rotation is still computed once
+                giantTile = b;
+                babyTile  = width - b - 1;
+            }
+            else {
+                // the rotations are recomputed for every group of partial sums
+                giantTile = width - 2;
+                babyTile  = 1;
+            }
+        }
+    }
+
+    Ciphertext<DCRTPoly> outer;
+    DCRTPoly first;
+    for (int32_t i0 = 0; i0 < b; i0 += giantTile) {
+        int32_t i1 = std::min(b, i0 + giantTile);
+
+        std::vector<Ciphertext<DCRTPoly>> inner(i1 - i0);
+        for (int32_t j0 = 0; j0 < g; j0 += babyTile) {
+            int32_t j1 = std::min(g, j0 + babyTile);
+
+            // hoisted automorphisms
+            std::vector<Ciphertext<DCRTPoly>> fastRotation(j1 - j0);
+#pragma omp parallel for
+            for (int32_t j = j0; j < j1; j++) {
+                if (rotIn[j] != 0) {
+                    fastRotation[j - j0] = cc->EvalFastRotationExt(ct, rotIn[j], digits, true);
+                }
+                else {
+                    fastRotation[j - j0] = cc->KeySwitchExt(ct, true);
+                }
+            }
+
+#pragma omp parallel for if (i1 - i0 > 1)
+            for (int32_t i = i0; i < i1; i++) {
+                for (int32_t j = j0; j < j1; j++) {
+                    size_t k = g * i + j;
+                    if (k >= A.size())
+                        break;
+                    auto term = EvalMultExt(fastRotation[j - j0], GetDiagonal(*cc, A[k]));
+                    if (inner[i - i0])
+                        EvalAddExtInPlace(inner[i - i0], term);
+                    else
+                        inner[i - i0] = term;
+                }
+            }
+        }
+
+        for (int32_t i = i0; i < i1; i++) {
+            Ciphertext<DCRTPoly>& partial = inner[i - i0];
+            if (i == 0) {
+                first         = cc->KeySwitchDownFirstElement(partial);
+                auto elements = partial->GetElements();
+                elements[0].SetValuesToZero();
+                partial->SetElements(elements);
+                outer = partial;
+            }
+            else {
+                if (rotOut[i] != 0) {
+                    partial = cc->KeySwitchDown(partial);
+                    // Find the automorphism index that corresponds to rotation index index.
+                    usint autoIndex               = FindAutomorphismIndex2nComplex(rotOut[i], M);
+                    const std::vector<usint>& map = GetAutoMap(N, autoIndex);
+                    first += partial->GetElements()[0].AutomorphismTransform(autoIndex, map);
+                    auto innerDigits = cc->EvalFastRotationPrecompute(partial);
+                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(partial, rotOut[i], innerDigits, false));
+                }
+                else {
+                    first += cc->KeySwitchDownFirstElement(partial);
+                    auto elements = partial->GetElements();
+                    elements[0].SetValuesToZero();
+                    partial->SetElements(elements);
+                    EvalAddExtInPlace(outer, partial);
+                }
+            }
+            partial = nullptr;
+        }
+    }
+
+    Ciphertext<DCRTPoly> result     = cc->KeySwitchDown(outer);
+    std::vector<DCRTPoly>& elements = result->GetElements();
+    elements[0] += first;
+
+    return result;
+}
+
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalLinearTransform(const std::vector<ConstPlaintext>& A,
                                                      ConstCiphertext<DCRTPoly> ct) const {
     uint32_t slots = A.size();
@@ -1494,68 +1694,36 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalLinearTransform(const std::vector<ConstPlai
     }
     const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
 
-    auto cc = ct->GetCryptoContext();
     // Computing the baby-step bStep and the giant-step gStep.
     uint32_t bStep = (precom->m_dim1 == 0) ? ceil(sqrt(slots)) : precom->m_dim1;
     uint32_t gStep = ceil(static_cast<double>(slots) / bStep);
 
-    uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
-
-    // computes the NTTs for each CRT limb (for the hoisted automorphisms used
-    // later on)
-    auto digits = cc->EvalFastRotationPrecompute(ct);
-
-    std::vector<Ciphertext<DCRTPoly>> fastRotation(bStep - 1);
-
-    // hoisted automorphisms
-#pragma omp parallel for
-    for (uint32_t j = 1; j < bStep; j++) {
-        fastRotation[j - 1] = cc->EvalFastRotationExt(ct, j, digits, true);
+    std::vector<int32_t> rotIn(bStep);
+    for (uint32_t j = 0; j < bStep; j++) {
+        rotIn[j] = j;
     }
 
-    Ciphertext<DCRTPoly> result;
-    DCRTPoly first;
-
+    std::vector<int32_t> rotOut(gStep);
     for (uint32_t j = 0; j < gStep; j++) {
-        Ciphertext<DCRTPoly> inner = EvalMultExt(cc->KeySwitchExt(ct, true), A[bStep * j]);
-        for (uint32_t i = 1; i < bStep; i++) {
-            if (bStep * j + i < slots) {
-                EvalAddExtInPlace(inner, EvalMultExt(fastRotation[i - 1], A[bStep * j + i]));
-            }
-        }
-
-        if (j == 0) {
-            first         = cc->KeySwitchDownFirstElement(inner);
-            auto elements = inner->GetElements();
-            elements[0].SetValuesToZero();
-            inner->SetElements(elements);
-            result = inner;
-        }
-        else {
-            inner = cc->KeySwitchDown(inner);
-            // Find the automorphism index that corresponds to rotation index index.
-            usint autoIndex = FindAutomorphismIndex2nComplex(bStep * j, M);
-            std::vector<usint> map(N);
-            PrecomputeAutoMap(N, autoIndex, &map);
-            DCRTPoly firstCurrent = inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-            first += firstCurrent;
-
-            auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-            EvalAddExtInPlace(result, cc->EvalFastRotationExt(inner, bStep * j, innerDigits, false));
-        }
+        rotOut[j] = bStep * j;
     }
 
-    result        = cc->KeySwitchDown(result);
-    auto elements = result->GetElements();
-    elements[0] += first;
-    result->SetElements(elements);
-
-    return result;
+    return EvalBSGSHoisted(ct, A, rotIn, rotOut);
 }
 
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector<ConstPlaintext>>& A,
                                                    ConstCiphertext<DCRTPoly> ctxt) const {
+    return EvalCoeffsToSlotsInternal(A, ctxt);
+}
+
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector<CKKSCompactDiagonal>>& A,
+                                                   ConstCiphertext<DCRTPoly> ctxt) const {
+    return EvalCoeffsToSlotsInternal(A, ctxt);
+}
+
+template <typename Diagonal>
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlotsInternal(const std::vector<std::vector<Diagonal>>& A,
+                                                           ConstCiphertext<DCRTPoly> ctxt) const {
     uint32_t slots = ctxt->GetSlots();
 
     auto pair = m_bootPrecomMap.find(slots);
@@ -1569,7 +1737,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
 
     auto cc    = ctxt->GetCryptoContext();
     uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
 
     int32_t levelBudget     = precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
     int32_t layersCollapse  = precom->m_paramsEnc[CKKS_BOOT_PARAMS::LAYERS_COLL];
@@ -1593,21 +1760,19 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
 
     // precompute the inner and outer rotations
     std::vector<std::vector<int32_t>> rot_in(levelBudget);
+    std::vector<std::vector<int32_t>> rot_out(levelBudget);
     for (uint32_t i = 0; i < uint32_t(levelBudget); i++) {
         if (flagRem == 1 && i == 0) {
             // remainder corresponds to index 0 in encoding and to last index in decoding
-            rot_in[i] = std::vector<int32_t>(numRotationsRem + 1);
+            rot_in[i]  = std::vector<int32_t>(gRem);
+            rot_out[i] = std::vector<int32_t>(bRem);
         }
         else {
-            rot_in[i] = std::vector<int32_t>(numRotations + 1);
+            rot_in[i]  = std::vector<int32_t>(g);
+            rot_out[i] = std::vector<int32_t>(b);
         }
     }
 
-    std::vector<std::vector<int32_t>> rot_out(levelBudget);
-    for (uint32_t i = 0; i < uint32_t(levelBudget); i++) {
-        rot_out[i] = std::vector<int32_t>(b + bRem);
-    }
-
     for (int32_t s = levelBudget - 1; s > stop; s--) {
         for (int32_t j = 0; j < g; j++) {
             rot_in[s][j] = ReduceRotation(
@@ -1638,127 +1803,13 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
             algo->ModReduceInternalInPlace(result, BASE_NUM_LEVELS_TO_DROP);
         }
 
-        // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
-        auto digits = cc->EvalFastRotationPrecompute(result);
-
-        std::vector<Ciphertext<DCRTPoly>> fastRotation(g);
-#pragma omp parallel for
-        for (int32_t j = 0; j < g; j++) {
-            if (rot_in[s][j] != 0) {
-                fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[s][j], digits, true);
-            }
-            else {
-                fastRotation[j] = cc->KeySwitchExt(result, true);
-            }
-        }
-
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < b; i++) {
-            // for the first iteration with j=0:
-            int32_t G                  = g * i;
-            Ciphertext<DCRTPoly> inner = EvalMultExt(fastRotation[0], A[s][G]);
-            // continue the loop
-            for (int32_t j = 1; j < g; j++) {
-                if ((G + j) != int32_t(numRotations)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][G + j]));
-                }
-            }
-
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
-                outer = inner;
-            }
-            else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        result = EvalBSGSHoisted(result, A[s], rot_in[s], rot_out[s]);
     }
 
     if (flagRem) {
         algo->ModReduceInternalInPlace(result, BASE_NUM_LEVELS_TO_DROP);
 
-        // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
-        auto digits = cc->EvalFastRotationPrecompute(result);
-        std::vector<Ciphertext<DCRTPoly>> fastRotation(gRem);
-
-#pragma omp parallel for
-        for (int32_t j = 0; j < gRem; j++) {
-            if (rot_in[stop][j] != 0) {
-                fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[stop][j], digits, true);
-            }
-            else {
-                fastRotation[j] = cc->KeySwitchExt(result, true);
-            }
-        }
-
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < bRem; i++) {
-            Ciphertext<DCRTPoly> inner;
-            // for the first iteration with j=0:
-            int32_t GRem = gRem * i;
-            inner        = EvalMultExt(fastRotation[0], A[stop][GRem]);
-            // continue the loop
-            for (int32_t j = 1; j < gRem; j++) {
-                if ((GRem + j) != int32_t(numRotationsRem)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[stop][GRem + j]));
-                }
-            }
-
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
-                outer = inner;
-            }
-            else {
-                if (rot_out[stop][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[stop][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[stop][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        result = EvalBSGSHoisted(result, A[stop], rot_in[stop], rot_out[stop]);
     }
 
     return result;
@@ -1766,6 +1817,17 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
 
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector<ConstPlaintext>>& A,
                                                    ConstCiphertext<DCRTPoly> ctxt) const {
+    return EvalSlotsToCoeffsInternal(A, ctxt);
+}
+
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector<CKKSCompactDiagonal>>& A,
+                                                   ConstCiphertext<DCRTPoly> ctxt) const {
+    return EvalSlotsToCoeffsInternal(A, ctxt);
+}
+
+template <typename Diagonal>
+Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffsInternal(const std::vector<std::vector<Diagonal>>& A,
+                                                           ConstCiphertext<DCRTPoly> ctxt) const {
     uint32_t slots = ctxt->GetSlots();
 
     auto pair = m_bootPrecomMap.find(slots);
@@ -1781,7 +1843,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
     auto cc = ctxt->GetCryptoContext();
 
     uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
 
     int32_t levelBudget     = precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
     int32_t layersCollapse  = precom->m_paramsDec[CKKS_BOOT_PARAMS::LAYERS_COLL];
@@ -1804,21 +1865,19 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
     // precompute the inner and outer rotations
 
     std::vector<std::vector<int32_t>> rot_in(levelBudget);
+    std::vector<std::vector<int32_t>> rot_out(levelBudget);
     for (uint32_t i = 0; i < uint32_t(levelBudget); i++) {
         if (flagRem == 1 && i == uint32_t(levelBudget - 1)) {
             // remainder corresponds to index 0 in encoding and to last index in decoding
-            rot_in[i] = std::vector<int32_t>(numRotationsRem + 1);
+            rot_in[i]  = std::vector<int32_t>(gRem);
+            rot_out[i] = std::vector<int32_t>(bRem);
         }
         else {
-            rot_in[i] = std::vector<int32_t>(numRotations + 1);
+            rot_in[i]  = std::vector<int32_t>(g);
+            rot_out[i] = std::vector<int32_t>(b);
         }
     }
 
-    std::vector<std::vector<int32_t>> rot_out(levelBudget);
-    for (uint32_t i = 0; i < uint32_t(levelBudget); i++) {
-        rot_out[i] = std::vector<int32_t>(b + bRem);
-    }
-
     for (int32_t s = 0; s < levelBudget - flagRem; s++) {
         for (int32_t j = 0; j < g; j++) {
             rot_in[s][j] =
@@ -1850,128 +1909,15 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
         if (s != 0) {
             algo->ModReduceInternalInPlace(result, BASE_NUM_LEVELS_TO_DROP);
         }
-        // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
-        auto digits = cc->EvalFastRotationPrecompute(result);
-
-        std::vector<Ciphertext<DCRTPoly>> fastRotation(g);
-#pragma omp parallel for
-        for (int32_t j = 0; j < g; j++) {
-            if (rot_in[s][j] != 0) {
-                fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[s][j], digits, true);
-            }
-            else {
-                fastRotation[j] = cc->KeySwitchExt(result, true);
-            }
-        }
-
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < b; i++) {
-            Ciphertext<DCRTPoly> inner;
-            // for the first iteration with j=0:
-            int32_t G = g * i;
-            inner     = EvalMultExt(fastRotation[0], A[s][G]);
-            // continue the loop
-            for (int32_t j = 1; j < g; j++) {
-                if ((G + j) != int32_t(numRotations)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][G + j]));
-                }
-            }
-
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
-                outer = inner;
-            }
-            else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
 
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        result = EvalBSGSHoisted(result, A[s], rot_in[s], rot_out[s]);
     }
 
     if (flagRem) {
         algo->ModReduceInternalInPlace(result, BASE_NUM_LEVELS_TO_DROP);
-        // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
-        auto digits = cc->EvalFastRotationPrecompute(result);
-        std::vector<Ciphertext<DCRTPoly>> fastRotation(gRem);
 
         int32_t s = levelBudget - flagRem;
-#pragma omp parallel for
-        for (int32_t j = 0; j < gRem; j++) {
-            if (rot_in[s][j] != 0) {
-                fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[s][j], digits, true);
-            }
-            else {
-                fastRotation[j] = cc->KeySwitchExt(result, true);
-            }
-        }
-
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < bRem; i++) {
-            Ciphertext<DCRTPoly> inner;
-            // for the first iteration with j=0:
-            int32_t GRem = gRem * i;
-            inner        = EvalMultExt(fastRotation[0], A[s][GRem]);
-            // continue the loop
-            for (int32_t j = 1; j < gRem; j++) {
-                if ((GRem + j) != int32_t(numRotationsRem))
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][GRem + j]));
-            }
-
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
-                outer = inner;
-            }
-            else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        result    = EvalBSGSHoisted(result, A[s], rot_in[s], rot_out[s]);
     }
 
     return result;
@@ -2205,6 +2151,8 @@ Plaintext FHECKKSRNS::MakeAuxPlaintext(const CryptoContextImpl<DCRTPoly>& cc, co
 
     p->SetFormat(Format::EVALUATION);
     p->SetScalingFactor(pow(p->GetScalingFactor(), noiseScaleDeg));
+    // the auxiliary plaintexts are the diagonals of the linear transforms, multiplied at every call
+    p->ComputeShoupPrecon();
 
     return p;
 }
@@ -2365,6 +2313,8 @@ Plaintext FHECKKSRNS::MakeAuxPlaintext(const CryptoContextImpl<DCRTPoly>& cc, co
 
     p->SetFormat(Format::EVALUATION);
     p->SetScalingFactor(pow(p->GetScalingFactor(), noiseScaleDeg));
+    // the auxiliary plaintexts are the diagonals of the linear transforms, multiplied at every call
+    p->ComputeShoupPrecon();
 
     return p;
 }
@@ -2374,11 +2324,19 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalMultExt(ConstCiphertext<DCRTPoly> ciphertex
     Ciphertext<DCRTPoly> result = ciphertext->Clone();
     std::vector<DCRTPoly>& cv   = result->GetElements();
 
-    DCRTPoly pt = plaintext->GetElement<DCRTPoly>();
-    pt.SetFormat(Format::EVALUATION);
+    const auto& precon = plaintext->GetShoupPrecon();
+    if (precon && plaintext->GetElement<DCRTPoly>().GetFormat() == Format::EVALUATION) {
+        for (auto& c : cv) {
+            c.TimesShoupEq(plaintext->GetElement<DCRTPoly>(), *precon);
+        }
+    }
+    else {
+        DCRTPoly pt = plaintext->GetElement<DCRTPoly>();
+        pt.SetFormat(Format::EVALUATION);
 
-    for (auto& c : cv) {
-        c *= pt;
+        for (auto& c : cv) {
+            c *= pt;
+        }
     }
     result->SetNoiseScaleDeg(result->GetNoiseScaleDeg() + plaintext->GetNoiseScaleDeg());
     result->SetScalingFactor(result->GetScalingFactor() * plaintext->GetScalingFactor());
@@ -2411,8 +2369,7 @@ EvalKey<DCRTPoly> FHECKKSRNS::ConjugateKeyGen(const PrivateKey<DCRTPoly> private
     PrivateKey<DCRTPoly> privateKeyPermuted = std::make_shared<PrivateKeyImpl<DCRTPoly>>(cc);
 
     usint index = 2 * N - 1;
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, index, &vec);
+    const std::vector<usint>& vec = GetAutoMap(N, index);
 
     DCRTPoly sPermuted = s.AutomorphismTransform(index, vec);
 
@@ -2427,8 +2384,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::Conjugate(ConstCiphertext<DCRTPoly> ciphertext,
     const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
     usint N                         = cv[0].GetRingDimension();
 
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, 2 * N - 1, &vec);
+    const std::vector<usint>& vec = GetAutoMap(N, 2 * N - 1);
 
     auto algo = ciphertext->GetCryptoContext()->GetScheme();
 
@@ -443,8 +443,7 @@ Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalFastRotationExt(ConstCiphertext<DCRT
         (*cTilda)[0] += psiC0;
     }
 
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, autoIndex, &vec);
+    const std::vector<usint>& vec = GetAutoMap(N, autoIndex);
 
     (*cTilda)[0] = (*cTilda)[0].AutomorphismTransform(autoIndex, vec);
     (*cTilda)[1] = (*cTilda)[1].AutomorphismTransform(autoIndex, vec);
@@ -405,8 +405,7 @@ EvalKey<DCRTPoly> SWITCHCKKSRNS::ConjugateKeyGen(const PrivateKey<DCRTPoly> priv
     PrivateKey<DCRTPoly> privateKeyPermuted = std::make_shared<PrivateKeyImpl<DCRTPoly>>(cc);
 
     usint index = 2 * N - 1;
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, index, &vec);
+    const std::vector<usint>& vec = GetAutoMap(N, index);
 
     DCRTPoly sPermuted = s.AutomorphismTransform(index, vec);
 
@@ -421,8 +420,7 @@ Ciphertext<DCRTPoly> SWITCHCKKSRNS::Conjugate(ConstCiphertext<DCRTPoly> cipherte
     const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
     usint N                         = cv[0].GetRingDimension();
 
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, 2 * N - 1, &vec);
+    const std::vector<usint>& vec = GetAutoMap(N, 2 * N - 1);
 
     auto algo = ciphertext->GetCryptoContext()->GetScheme();
 
@@ -905,8 +903,7 @@ Ciphertext<DCRTPoly> SWITCHCKKSRNS::EvalLTWithPrecomputeSwitch(const CryptoConte
             inner = cc.KeySwitchDown(inner);
             // Find the automorphism index that corresponds to the rotation index.
             usint autoIndex = FindAutomorphismIndex2nComplex(bStep * j, M);
-            std::vector<usint> map(N);
-            PrecomputeAutoMap(N, autoIndex, &map);
+            const std::vector<usint>& map = GetAutoMap(N, autoIndex);
             DCRTPoly firstCurrent = inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
             first += firstCurrent;
 
@@ -1012,8 +1009,7 @@ Ciphertext<DCRTPoly> SWITCHCKKSRNS::EvalLTRectWithPrecomputeSwitch(
             inner = cc.KeySwitchDown(inner);
             // Find the automorphism index that corresponds to rotation index index.
             usint autoIndex = FindAutomorphismIndex2nComplex(bStep * j, M);
-            std::vector<usint> map(N);
-            PrecomputeAutoMap(N, autoIndex, &map);
+            const std::vector<usint>& map = GetAutoMap(N, autoIndex);
             DCRTPoly firstCurrent = inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
             first += firstCurrent;
 
@@ -1206,8 +1202,7 @@ std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> SWITCHCKKSRNS::EvalCKKStoFHE
     usint N                                 = s.GetRingDimension();
     PrivateKey<DCRTPoly> privateKeyPermuted = std::make_shared<PrivateKeyImpl<DCRTPoly>>(ccCKKS);
     usint index                             = 2 * N - 1;
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, index, &vec);
+    const std::vector<usint>& vec = GetAutoMap(N, index);
     DCRTPoly sPermuted = s.AutomorphismTransform(index, vec);
     privateKeyPermuted->SetPrivateElement(sPermuted);
     privateKeyPermuted->SetKeyTag(privateKey->GetKeyTag());
@@ -1732,8 +1727,7 @@ std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> SWITCHCKKSRNS::EvalSchemeSwi
     usint N                                 = s.GetRingDimension();
     PrivateKey<DCRTPoly> privateKeyPermuted = std::make_shared<PrivateKeyImpl<DCRTPoly>>(ccCKKS);
     usint index                             = 2 * N - 1;
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, index, &vec);
+    const std::vector<usint>& vec = GetAutoMap(N, index);
     DCRTPoly sPermuted = s.AutomorphismTransform(index, vec);
     privateKeyPermuted->SetPrivateElement(sPermuted);
     privateKeyPermuted->SetKeyTag(privateKey->GetKeyTag());
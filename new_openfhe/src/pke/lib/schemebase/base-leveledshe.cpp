@@ -407,6 +407,9 @@ std::shared_ptr<std::map<usint, EvalKey<Element>>> LeveledSHEBase<Element>::Eval
         Element sPermuted = s.AutomorphismTransform(index, vec);
         privateKeyPermuted->SetPrivateElement(sPermuted);
         (*evalKeys)[indexList[i]] = algo->KeySwitchGen(privateKey, privateKeyPermuted);
+
+        // builds the map the evaluations with this key use
+        GetAutoMap(N, indexList[i]);
     }
 
     return evalKeys;
@@ -442,8 +445,7 @@ Ciphertext<Element> LeveledSHEBase<Element>::EvalAutomorphism(ConstCiphertext<El
     //        not_available_error,
     //        "automorphism indices higher than 2*n are not allowed " + CALLER_INFO);
 
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, i, &vec);
+    const std::vector<usint>& vec = GetAutoMap(N, i);
 
     auto algo = ciphertext->GetCryptoContext()->GetScheme();
 
@@ -497,8 +499,7 @@ Ciphertext<Element> LeveledSHEBase<Element>::EvalFastRotation(
     const auto cryptoParams = ciphertext->GetCryptoParameters();
 
     usint N = cryptoParams->GetElementParams()->GetRingDimension();
-    std::vector<usint> vec(N);
-    PrecomputeAutoMap(N, autoIndex, &vec);
+    const std::vector<usint>& vec = GetAutoMap(N, autoIndex);
 
     (*ba)[0] += cv[0];
 
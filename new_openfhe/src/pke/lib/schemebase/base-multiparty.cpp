@@ -315,6 +315,10 @@ EvalKey<Element> MultipartyBase<Element>::MultiAddEvalKeys(EvalKey<Element> eval
 
     EvalKey<Element> evalKeySum = std::make_shared<EvalKeyRelinImpl<Element>>(cc);
 
+    // keys loaded on demand stay in memory while they are leased
+    const auto lease1 = evalKey1->Lease();
+    const auto lease2 = evalKey2->Lease();
+
     const std::vector<Element>& a = evalKey1->GetAVector();
 
     const std::vector<Element>& b1 = evalKey1->GetBVector();
@@ -339,6 +343,9 @@ EvalKey<Element> MultipartyBase<Element>::MultiAddEvalMultKeys(EvalKey<Element>
 
     EvalKey<Element> evalKeySum = std::make_shared<EvalKeyRelinImpl<Element>>(cc);
 
+    const auto lease1 = evalKey1->Lease();
+    const auto lease2 = evalKey2->Lease();
+
     const std::vector<Element>& a1 = evalKey1->GetAVector();
     const std::vector<Element>& a2 = evalKey2->GetAVector();
 
@@ -371,6 +378,7 @@ EvalKey<Element> MultipartyBase<Element>::MultiMultEvalKey(PrivateKey<Element> p
 
     EvalKey<Element> evalKeyResult = std::make_shared<EvalKeyRelinImpl<Element>>(cc);
 
+    const auto lease               = evalKey->Lease();
     const std::vector<Element>& a0 = evalKey->GetAVector();
     const std::vector<Element>& b0 = evalKey->GetBVector();
 
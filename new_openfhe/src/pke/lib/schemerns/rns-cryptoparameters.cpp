@@ -69,6 +69,10 @@ void CryptoParametersRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Scaling
     // Pre-compute CRT::FFT values for Q
     DiscreteFourierTransform::Initialize(n * 2, n / 2);
     ChineseRemainderTransformFTT<NativeVector>().PreCompute(rootsQ, 2 * n, moduliQ);
+    // the ids of the tables are kept by the element parameters, so the transforms of the application threads
+    // sharing this context only read them
+    for (const auto& p : GetElementParams()->GetParams())
+        p->GetNTTTablesId();
     if (m_ksTechnique == HYBRID) {
         // Compute ceil(sizeQ/m_numPartQ), the # of towers per digit
         uint32_t a = ceil(static_cast<double>(sizeQ) / numPartQ);
@@ -179,6 +183,10 @@ void CryptoParametersRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Scaling
 
         // Pre-compute CRT::FFT values for P
         ChineseRemainderTransformFTT<NativeVector>().PreCompute(rootsP, 2 * n, moduliP);
+        for (const auto& p : m_paramsP->GetParams())
+            p->GetNTTTablesId();
+        for (const auto& p : m_paramsQP->GetParams())
+            p->GetNTTTablesId();
 
         // Pre-compute values [P]_{q_i}
         m_PModq.resize(sizeQ);
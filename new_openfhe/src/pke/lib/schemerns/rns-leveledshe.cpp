@@ -223,7 +223,18 @@ Ciphertext<DCRTPoly> LeveledSHERNS::EvalMult(ConstCiphertext<DCRTPoly> ciphertex
 void LeveledSHERNS::EvalMultInPlace(Ciphertext<DCRTPoly>& ciphertext, ConstPlaintext plaintext) const {
     auto ctmorphed = MorphPlaintext(plaintext, ciphertext);
     AdjustForMultInPlace(ciphertext, ctmorphed);
-    EvalMultCoreInPlace(ciphertext, ctmorphed->GetElements()[0]);
+    // the adjustment only changes the values of the plaintext along with its level or depth, and a level
+    // reduction keeps the leading towers the precomputations start with
+    const auto& precon = plaintext->GetShoupPrecon();
+    if (precon && ctmorphed->GetLevel() == plaintext->GetLevel() &&
+        ctmorphed->GetNoiseScaleDeg() == plaintext->GetNoiseScaleDeg()) {
+        for (auto& c : ciphertext->GetElements()) {
+            c.TimesShoupEq(ctmorphed->GetElements()[0], *precon);
+        }
+    }
+    else {
+        EvalMultCoreInPlace(ciphertext, ctmorphed->GetElements()[0]);
+    }
 
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(ciphertext->GetCryptoParameters());
     ciphertext->SetNoiseScaleDeg(ciphertext->GetNoiseScaleDeg() + ctmorphed->GetNoiseScaleDeg());
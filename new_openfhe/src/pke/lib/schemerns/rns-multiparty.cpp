@@ -189,6 +189,7 @@ EvalKey<DCRTPoly> MultipartyRNS::MultiMultEvalKey(PrivateKey<DCRTPoly> privateKe
 
     EvalKey<DCRTPoly> evalKeyResult = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(evalKey->GetCryptoContext());
 
+    const auto lease                = evalKey->Lease();
     const std::vector<DCRTPoly>& a0 = evalKey->GetAVector();
     const std::vector<DCRTPoly>& b0 = evalKey->GetBVector();
 
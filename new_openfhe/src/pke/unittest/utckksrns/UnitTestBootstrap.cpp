@@ -55,6 +55,8 @@ enum TEST_CASE_TYPE {
     BOOTSTRAP_KEY_SWITCH,
     BOOTSTRAP_ITERATIVE,
     BOOTSTRAP_NUM_TOWERS,
+    BOOTSTRAP_MEMORY_BUDGET,
+    BOOTSTRAP_BATCH,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -78,6 +80,12 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case BOOTSTRAP_NUM_TOWERS:
             typeName = "BOOTSTRAP_NUM_TOWERS";
             break;
+        case BOOTSTRAP_MEMORY_BUDGET:
+            typeName = "BOOTSTRAP_MEMORY_BUDGET";
+            break;
+        case BOOTSTRAP_BATCH:
+            typeName = "BOOTSTRAP_BATCH";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -286,6 +294,23 @@ static std::vector<TEST_CASE_UTCKKSRNS_BOOT> testCases = {
     { BOOTSTRAP_NUM_TOWERS, "14", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/2},
     { BOOTSTRAP_NUM_TOWERS, "15", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/2},
     { BOOTSTRAP_NUM_TOWERS, "16", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/2},
+#endif
+    // ==========================================
+    // TestType,               Descr, Scheme,          RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
+    { BOOTSTRAP_MEMORY_BUDGET, "01", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/2},
+    { BOOTSTRAP_MEMORY_BUDGET, "02", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, 8},
+    { BOOTSTRAP_MEMORY_BUDGET, "03", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 }, RDIM/2},
+    { BOOTSTRAP_MEMORY_BUDGET, "04", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 0, 0 }, RDIM/4},
+#if NATIVEINT != 128
+    { BOOTSTRAP_MEMORY_BUDGET, "05", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/2},
+#endif
+    // ==========================================
+    // TestType,       Descr, Scheme,          RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
+    { BOOTSTRAP_BATCH, "01", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/2},
+    { BOOTSTRAP_BATCH, "02", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, 8},
+    { BOOTSTRAP_BATCH, "03", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 0, 0 }, RDIM/4},
+#if NATIVEINT != 128
+    { BOOTSTRAP_BATCH, "04", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTO,    NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/2},
 #endif
     // ==========================================
 };
@@ -598,6 +623,127 @@ protected:
             std::string name("EMSCRIPTEN_UNKNOWN");
 #else
             std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_Bootstrap_MemoryBudget(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                         const std::string& failmsg = std::string()) {
+        // Tiling the linear transforms and encoding the diagonals on the fly must not change the result.
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+
+            auto keyPair = cc->KeyGen();
+            cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots);
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            std::vector<std::complex<double>> input(
+                Fill({0.111111, 0.222222, 0.333333, 0.444444, 0.555555, 0.666666, 0.777777, 0.888888}, testData.slots));
+            size_t encodedLength = input.size();
+
+            Plaintext plaintext = cc->MakeCKKSPackedPlaintext(input, 1, MULT_DEPTH - 1, nullptr, testData.slots);
+            auto ciphertext     = cc->Encrypt(keyPair.publicKey, plaintext);
+            auto expected       = cc->EvalBootstrap(ciphertext);
+
+            // size of a fresh ciphertext in the extended basis; the budgets below allow
+            // between the minimal working set and a few rotations
+            const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cc->GetCryptoParameters());
+            uint64_t ctBytes        = 2 * cc->GetRingDimension() * sizeof(NativeInteger) *
+                               (cryptoParams->GetElementParams()->GetParams().size() +
+                                cryptoParams->GetParamsP()->GetParams().size());
+
+            for (uint64_t budget : {uint64_t(1), 4 * ctBytes, 8 * ctBytes}) {
+                for (bool compact : {false, true}) {
+                    cc->EvalBootstrapSetMemoryBudget(budget, compact);
+                    cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+
+                    auto ciphertextAfter = cc->EvalBootstrap(ciphertext);
+                    std::string msg      = failmsg + " budget " + std::to_string(budget) + " compact " +
+                                      std::to_string(compact);
+                    EXPECT_TRUE(ciphertextAfter->GetElements() == expected->GetElements()) << msg;
+
+                    Plaintext result;
+                    cc->Decrypt(keyPair.secretKey, ciphertextAfter, &result);
+                    result->SetLength(encodedLength);
+                    plaintext->SetLength(encodedLength);
+                    checkEquality(result->GetCKKSPackedValue(), plaintext->GetCKKSPackedValue(), eps,
+                                  msg + " Bootstrapping with a memory budget fails");
+                }
+            }
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_Bootstrap_Batch(const TEST_CASE_UTCKKSRNS_BOOT& testData, const std::string& failmsg = std::string()) {
+        // Bootstrapping a batch concurrently must give the same ciphertexts as one at a time.
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+
+            auto keyPair = cc->KeyGen();
+            cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots);
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            const size_t batchSize = 5;
+            std::vector<Plaintext> plaintexts(batchSize);
+            std::vector<Ciphertext<Element>> ciphertexts(batchSize);
+            for (size_t i = 0; i < batchSize; i++) {
+                std::vector<std::complex<double>> input(
+                    Fill({0.111111, 0.222222, 0.333333, 0.444444, 0.555555, 0.666666, 0.777777, 0.888888}, testData.slots));
+                std::rotate(input.begin(), input.begin() + i, input.end());
+                plaintexts[i]  = cc->MakeCKKSPackedPlaintext(input, 1, MULT_DEPTH - 1, nullptr, testData.slots);
+                ciphertexts[i] = cc->Encrypt(keyPair.publicKey, plaintexts[i]);
+            }
+
+            auto results = cc->EvalBootstrapBatch(ciphertexts);
+            ASSERT_EQ(results.size(), batchSize) << failmsg;
+
+            for (size_t i = 0; i < batchSize; i++) {
+                std::string msg = failmsg + " ciphertext " + std::to_string(i);
+
+                auto expected = cc->EvalBootstrap(ciphertexts[i]);
+                EXPECT_TRUE(results[i]->GetElements() == expected->GetElements()) << msg;
+
+                Plaintext result;
+                cc->Decrypt(keyPair.secretKey, results[i], &result);
+                result->SetLength(testData.slots);
+                plaintexts[i]->SetLength(testData.slots);
+                checkEquality(result->GetCKKSPackedValue(), plaintexts[i]->GetCKKSPackedValue(), eps,
+                              msg + " Batched bootstrapping fails");
+            }
+
+            EXPECT_TRUE(cc->EvalBootstrapBatch({}).empty()) << failmsg;
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
 #endif
             std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
             // make it fail
@@ -626,6 +772,12 @@ TEST_P(UTCKKSRNS_BOOT, CKKSRNS) {
         case BOOTSTRAP_NUM_TOWERS:
             UnitTest_Bootstrap_NumTowers(test, test.buildTestName());
             break;
+        case BOOTSTRAP_MEMORY_BUDGET:
+            UnitTest_Bootstrap_MemoryBudget(test, test.buildTestName());
+            break;
+        case BOOTSTRAP_BATCH:
+            UnitTest_Bootstrap_Batch(test, test.buildTestName());
+            break;
         default:
             break;
     }
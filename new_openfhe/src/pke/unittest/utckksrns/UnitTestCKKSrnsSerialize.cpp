@@ -34,6 +34,8 @@
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include <vector>
 #include "gtest/gtest.h"
@@ -41,6 +43,8 @@
 
 #include "ciphertext-ser.h"
 #include "cryptocontext-ser.h"
+#include "key/key-ser.h"
+#include "key/evalkeystore.h"
 #include "scheme/ckksrns/ckksrns-ser.h"
 #include "globals.h"  // for SERIALIZE_PRECOMPUTE
 #include "utils/demangle.h"
@@ -52,6 +56,7 @@ enum TEST_CASE_TYPE {
     CONTEXT_WITH_SERTYPE = 0,
     KEYS_AND_CIPHERTEXTS,
     NO_CRT_TABLES,
+    EVAL_KEY_STORE,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -66,6 +71,9 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case NO_CRT_TABLES:
             typeName = "NO_CRT_TABLES";
             break;
+        case EVAL_KEY_STORE:
+            typeName = "EVAL_KEY_STORE";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -170,6 +178,10 @@ static std::vector<TEST_CASE_UTCKKSRNS_SER> testCases = {
     { NO_CRT_TABLES, "08", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, 0,     BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
 #endif
     // ==========================================
+    // TestType,     Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize, BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,       KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech,  EncTech, PREMode
+    { EVAL_KEY_STORE, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, BV,     FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    { EVAL_KEY_STORE, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DSIZE, BATCH,   DFLT,       DFLT,          DFLT,     HEStd_NotSet, HYBRID, FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,      DFLT,    DFLT}, },
+    // ==========================================
 };
 // clang-format on
 //===========================================================================================================
@@ -275,6 +287,17 @@ protected:
             cc->EvalSumKeyGen(kp.secretKey);
             cc->EvalSumKeyGen(kp2.secretKey);
 
+            // the A vector of a generated key is written as its seed and regenerated on load
+            const auto& evalMultKey = CryptoContextImpl<DCRTPoly>::GetEvalMultKeyVector(kp.secretKey->GetKeyTag())[0];
+            EXPECT_FALSE(std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(evalMultKey)->GetASeed().empty())
+                << "eval mult key not seeded";
+            std::stringstream sk;
+            Serial::Serialize(evalMultKey, sk, sertype);
+            EvalKey<DCRTPoly> newEvalMultKey;
+            Serial::Deserialize(newEvalMultKey, sk, sertype);
+            ASSERT_TRUE(newEvalMultKey) << "eval mult key deserialize failed";
+            EXPECT_EQ(*evalMultKey, *newEvalMultKey) << "eval mult key mismatch";
+
             OPENFHE_DEBUG("step 7");
             // serialize a bunch of mult keys
             std::stringstream ser0;
@@ -471,6 +494,97 @@ protected:
         TestDecryptionSerNoCRTTables(testData, SerType::JSON, "json");
         TestDecryptionSerNoCRTTables(testData, SerType::BINARY, "binary");
     }
+
+    void UnitTestEvalKeyStore(const TEST_CASE_UTCKKSRNS_SER& testData, const std::string& failmsg = std::string()) {
+        const std::string filename = ::testing::TempDir() + "evalkeystore-" + testData.description + ".bin";
+        try {
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+            cc->EvalMultKeyGen(kp.secretKey);
+            const std::vector<int32_t> indices = {1, 2, 3, -1};
+            cc->EvalRotateKeyGen(kp.secretKey, indices);
+
+            std::vector<std::complex<double>> vals(BATCH);
+            for (size_t i = 0; i < vals.size(); ++i)
+                vals[i] = 0.5 * static_cast<double>(i) - 3.0;
+            Plaintext plaintext             = cc->MakeCKKSPackedPlaintext(vals);
+            Ciphertext<DCRTPoly> ciphertext = cc->Encrypt(kp.publicKey, plaintext);
+
+            EvalKeyStore::Write(filename, cc);
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+
+            // every key is loaded on first use, with at most two keys deserialized at a time
+            auto store = EvalKeyStore::Open(filename, cc, 2);
+            EXPECT_EQ(store->GetKeyCount(), 1 + indices.size()) << failmsg << " wrong number of stored keys";
+            EXPECT_EQ(store->GetResidentCount(), 0U) << failmsg << " keys loaded before use";
+
+            for (int32_t index : indices) {
+                auto rotated = cc->EvalRotate(ciphertext, index);
+                Plaintext result;
+                cc->Decrypt(kp.secretKey, rotated, &result);
+                result->SetLength(vals.size());
+                std::vector<std::complex<double>> expected(vals);
+                std::rotate(expected.begin(), expected.begin() + ((index + BATCH) % BATCH), expected.end());
+                checkEquality(expected, result->GetCKKSPackedValue(), EPSILON_HIGH,
+                              failmsg + " rotation by " + std::to_string(index) + " failed");
+                EXPECT_LE(store->GetResidentCount(), 2U) << failmsg << " resident bound exceeded";
+            }
+
+            auto product = cc->EvalMult(ciphertext, ciphertext);
+            Plaintext result;
+            cc->Decrypt(kp.secretKey, product, &result);
+            result->SetLength(vals.size());
+            std::vector<std::complex<double>> expected(vals.size());
+            for (size_t i = 0; i < vals.size(); ++i)
+                expected[i] = vals[i] * vals[i];
+            checkEquality(expected, result->GetCKKSPackedValue(), EPSILON_HIGH,
+                          failmsg + " multiplication failed");
+
+            // a leased key stays resident and counts towards the bound
+            store->SetMaxResident(1);
+            const auto& rotKeys = cc->GetEvalAutomorphismKeyMap(kp.secretKey->GetKeyTag());
+            const auto& rotKey  = rotKeys.at(cc->FindAutomorphismIndex(1));
+            EXPECT_THROW(rotKey->GetAVector(), config_error) << failmsg << " vectors read without a lease";
+            auto lease = rotKey->Lease();
+            EXPECT_NE(lease, nullptr) << failmsg << " no lease on a stored key";
+            EXPECT_EQ(rotKey->GetAVector().size(), rotKey->GetBVector().size()) << failmsg << " leased key";
+            cc->EvalRotate(ciphertext, 2);
+            EXPECT_EQ(store->GetResidentCount(), 2U) << failmsg << " leased key released";
+            lease.reset();
+            cc->EvalRotate(ciphertext, 3);
+            EXPECT_EQ(store->GetResidentCount(), 1U) << failmsg << " key not released after its lease";
+
+            store->SetMaxResident(0);
+            store->Preload(cc->FindAutomorphismIndices({1, 2, 3}), kp.secretKey->GetKeyTag());
+            EXPECT_GE(store->GetResidentCount(), 3U) << failmsg << " preload failed";
+
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            std::remove(filename.c_str());
+        }
+        catch (std::exception& e) {
+            std::remove(filename.c_str());
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+            std::remove(filename.c_str());
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
 };
 //===========================================================================================================
 TEST_P(UTCKKSRNS_SER, CKKSSer) {
@@ -483,6 +597,8 @@ TEST_P(UTCKKSRNS_SER, CKKSSer) {
         UnitTestKeysAndCiphertexts(test, test.buildTestName());
     else if (test.testCaseType == NO_CRT_TABLES)
         UnitTestDecryptionSerNoCRTTables(test, test.buildTestName());
+    else if (test.testCaseType == EVAL_KEY_STORE)
+        UnitTestEvalKeyStore(test, test.buildTestName());
 }
 
 INSTANTIATE_TEST_SUITE_P(UnitTests, UTCKKSRNS_SER, ::testing::ValuesIn(testCases), testName);